@@ -0,0 +1,230 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "lexer.h"
+#include "simd_scan.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//Default corpus sizes in MB, used when no --size is given
+static const size_t defaultSizes[] = { 1, 16 };
+//Largest corpus accepted, in MB
+#define MAX_CORPUS_MB 1024
+//Each measurement is repeated until it has run this long, the best run is reported
+#define MIN_BENCH_SECONDS 0.5
+
+//Struct to hold a growing corpus buffer
+typedef struct
+{
+    char* data;
+    size_t length;
+    size_t capacity;
+} Corpus;
+
+//Function that generates one line of a corpus
+typedef void (*LineGenerator)(Corpus* corpus, uint32_t* seed);
+
+//Helper for a small deterministic random number generator, so every run lexes the same input
+static uint32_t nextRandom(uint32_t* seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+//Helper to append formatted text to a corpus
+static void append(Corpus* corpus, const char* format, ...)
+{
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    const int written = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (written < 0) return;
+    const size_t length = (size_t)written < sizeof(line) ? (size_t)written : sizeof(line) - 1;
+    if (corpus->length + length + 1 > corpus->capacity)
+    {
+        fprintf(stderr, "Corpus buffer overflow\n");
+        exit(70);
+    }
+    memcpy(corpus->data + corpus->length, line, length);
+    corpus->length += length;
+}
+
+//Identifier-heavy lines - declarations and arithmetic like examples/mutability.lk
+static void identifierLine(Corpus* corpus, uint32_t* seed)
+{
+    static const char* types[] = { "i8", "i16", "i32", "i64", "u8", "u16", "u32", "u64", "f32", "f64", "bool", "char" };
+    static const char* names[] = { "counter", "alpha", "beta", "index", "total", "bound", "value", "result" };
+    append(corpus, "%s%s %s_%u = %s_%u + %s_%u * %s_%u;\n",
+           nextRandom(seed) % 2 ? "mut " : "",
+           types[nextRandom(seed) % 12],
+           names[nextRandom(seed) % 8], nextRandom(seed) % 100,
+           names[nextRandom(seed) % 8], nextRandom(seed) % 100,
+           names[nextRandom(seed) % 8], nextRandom(seed) % 100,
+           names[nextRandom(seed) % 8], nextRandom(seed) % 100);
+}
+
+//String and escape heavy lines - print calls like examples/print.lk
+static void stringLine(Corpus* corpus, uint32_t* seed)
+{
+    static const char* formats[] = {
+        "print(\"{i32}\\n\", i);\n",
+        "print(\"{f32:.2}\\t\\\"quoted\\\" value\\n\", x);\n",
+        "print(\"This prints literal braces: \\{ and \\}\\n\");\n",
+        "string text = \"a fairly long string literal without any escapes in it\";\n",
+        "print(\"\\r\\n\\t\\\\ \\' \\0 mixed escapes\");\n",
+    };
+    append(corpus, "%s", formats[nextRandom(seed) % 5]);
+}
+
+//Numeric heavy lines - integer and float literals like examples/integer.lk and float.lk
+static void numericLine(Corpus* corpus, uint32_t* seed)
+{
+    append(corpus, "f64 v = %u.%u + %u * %u - %u.%u / %u;\n",
+           nextRandom(seed) % 100000, nextRandom(seed) % 1000,
+           nextRandom(seed), nextRandom(seed) % 1000,
+           nextRandom(seed) % 10000, nextRandom(seed) % 100,
+           nextRandom(seed) % 10 + 1);
+}
+
+//Comment heavy lines - mostly '//' comments and indentation with the odd statement
+static void commentLine(Corpus* corpus, uint32_t* seed)
+{
+    switch (nextRandom(seed) % 4)
+    {
+    case 0: append(corpus, "    i = i + 1;\n"); break;
+    case 1: append(corpus, "\n\n        \t\n"); break;
+    default:
+        append(corpus, "        // `loop` is infinite by default and can be exit only using a `break` %u\n", nextRandom(seed));
+        break;
+    }
+}
+
+//Helper to build a '\0' terminated corpus of about 'size' bytes from one line generator
+static Corpus generateCorpus(const LineGenerator generator, const size_t size)
+{
+    Corpus corpus;
+    corpus.capacity = size + 512;
+    corpus.length = 0;
+    corpus.data = malloc(corpus.capacity);
+    if (corpus.data == NULL)
+    {
+        fprintf(stderr, "Not enough memory for a %zu byte corpus\n", size);
+        exit(74);
+    }
+    uint32_t seed = 42;
+    while (corpus.length < size)
+    {
+        generator(&corpus, &seed);
+    }
+    corpus.data[corpus.length] = '\0';
+    return corpus;
+}
+
+//Helper to read a monotonic-enough wall clock in seconds
+static double now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+//Function that lexes the corpus once through scanToken() and returns the token count
+static size_t runScanToken(const Corpus* corpus)
+{
+    size_t count = 0;
+    initScanner(corpus->data);
+    while (scanToken().token != TOKEN_EOF)
+    {
+        count++;
+    }
+    return count + 1;
+}
+
+//Function that lexes the corpus once through tokenizeAll() and returns the token count
+static size_t runTokenizeAll(const Corpus* corpus)
+{
+    static TokenBuffer buffer;
+    return (size_t)tokenizeAll(&buffer, corpus->data, corpus->length);
+}
+
+//Helper to time one lexing entry point on a corpus and print a result row
+static void measure(const char* corpusName, const char* entryName, size_t (*run)(const Corpus*),
+                    const Corpus* corpus)
+{
+    double best = 0.0;
+    double spent = 0.0;
+    size_t tokens = 0;
+    int runs = 0;
+    //Repeat until enough time has passed, but always at least three times
+    while (runs < 3 || spent < MIN_BENCH_SECONDS)
+    {
+        const double start = now();
+        tokens = run(corpus);
+        const double elapsed = now() - start;
+        if (runs == 0 || elapsed < best) best = elapsed;
+        spent += elapsed;
+        runs++;
+    }
+    if (best <= 0.0) best = 1e-9;
+    const double megabytes = (double)corpus->length / (1024.0 * 1024.0);
+    printf("%-12s %-12s %8.1f MB %10zu tok %10.1f MB/s %12.0f tok/s\n",
+           corpusName, entryName, megabytes, tokens, megabytes / best, (double)tokens / best);
+}
+
+int main(const int argc, char* argv[])
+{
+    size_t sizes[16];
+    size_t sizeCount = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc && sizeCount < 16)
+        {
+            const long megabytes = strtol(argv[++i], NULL, 10);
+            if (megabytes < 1 || megabytes > MAX_CORPUS_MB)
+            {
+                fprintf(stderr, "Corpus size must be between 1 and %d MB\n", MAX_CORPUS_MB);
+                return 64;
+            }
+            sizes[sizeCount++] = (size_t)megabytes;
+        }
+        else
+        {
+            printf("Usage: %s [--size <MB>]...\n", argv[0]);
+            return 64;
+        }
+    }
+    if (sizeCount == 0)
+    {
+        sizeCount = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+        memcpy(sizes, defaultSizes, sizeof(defaultSizes));
+    }
+
+    static const struct
+    {
+        const char* name;
+        LineGenerator generator;
+    } corpora[] = {
+        { "identifier", identifierLine },
+        { "string", stringLine },
+        { "numeric", numericLine },
+        { "comment", commentLine },
+    };
+
+    printf("lexer benchmark (block scanner: %s)\n", simdScanMode());
+    for (size_t s = 0; s < sizeCount; s++)
+    {
+        for (size_t c = 0; c < sizeof(corpora) / sizeof(corpora[0]); c++)
+        {
+            Corpus corpus = generateCorpus(corpora[c].generator, sizes[s] * 1024 * 1024);
+            measure(corpora[c].name, "scanToken", runScanToken, &corpus);
+            measure(corpora[c].name, "tokenizeAll", runTokenizeAll, &corpus);
+            free(corpus.data);
+        }
+    }
+    return 0;
+}
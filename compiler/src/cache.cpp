@@ -0,0 +1,89 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "cache.hpp"
+#include <llvm/Support/xxhash.h>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+//Function to spell a key as the file name of its artifacts. The source length is part of the
+//name, so two sources of different sizes never share an entry even if their hashes collide
+std::string CacheKey::hex() const
+{
+    char name[34];
+    snprintf(name, sizeof(name), "%016llx-%llx", (unsigned long long)hash, (unsigned long long)sourceLength);
+    return name;
+}
+
+BuildCache::BuildCache(std::string directory) : directory(std::move(directory)) {}
+
+//Function to get $LYKA_CACHE_DIR, else $XDG_CACHE_HOME/lyka, else ~/.cache/lyka
+std::string BuildCache::defaultDirectory()
+{
+    if (const char* dir = getenv("LYKA_CACHE_DIR"); dir != nullptr && dir[0] != '\0') return dir;
+    if (const char* xdg = getenv("XDG_CACHE_HOME"); xdg != nullptr && xdg[0] != '\0') return std::string(xdg) + "/lyka";
+    if (const char* home = getenv("HOME"); home != nullptr && home[0] != '\0') return std::string(home) + "/.cache/lyka";
+    return "";
+}
+
+//Function to make the key of a module from its source and the flags that affect its artifacts
+CacheKey BuildCache::key(const char* source, const size_t length, const std::string& flags) const
+{
+    const uint64_t sourceHash = llvm::xxHash64(llvm::StringRef(source, length));
+    //Fold the flags and the cache version in, so a different build never reads these entries
+    std::string salt = flags;
+    salt += '\0';
+    salt += std::to_string(LYKA_CACHE_VERSION);
+    salt += '\0';
+    salt.append(reinterpret_cast<const char*>(&sourceHash), sizeof(sourceHash));
+    return CacheKey{llvm::xxHash64(salt), (uint64_t)length};
+}
+
+//Function to get the file of an artifact
+std::string BuildCache::path(const CacheKey& key, const char* kind) const
+{
+    return directory + "/" + key.hex() + "." + kind;
+}
+
+//Function to read a raw artifact, false on a miss
+bool BuildCache::load(const CacheKey& key, const char* kind, std::string& bytes) const
+{
+    if (!enabled()) return false;
+    std::ifstream file(path(key, kind), std::ios::binary);
+    if (!file) return false;
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+//Function to write a raw artifact, a cache that cannot be written is skipped silently
+void BuildCache::store(const CacheKey& key, const char* kind, const std::string& bytes) const
+{
+    if (!enabled()) return;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return;
+
+    //Unique temporary name per writer, then an atomic rename over the final name
+    static std::atomic<unsigned> sequence{0};
+    std::ostringstream temporary;
+    temporary << path(key, kind) << ".tmp." << getpid() << "." << std::this_thread::get_id() << "." << sequence++;
+    {
+        std::ofstream file(temporary.str(), std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write(bytes.data(), (std::streamsize)bytes.size());
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(temporary.str(), error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary.str(), path(key, kind), error);
+    if (error) std::filesystem::remove(temporary.str(), error);
+}
@@ -0,0 +1,51 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//On-disk build cache of lykac. Every artifact of a module (its lex summary
+//today, IR bitcode and object code once code generation lands) is stored
+//under a key made from the module's source bytes and the compiler flags, so
+//an unchanged module is never lexed, parsed or compiled twice. Files are
+//written to a temporary name and renamed, so parallel builds sharing a cache
+//never see half-written entries. A corrupt or stale entry is treated as a miss.
+
+//Bump whenever the layout of an artifact or the meaning of its input changes
+#define LYKA_CACHE_VERSION 1
+
+//Struct to hold the key of one module
+struct CacheKey
+{
+    uint64_t hash;
+    uint64_t sourceLength;
+    std::string hex() const;
+};
+
+//Class to hold a cache directory, an empty directory disables the cache
+class BuildCache
+{
+public:
+    explicit BuildCache(std::string directory);
+
+    //Function to get $LYKA_CACHE_DIR, else $XDG_CACHE_HOME/lyka, else ~/.cache/lyka
+    static std::string defaultDirectory();
+
+    bool enabled() const { return !directory.empty(); }
+    //Function to make the key of a module from its source and the flags that affect its artifacts
+    CacheKey key(const char* source, size_t length, const std::string& flags) const;
+
+    //Functions to read and write a raw artifact ('kind' is its file extension)
+    bool load(const CacheKey& key, const char* kind, std::string& bytes) const;
+    void store(const CacheKey& key, const char* kind, const std::string& bytes) const;
+
+private:
+    std::string directory;
+    std::string path(const CacheKey& key, const char* kind) const;
+};
+
+#endif //CACHE_HPP
@@ -0,0 +1,239 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "codegen.hpp"
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+//Function to lower the dispatch of a 'match' to a single LLVM 'switch'
+llvm::SwitchInst* emitMatchSwitch(llvm::IRBuilder<>& builder, llvm::Value* scrutinee,
+                                  const std::vector<MatchCase>& cases, llvm::BasicBlock* defaultBlock)
+{
+    auto* type = llvm::cast<llvm::IntegerType>(scrutinee->getType());
+    llvm::SwitchInst* dispatch = builder.CreateSwitch(scrutinee, defaultBlock, (unsigned)cases.size());
+    //The verifier rejects a switch with two equal case values
+    std::unordered_set<uint64_t> seen;
+    for (const MatchCase& matchCase : cases)
+    {
+        llvm::ConstantInt* value = llvm::ConstantInt::get(type, (uint64_t)matchCase.value, true);
+        if (!seen.insert(value->getZExtValue()).second) continue;
+        dispatch->addCase(value, matchCase.body);
+    }
+    return dispatch;
+}
+
+//Helper to compare a counter with the limit of a counted loop
+static llvm::Value* belowLimit(llvm::IRBuilder<>& builder, llvm::Value* counter, const CountedLoopBlocks& loop)
+{
+    if (loop.inclusive)
+    {
+        return loop.isSigned ? builder.CreateICmpSLE(counter, loop.limit) : builder.CreateICmpULE(counter, loop.limit);
+    }
+    return loop.isSigned ? builder.CreateICmpSLT(counter, loop.limit) : builder.CreateICmpULT(counter, loop.limit);
+}
+
+//Function to open a counted loop at the builder, which is left at the start of the body
+CountedLoopBlocks openCountedLoop(llvm::IRBuilder<>& builder, llvm::Value* start, llvm::Value* limit,
+                                  const int64_t step, const bool inclusive, const bool isSigned)
+{
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::LLVMContext& context = builder.getContext();
+    CountedLoopBlocks loop;
+    loop.body = llvm::BasicBlock::Create(context, "for.body", function);
+    loop.latch = llvm::BasicBlock::Create(context, "for.latch", function);
+    loop.exit = llvm::BasicBlock::Create(context, "for.exit", function);
+    loop.limit = limit;
+    loop.step = step;
+    loop.inclusive = inclusive;
+    loop.isSigned = isSigned;
+
+    llvm::BasicBlock* preheader = builder.GetInsertBlock();
+    builder.CreateCondBr(belowLimit(builder, start, loop), loop.body, loop.exit);
+    builder.SetInsertPoint(loop.body);
+    //Two incoming values: the start from the guard and the next value from the latch
+    loop.counter = builder.CreatePHI(start->getType(), 2, "for.counter");
+    loop.counter->addIncoming(start, preheader);
+    return loop;
+}
+
+//Function to close a loop opened by openCountedLoop() after its body, the builder is left in 'exit'
+void closeCountedLoop(llvm::IRBuilder<>& builder, const CountedLoopBlocks& loop)
+{
+    //The body may already end in a 'break' or 'return'
+    if (builder.GetInsertBlock()->getTerminator() == nullptr) builder.CreateBr(loop.latch);
+    builder.SetInsertPoint(loop.latch);
+    //loops.h only matches loops whose last step stays inside the type
+    llvm::Value* step = llvm::ConstantInt::get(loop.counter->getType(), (uint64_t)loop.step, true);
+    llvm::Value* next = builder.CreateAdd(loop.counter, step, "for.next", !loop.isSigned, loop.isSigned);
+    loop.counter->addIncoming(next, loop.latch);
+    llvm::BranchInst* back = builder.CreateCondBr(belowLimit(builder, next, loop), loop.body, loop.exit);
+
+    //The loop always ends, so it may be deleted or rotated like a C++ loop
+    llvm::LLVMContext& context = builder.getContext();
+    llvm::MDNode* progress = llvm::MDNode::get(context, llvm::MDString::get(context, "llvm.loop.mustprogress"));
+    llvm::MDNode* self = llvm::MDNode::getDistinct(context, {nullptr, progress});
+    self->replaceOperandWith(0, self);
+    back->setMetadata(llvm::LLVMContext::MD_loop, self);
+    builder.SetInsertPoint(loop.exit);
+}
+
+//Helper to serialize a module to bitcode, the only way to move IR between contexts
+static std::string writeBitcode(const llvm::Module& module)
+{
+    std::string bytes;
+    llvm::raw_string_ostream stream(bytes);
+    llvm::WriteBitcodeToFile(module, stream);
+    stream.flush();
+    return bytes;
+}
+
+//Helper to parse bitcode made by writeBitcode() into 'context'
+static std::unique_ptr<llvm::Module> readBitcode(const std::string& bytes, llvm::LLVMContext& context,
+                                                 std::string& error)
+{
+    llvm::MemoryBufferRef buffer(bytes, "partition");
+    llvm::Expected<std::unique_ptr<llvm::Module>> module = llvm::parseBitcodeFile(buffer, context);
+    if (!module)
+    {
+        error = llvm::toString(module.takeError());
+        return nullptr;
+    }
+    return std::move(*module);
+}
+
+//Helper to drop the local functions and globals nothing refers to once the partitions are linked
+static void removeDeadGlobals(llvm::Module& module)
+{
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager sccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    llvm::PassBuilder builder;
+    builder.registerModuleAnalyses(moduleAnalyses);
+    builder.registerCGSCCAnalyses(sccAnalyses);
+    builder.registerFunctionAnalyses(functionAnalyses);
+    builder.registerLoopAnalyses(loopAnalyses);
+    builder.crossRegisterProxies(loopAnalyses, functionAnalyses, sccAnalyses, moduleAnalyses);
+    llvm::ModulePassManager passes;
+    passes.addPass(llvm::GlobalDCEPass());
+    passes.run(module, moduleAnalyses);
+}
+
+//Function to optimize a module on 'jobs' worker threads, partitions are linked back into 'module'
+bool optimizeModuleParallel(std::unique_ptr<llvm::Module>& module, llvm::TargetMachine* machine,
+                            const CodegenOptions& options, const unsigned jobs, std::string& error,
+                            PassTimings* timings)
+{
+    unsigned definitions = 0;
+    for (const llvm::Function& function : *module)
+    {
+        if (!function.isDeclaration()) definitions++;
+    }
+    const unsigned partitions = std::min(jobs, definitions);
+    if (partitions < 2 || options.level == OptLevel::O0)
+    {
+        optimizeModule(*module, machine, options.level, timings);
+        return true;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point splitStart = Clock::now();
+    //Splitting makes local symbols external so partitions can refer to each other, their linkage is put back afterwards
+    std::unordered_map<std::string, std::pair<llvm::GlobalValue::LinkageTypes, llvm::GlobalValue::VisibilityTypes>> locals;
+    for (const llvm::GlobalValue& value : module->global_values())
+    {
+        if (value.hasLocalLinkage() && value.hasName())
+        {
+            locals.emplace(value.getName().str(), std::make_pair(value.getLinkage(), value.getVisibility()));
+        }
+    }
+    std::vector<std::string> inputs;
+    llvm::SplitModule(*module, partitions, [&](std::unique_ptr<llvm::Module> partition)
+    {
+        inputs.push_back(writeBitcode(*partition));
+    });
+
+    //Every worker takes the next partition, with a context and target machine of its own
+    const Clock::duration splitTime = Clock::now() - splitStart;
+    std::vector<std::string> outputs(inputs.size());
+    std::atomic<size_t> next{0};
+    std::mutex errorLock;
+    auto work = [&]()
+    {
+        std::string workerError;
+        std::unique_ptr<llvm::TargetMachine> workerMachine = createTargetMachine(options, workerError);
+        for (size_t i = next.fetch_add(1); i < inputs.size() && workerMachine != nullptr; i = next.fetch_add(1))
+        {
+            llvm::LLVMContext context;
+            std::unique_ptr<llvm::Module> partition = readBitcode(inputs[i], context, workerError);
+            if (partition == nullptr) break;
+            optimizeModule(*partition, workerMachine.get(), options.level, timings);
+            outputs[i] = writeBitcode(*partition);
+        }
+        if (!workerError.empty())
+        {
+            const std::lock_guard<std::mutex> guard(errorLock);
+            error = workerError;
+        }
+    };
+    //The calling thread is one of the workers
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < std::min<size_t>(jobs, inputs.size()); i++)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+    if (!error.empty()) return false;
+
+    const Clock::time_point linkStart = Clock::now();
+    auto linked = std::make_unique<llvm::Module>(module->getModuleIdentifier(), module->getContext());
+    linked->setSourceFileName(module->getSourceFileName());
+    for (const std::string& bytes : outputs)
+    {
+        std::unique_ptr<llvm::Module> partition = readBitcode(bytes, module->getContext(), error);
+        if (partition == nullptr) return false;
+        if (linked->getTargetTriple().empty())
+        {
+            linked->setTargetTriple(partition->getTargetTriple());
+            linked->setDataLayout(partition->getDataLayout());
+        }
+        if (llvm::Linker::linkModules(*linked, std::move(partition)))
+        {
+            error = "cannot link the optimized partitions of '" + module->getModuleIdentifier() + "'";
+            return false;
+        }
+    }
+    for (const auto& [name, linkage] : locals)
+    {
+        llvm::GlobalValue* value = linked->getNamedValue(name);
+        if (value == nullptr) continue;
+        value->setLinkage(linkage.first);
+        value->setVisibility(linkage.second);
+    }
+    removeDeadGlobals(*linked);
+    module = std::move(linked);
+    if (timings != nullptr)
+    {
+        const std::lock_guard<std::mutex> guard(timings->lock);
+        timings->partitionSeconds += std::chrono::duration<double>(splitTime + (Clock::now() - linkStart)).count();
+    }
+    return true;
+}
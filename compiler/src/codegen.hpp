@@ -0,0 +1,64 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef CODEGEN_HPP
+#define CODEGEN_HPP
+
+#include "llvm_utils.hpp"
+#include <llvm/IR/IRBuilder.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//One arm of a 'match' on an integer: the value it matches and the block of its body
+struct MatchCase
+{
+    int64_t value;
+    llvm::BasicBlock* body;
+};
+
+//Function to lower the dispatch of a 'match' to a single LLVM 'switch'. The
+//backend turns dense case sets into a jump table and sparse ones into a
+//balanced compare tree, so the number of arms does not add a compare per case.
+//'defaultBlock' is the '(_)' arm or the block after the match. Duplicate values keep their first arm
+llvm::SwitchInst* emitMatchSwitch(llvm::IRBuilder<>& builder, llvm::Value* scrutinee,
+                                  const std::vector<MatchCase>& cases, llvm::BasicBlock* defaultBlock);
+
+//Blocks and values of a counted loop, see openCountedLoop()
+struct CountedLoopBlocks
+{
+    llvm::PHINode* counter;     //Typed induction variable, read it in the body
+    llvm::BasicBlock* body;     //First block of the body
+    llvm::BasicBlock* latch;    //Steps the counter, the target of 'continue'
+    llvm::BasicBlock* exit;     //Block after the loop, the target of 'break'
+    llvm::Value* limit;
+    int64_t step;
+    bool inclusive;
+    bool isSigned;
+};
+
+//Function to open a counted loop (see loops.h) at the builder in the shape
+//LLVM's loop passes expect: a guard that skips a loop running zero times, one
+//body entered with a phi of the variable's own type, and a single latch that
+//steps it without wrapping and branches back. LoopVectorize and the unroller
+//compute the trip count of that shape, so no loop-carried test is left in
+//the body. The builder is left at the start of the body. A 'for-in' over
+//an array of known length uses it with a start of 0, a limit of the length
+//and a step of 1, so its elements load through an inbounds GEP without a
+//bounds check. 'start' and 'limit' must have the same integer type
+CountedLoopBlocks openCountedLoop(llvm::IRBuilder<>& builder, llvm::Value* start, llvm::Value* limit,
+                                  int64_t step, bool inclusive, bool isSigned);
+//Function to close a loop opened by openCountedLoop() after its body, the builder is left in 'exit'
+void closeCountedLoop(llvm::IRBuilder<>& builder, const CountedLoopBlocks& loop);
+
+//Function to optimize a module on 'jobs' worker threads. The functions are split
+//into one partition per worker, each partition runs the pipeline of 'options'
+//in an LLVMContext of its own, and the results are linked back into 'module'.
+//Calls only inline within a partition. Local symbols keep their linkage.
+//Pass times are added to 'timings' when it is not nullptr. Returns false and sets 'error' when a partition fails
+bool optimizeModuleParallel(std::unique_ptr<llvm::Module>& module, llvm::TargetMachine* machine,
+                            const CodegenOptions& options, unsigned jobs, std::string& error,
+                            PassTimings* timings = nullptr);
+
+#endif //CODEGEN_HPP
@@ -0,0 +1,70 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "jit.hpp"
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/Error.h>
+#include <cstdio>
+
+//Helper to print an llvm::Error the way lykac prints its errors
+static int jitError(llvm::Error error)
+{
+    fprintf(stderr, "lykac: error: jit: %s\n", llvm::toString(std::move(error)).c_str());
+    return -1;
+}
+
+//Function to run a module in process with ORC's lazy JIT
+int runJit(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context,
+           const CodegenOptions& options, const std::vector<std::string>& args)
+{
+    initializeNativeTarget();
+    auto targetBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!targetBuilder) return jitError(targetBuilder.takeError());
+    //The JIT always runs on this machine, so -march=native is the natural default
+    if (!options.cpu.empty() && options.cpu != "native") targetBuilder->setCPU(options.cpu);
+    if (!options.features.empty()) targetBuilder->addFeatures({options.features});
+
+    auto jit = llvm::orc::LLLazyJITBuilder().setJITTargetMachineBuilder(std::move(*targetBuilder)).create();
+    if (!jit) return jitError(jit.takeError());
+
+    //Lyka programs call into the C runtime (printf, malloc)
+    const char prefix = (*jit)->getDataLayout().getGlobalPrefix();
+    auto processSymbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(prefix);
+    if (!processSymbols) return jitError(processSymbols.takeError());
+    (*jit)->getMainJITDylib().addGenerator(std::move(*processSymbols));
+
+    //Each lazily extracted function goes through the -O pipeline right before it is compiled
+    const OptLevel level = options.level;
+    (*jit)->getIRTransformLayer().setTransform(
+        [level](llvm::orc::ThreadSafeModule partition, const llvm::orc::MaterializationResponsibility&)
+        {
+            partition.withModuleDo([level](llvm::Module& part) { optimizeModule(part, nullptr, level); });
+            return llvm::Expected<llvm::orc::ThreadSafeModule>(std::move(partition));
+        });
+
+    module->setDataLayout((*jit)->getDataLayout());
+    if (llvm::Error error = (*jit)->addLazyIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context))))
+    {
+        return jitError(std::move(error));
+    }
+
+    auto mainSymbol = (*jit)->lookup("main");
+    if (!mainSymbol) return jitError(mainSymbol.takeError());
+#if LLVM_VERSION_MAJOR >= 15
+    auto* entry = mainSymbol->toPtr<int (*)(int, char**)>();
+#else
+    auto* entry = reinterpret_cast<int (*)(int, char**)>(mainSymbol->getAddress());
+#endif
+
+    std::vector<char*> argv;
+    for (const std::string& arg : args)
+    {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    return entry((int)args.size(), argv.data());
+}
@@ -0,0 +1,21 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef JIT_HPP
+#define JIT_HPP
+
+#include "llvm_utils.hpp"
+#include <llvm/IR/Module.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+//Function to run a module in process with ORC's lazy JIT ('lykac --jit').
+//Functions are compiled (and optimized at options.level) the first time they
+//are called, so start-up only pays for the code that actually runs.
+//Calls the module's 'main' with 'args' (args[0] is the program name) and
+//returns its exit status, or -1 after printing an error to stderr
+int runJit(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context,
+           const CodegenOptions& options, const std::vector<std::string>& args);
+
+#endif //JIT_HPP
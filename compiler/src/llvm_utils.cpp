@@ -0,0 +1,282 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "llvm_utils.hpp"
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/PassInstrumentation.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/SubtargetFeature.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/TargetParser/Host.h>
+#else
+#include <llvm/Support/Host.h>
+#endif
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+//Helper to check for a flag of the form 'prefix=value'
+static bool flagValue(const char* arg, const char* prefix, std::string& value)
+{
+    const size_t length = strlen(prefix);
+    if (strncmp(arg, prefix, length) != 0) return false;
+    value = arg + length;
+    return true;
+}
+
+//Function to parse one code generation flag into 'options'
+bool parseTargetFlag(const char* arg, CodegenOptions& options, std::string& error)
+{
+    if (strcmp(arg, "-O0") == 0) options.level = OptLevel::O0;
+    else if (strcmp(arg, "-O1") == 0) options.level = OptLevel::O1;
+    else if (strcmp(arg, "-O2") == 0 || strcmp(arg, "-O") == 0) options.level = OptLevel::O2;
+    else if (strcmp(arg, "-O3") == 0) options.level = OptLevel::O3;
+    else if (strcmp(arg, "-Os") == 0) options.level = OptLevel::Os;
+    else if (flagValue(arg, "-march=", options.cpu) || flagValue(arg, "-mcpu=", options.cpu))
+    {
+        if (options.cpu.empty()) error = std::string("missing CPU name in '") + arg + "'";
+    }
+    else if (flagValue(arg, "-mattr=", options.features)) {}
+    else if (flagValue(arg, "--target=", options.triple))
+    {
+        if (options.triple.empty()) error = std::string("missing triple in '") + arg + "'";
+    }
+    else return false;
+    return true;
+}
+
+//Function to register the native target, once per process
+void initializeNativeTarget()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+
+//Helper to get the feature string of the host CPU
+static std::string hostFeatures()
+{
+    llvm::SubtargetFeatures features;
+#if LLVM_VERSION_MAJOR >= 19
+    for (const auto& feature : llvm::sys::getHostCPUFeatures())
+    {
+        features.AddFeature(feature.first(), feature.second);
+    }
+#else
+    llvm::StringMap<bool> hostFeatures;
+    if (llvm::sys::getHostCPUFeatures(hostFeatures))
+    {
+        for (const auto& feature : hostFeatures)
+        {
+            features.AddFeature(feature.first(), feature.second);
+        }
+    }
+#endif
+    return features.getString();
+}
+
+//Helper to map an optimization level to the code generator's
+#if LLVM_VERSION_MAJOR >= 18
+static llvm::CodeGenOptLevel codegenLevel(const OptLevel level)
+{
+    switch (level)
+    {
+    case OptLevel::O0: return llvm::CodeGenOptLevel::None;
+    case OptLevel::O1: return llvm::CodeGenOptLevel::Less;
+    case OptLevel::O3: return llvm::CodeGenOptLevel::Aggressive;
+    default: return llvm::CodeGenOptLevel::Default;
+    }
+}
+#else
+static llvm::CodeGenOpt::Level codegenLevel(const OptLevel level)
+{
+    switch (level)
+    {
+    case OptLevel::O0: return llvm::CodeGenOpt::None;
+    case OptLevel::O1: return llvm::CodeGenOpt::Less;
+    case OptLevel::O3: return llvm::CodeGenOpt::Aggressive;
+    default: return llvm::CodeGenOpt::Default;
+    }
+}
+#endif
+
+//Function to create the target machine for 'options', returns nullptr and sets 'error' on failure
+std::unique_ptr<llvm::TargetMachine> createTargetMachine(const CodegenOptions& options, std::string& error)
+{
+    initializeNativeTarget();
+    const std::string triple = options.triple.empty() ? llvm::sys::getDefaultTargetTriple() : options.triple;
+    const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+    if (target == nullptr) return nullptr;
+
+    std::string cpu = options.cpu.empty() ? "generic" : options.cpu;
+    std::string features = options.features;
+    if (cpu == "native")
+    {
+        cpu = llvm::sys::getHostCPUName().str();
+        //Explicit -mattr= flags come last so they override what the host reports
+        const std::string host = hostFeatures();
+        features = features.empty() ? host : host + "," + features;
+    }
+
+    else if (cpu != "generic")
+    {
+        //LLVM only warns about an unknown CPU and falls back to generic code, which is not what -march asked for
+        const std::unique_ptr<llvm::MCSubtargetInfo> subtarget(target->createMCSubtargetInfo(triple, "", ""));
+        if (subtarget == nullptr || !subtarget->isCPUStringValid(cpu))
+        {
+            error = "unknown target CPU '" + cpu + "'";
+            return nullptr;
+        }
+    }
+
+    llvm::TargetOptions targetOptions;
+    std::unique_ptr<llvm::TargetMachine> machine(target->createTargetMachine(
+        triple, cpu, features, targetOptions, llvm::Reloc::PIC_, {}, codegenLevel(options.level)));
+    if (machine == nullptr) error = "cannot create a target machine for '" + triple + "'";
+    return machine;
+}
+
+//Helper to map an optimization level to the pass builder's
+static llvm::OptimizationLevel passLevel(const OptLevel level)
+{
+    switch (level)
+    {
+    case OptLevel::O0: return llvm::OptimizationLevel::O0;
+    case OptLevel::O1: return llvm::OptimizationLevel::O1;
+    case OptLevel::O3: return llvm::OptimizationLevel::O3;
+    case OptLevel::Os: return llvm::OptimizationLevel::Os;
+    default: return llvm::OptimizationLevel::O2;
+    }
+}
+
+//Helper to time every pass a pass builder runs and add it to 'timings' once the pipeline is done
+class PassTimer
+{
+public:
+    explicit PassTimer(llvm::PassInstrumentationCallbacks& callbacks)
+    {
+        callbacks.registerBeforeNonSkippedPassCallback([this](llvm::StringRef, llvm::Any)
+        {
+            running.push_back({Clock::now(), 0.0});
+        });
+        callbacks.registerAfterPassCallback([this](llvm::StringRef name, llvm::Any, const llvm::PreservedAnalyses&)
+        {
+            finish(name);
+        });
+        callbacks.registerAfterPassInvalidatedCallback([this](llvm::StringRef name, const llvm::PreservedAnalyses&)
+        {
+            finish(name);
+        });
+    }
+
+    //Function to merge what was measured into the shared timings
+    void report(PassTimings& timings) const
+    {
+        const std::lock_guard<std::mutex> guard(timings.lock);
+        for (const auto& [name, time] : measured)
+        {
+            auto& total = timings.passes[name];
+            total.first += time.first;
+            total.second += time.second;
+        }
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    //Passes run nested inside adaptors and pass managers, each level keeps the time of the ones inside it
+    std::vector<std::pair<Clock::time_point, double>> running;
+    std::map<std::string, std::pair<double, int>> measured;
+
+    void finish(const llvm::StringRef name)
+    {
+        if (running.empty()) return;
+        const auto [start, nested] = running.back();
+        running.pop_back();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        auto& time = measured[name.str()];
+        time.first += elapsed - nested;
+        time.second++;
+        if (!running.empty()) running.back().second += elapsed;
+    }
+};
+
+//Function to run the standard new pass manager pipeline of 'level' over a module
+void optimizeModule(llvm::Module& module, llvm::TargetMachine* machine, const OptLevel level, PassTimings* timings)
+{
+    if (machine != nullptr)
+    {
+        //Target aware passes (vectorizer costs, inlining) need the module to match the machine
+        module.setTargetTriple(machine->getTargetTriple().str());
+        module.setDataLayout(machine->createDataLayout());
+    }
+
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager sccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    llvm::PassInstrumentationCallbacks callbacks;
+    std::optional<PassTimer> timer;
+    if (timings != nullptr) timer.emplace(callbacks);
+    llvm::PassBuilder builder(machine, llvm::PipelineTuningOptions(), {}, &callbacks);
+    builder.registerModuleAnalyses(moduleAnalyses);
+    builder.registerCGSCCAnalyses(sccAnalyses);
+    builder.registerFunctionAnalyses(functionAnalyses);
+    builder.registerLoopAnalyses(loopAnalyses);
+    builder.crossRegisterProxies(loopAnalyses, functionAnalyses, sccAnalyses, moduleAnalyses);
+
+    llvm::ModulePassManager passes = level == OptLevel::O0
+        ? builder.buildO0DefaultPipeline(llvm::OptimizationLevel::O0)
+        : builder.buildPerModuleDefaultPipeline(passLevel(level));
+    passes.run(module, moduleAnalyses);
+    if (timer) timer->report(*timings);
+}
+
+//Function to compile a module to an object file at 'path'
+bool emitObjectFile(llvm::Module& module, llvm::TargetMachine& machine, const std::string& path, std::string& error)
+{
+    module.setTargetTriple(machine.getTargetTriple().str());
+    module.setDataLayout(machine.createDataLayout());
+    std::error_code code;
+    llvm::raw_fd_ostream output(path, code, llvm::sys::fs::OF_None);
+    if (code)
+    {
+        error = "cannot open '" + path + "': " + code.message();
+        return false;
+    }
+    //Machine code emission still runs on the legacy pass manager
+    llvm::legacy::PassManager passes;
+#if LLVM_VERSION_MAJOR >= 18
+    const llvm::CodeGenFileType fileType = llvm::CodeGenFileType::ObjectFile;
+#else
+    const llvm::CodeGenFileType fileType = llvm::CGFT_ObjectFile;
+#endif
+    if (machine.addPassesToEmitFile(passes, output, nullptr, fileType))
+    {
+        error = "the target cannot emit object files";
+        return false;
+    }
+    passes.run(module);
+    output.flush();
+    if (output.has_error())
+    {
+        error = "cannot write '" + path + "': " + output.error().message();
+        output.clear_error();
+        return false;
+    }
+    return true;
+}
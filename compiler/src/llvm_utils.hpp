@@ -0,0 +1,56 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef LLVM_UTILS_HPP
+#define LLVM_UTILS_HPP
+
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+//Enum to hold the optimization levels lykac accepts (-O0 .. -O3, -Os)
+enum class OptLevel
+{
+    O0,
+    O1,
+    O2,
+    O3,
+    Os
+};
+
+//Struct to hold the code generation options of a compilation
+struct CodegenOptions
+{
+    OptLevel level = OptLevel::O2;
+    std::string triple;   //--target=, empty for the host
+    std::string cpu;      //-march= / -mcpu=, 'native' is resolved to the host CPU
+    std::string features; //-mattr=, comma separated '+feature' / '-feature'
+};
+
+//Struct to hold where the time of the optimization pipelines went, shared by every worker of a compilation
+struct PassTimings
+{
+    std::mutex lock;
+    std::map<std::string, std::pair<double, int>> passes; //Exclusive seconds and runs by pass name
+    double partitionSeconds = 0;                          //Splitting modules and linking the partitions back
+};
+
+//Function to parse one code generation flag into 'options'.
+//Returns false when 'arg' is not such a flag, sets 'error' when it is one but malformed
+bool parseTargetFlag(const char* arg, CodegenOptions& options, std::string& error);
+//Function to register the native target, once per process
+void initializeNativeTarget();
+//Function to create the target machine for 'options', returns nullptr and sets 'error' on failure
+std::unique_ptr<llvm::TargetMachine> createTargetMachine(const CodegenOptions& options, std::string& error);
+//Function to run the standard new pass manager pipeline of 'level' over a module,
+//the time of every pass is added to 'timings' when it is not nullptr
+void optimizeModule(llvm::Module& module, llvm::TargetMachine* machine, OptLevel level,
+                    PassTimings* timings = nullptr);
+//Function to compile a module to an object file at 'path', returns false and sets 'error' on failure
+bool emitObjectFile(llvm::Module& module, llvm::TargetMachine& machine, const std::string& path, std::string& error);
+
+#endif //LLVM_UTILS_HPP
@@ -0,0 +1,350 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "cache.hpp"
+#include "codegen.hpp"
+#include "jit.hpp"
+#include "lexer.h"
+#include "llvm_utils.hpp"
+#include "parallel_lex.h"
+#include "source.h"
+#include "stats.h"
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Result of lexing a single module
+struct LexResult
+{
+    size_t tokenCount = 0;
+    std::vector<std::string> errors;
+    size_t sourceBytes = 0;
+    double readSeconds = 0;
+    double lexSeconds = 0;
+};
+
+//Function to spell a lex result as a cache artifact, errors are kept without the module path
+static std::string encodeLexResult(const LexResult& result, const size_t pathLength)
+{
+    std::string bytes = "lyka-lex " + std::to_string(result.tokenCount) + " " + std::to_string(result.errors.size()) + "\n";
+    for (const std::string& error : result.errors)
+    {
+        bytes.append(error, pathLength, std::string::npos);
+        bytes += '\n';
+    }
+    return bytes;
+}
+
+//Function to read back a lex result artifact, false when it is malformed
+static bool decodeLexResult(const std::string& bytes, const char* path, LexResult& result)
+{
+    std::istringstream stream(bytes);
+    std::string magic;
+    size_t errorCount = 0;
+    if (!(stream >> magic >> result.tokenCount >> errorCount) || magic != "lyka-lex" || stream.get() != '\n')
+    {
+        return false;
+    }
+    result.errors.clear();
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        result.errors.push_back(path + line);
+    }
+    return result.errors.size() == errorCount;
+}
+
+//Function that tokenizes one module on up to 'jobs' threads, an unchanged module is answered from the cache
+static LexResult lexModule(const char* path, const BuildCache& cache, const unsigned jobs)
+{
+    LexResult result;
+    const double start = statsClock();
+    Source source = loadSource(path);
+    const double loaded = statsClock();
+    result.sourceBytes = source.length;
+    result.readSeconds = loaded - start;
+    //Lexing does not depend on code generation flags, only on the source bytes
+    const CacheKey key = cache.key(source.data, source.length, "lex");
+    std::string cached;
+    if (cache.load(key, "lex", cached) && decodeLexResult(cached, path, result))
+    {
+        freeSource(&source);
+        result.lexSeconds = statsClock() - loaded;
+        return result;
+    }
+
+    TokenBuffer tokens;
+    initTokenBuffer(&tokens);
+    tokenizeParallel(&tokens, source.data, source.length, (int)jobs);
+    for (int i = 0; i < tokens.errorCount; i++)
+    {
+        result.errors.push_back(std::string(path) + ":" + std::to_string(tokenLine(&tokens, tokens.errors[i].index)) +
+                                ": error: " + tokens.errors[i].message);
+    }
+    //EOF is not counted
+    result.tokenCount = (size_t)tokens.count - 1;
+    freeTokenBuffer(&tokens);
+    freeSource(&source);
+    cache.store(key, "lex", encodeLexResult(result, strlen(path)));
+    result.lexSeconds = statsClock() - loaded;
+    return result;
+}
+
+//Function that tokenizes every module on a pool of worker threads, results keep the input order
+static std::vector<LexResult> lexModules(const std::vector<const char*>& paths, const BuildCache& cache,
+                                         const unsigned jobs)
+{
+    std::vector<LexResult> results(paths.size());
+    //Fewer modules than workers leaves threads to split each module into chunks
+    const unsigned threadsPerModule = paths.empty() ? 1 : std::max<unsigned>(1, jobs / (unsigned)paths.size());
+    std::atomic<size_t> next{0};
+    auto work = [&]()
+    {
+        for (size_t i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1))
+        {
+            results[i] = lexModule(paths[i], cache, threadsPerModule);
+        }
+    };
+
+    const size_t workers = std::min<size_t>(jobs, paths.size());
+    //The calling thread is one of the workers
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers; i++)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+//Helper to check for an LLVM IR input (.ll or .bc)
+static bool isIRFile(const char* path)
+{
+    const size_t length = strlen(path);
+    return length > 3 && (strcmp(path + length - 3, ".ll") == 0 || strcmp(path + length - 3, ".bc") == 0);
+}
+
+//Function that compiles an IR module to an object file next to it, returns the exit status.
+//Pass times are only collected when 'timings' is not nullptr
+static int compileIRModule(const char* self, const char* path, llvm::TargetMachine& machine,
+                           const CodegenOptions& options, const unsigned jobs, Stats& stats, PassTimings* timings)
+{
+    double start = statsClock();
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic diagnostic;
+    std::unique_ptr<llvm::Module> module = llvm::parseIRFile(path, diagnostic, context);
+    if (module == nullptr)
+    {
+        diagnostic.print(self, llvm::errs());
+        return 65;
+    }
+    start = addPhaseTime(&stats, PHASE_PARSE, start);
+    stats.moduleCount++;
+
+    std::string error;
+    const std::string output = std::string(path, strlen(path) - 3) + ".o";
+    const double partitionBefore = timings != nullptr ? timings->partitionSeconds : 0;
+    const bool optimized = optimizeModuleParallel(module, &machine, options, jobs, error, timings);
+    //Splitting and relinking the partitions is reported as the link phase
+    const double partitionSeconds = timings != nullptr ? timings->partitionSeconds - partitionBefore : 0;
+    const double optimizedAt = statsClock();
+    addPhaseSeconds(&stats, PHASE_OPTIMIZE, optimizedAt - start - partitionSeconds);
+    if (partitionSeconds > 0) addPhaseSeconds(&stats, PHASE_LINK, partitionSeconds);
+    if (!optimized || !emitObjectFile(*module, machine, output, error))
+    {
+        fprintf(stderr, "%s: error: %s: %s\n", self, path, error.c_str());
+        return 70;
+    }
+    addPhaseTime(&stats, PHASE_CODEGEN, optimizedAt);
+    return 0;
+}
+
+//Function to print the report of a run, passes sorted by the time they took
+static void reportStats(const Stats& stats, const StatsFormat format, PassTimings& timings)
+{
+    std::vector<PassTime> passes;
+    for (const auto& [name, time] : timings.passes)
+    {
+        passes.push_back(PassTime{name.c_str(), time.first, time.second});
+    }
+    std::sort(passes.begin(), passes.end(), [](const PassTime& a, const PassTime& b) { return a.seconds > b.seconds; });
+    printStats(stderr, &stats, format, passes.data(), (int)passes.size());
+}
+
+//Function that compiles and runs one program in process, returns its exit status
+static int runJitMode(const char* self, const char* path, const CodegenOptions& options,
+                      const BuildCache& cache, std::vector<std::string> programArgs, Stats& stats)
+{
+    if (!isIRFile(path))
+    {
+        const LexResult result = lexModule(path, cache, std::max(1u, std::thread::hardware_concurrency()));
+        addPhaseSeconds(&stats, PHASE_READ, result.readSeconds);
+        addPhaseSeconds(&stats, PHASE_LEX, result.lexSeconds);
+        stats.moduleCount++;
+        stats.sourceBytes += result.sourceBytes;
+        stats.tokenCount += result.tokenCount;
+        for (const std::string& error : result.errors)
+        {
+            fprintf(stderr, "%s\n", error.c_str());
+        }
+        if (!result.errors.empty()) return 65;
+        //Lyka modules reach the JIT through the same path once IR generation lands
+        fprintf(stderr, "%s: error: --jit: no IR generator for Lyka modules yet, pass a .ll or .bc file\n", self);
+        return 70;
+    }
+
+    const double start = statsClock();
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic diagnostic;
+    std::unique_ptr<llvm::Module> module = llvm::parseIRFile(path, diagnostic, *context);
+    if (module == nullptr)
+    {
+        diagnostic.print(self, llvm::errs());
+        return 65;
+    }
+    const double parsed = addPhaseTime(&stats, PHASE_PARSE, start);
+    stats.moduleCount++;
+    programArgs.insert(programArgs.begin(), path);
+    //Functions are compiled lazily as they are first called, so that time is part of evaluate
+    const int status = runJit(std::move(module), std::move(context), options, programArgs);
+    addPhaseTime(&stats, PHASE_EVALUATE, parsed);
+    return status < 0 ? 70 : status;
+}
+
+int main(const int argc , char *argv[])
+{
+    //Code generation flags may appear anywhere, everything else is a module ('-' is stdin).
+    //With --jit the first module is the program and every argument after it is passed to its main
+    Stats stats;
+    initStats(&stats);
+    CodegenOptions options;
+    StatsFormat statsFormat = STATS_OFF;
+    bool jit = false;
+    std::string cacheDirectory = BuildCache::defaultDirectory();
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const char*> paths;
+    std::vector<std::string> programArgs;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string error;
+        if (jit && !paths.empty())
+        {
+            programArgs.push_back(argv[i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--jit") == 0)
+        {
+            jit = true;
+            continue;
+        }
+        if (parseStatsFlag(argv[i], &statsFormat)) continue;
+        if (strncmp(argv[i], "--cache-dir=", 12) == 0)
+        {
+            cacheDirectory = argv[i] + 12;
+            continue;
+        }
+        if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            cacheDirectory.clear();
+            continue;
+        }
+        if (strncmp(argv[i], "--jobs=", 7) == 0)
+        {
+            char* end;
+            const unsigned long count = strtoul(argv[i] + 7, &end, 10);
+            if (*end != '\0' || count == 0 || count > 4096)
+            {
+                fprintf(stderr, "%s: error: invalid job count in '%s'\n", argv[0], argv[i]);
+                return 64;
+            }
+            jobs = (unsigned)count;
+            continue;
+        }
+        if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            if (!parseTargetFlag(argv[i], options, error))
+            {
+                error = std::string("unknown option '") + argv[i] + "'";
+            }
+            if (!error.empty())
+            {
+                fprintf(stderr, "%s: error: %s\n", argv[0], error.c_str());
+                return 64;
+            }
+            continue;
+        }
+        paths.push_back(argv[i]);
+    }
+
+    if (paths.empty())
+    {
+        printf("No input file provided.\n");
+        printf("Usage: %s [-O0|-O1|-O2|-O3|-Os] [-march=<cpu>|native] [-mattr=<features>] [--target=<triple>]\n"
+               "       [--cache-dir=<dir>|--no-cache] [--jobs=<n>] [--time-report|--stats=json]\n"
+               "       <file.lk|file.ll|file.bc> [file ...]\n" , argv[0]);
+        printf("       %s --jit [options] <file> [program arguments ...]\n" , argv[0]);
+        printf("Program terminated.\n");
+        return 0;
+    }
+
+    //Resolve the target up front, so a bad -march or triple fails before any module is read
+    std::string targetError;
+    const std::unique_ptr<llvm::TargetMachine> machine = createTargetMachine(options, targetError);
+    if (machine == nullptr)
+    {
+        fprintf(stderr, "%s: error: %s\n", argv[0], targetError.c_str());
+        return 64;
+    }
+
+    const BuildCache cache(cacheDirectory);
+    PassTimings timings;
+    if (jit)
+    {
+        const int status = runJitMode(argv[0], paths[0], options, cache, programArgs, stats);
+        if (statsFormat != STATS_OFF) reportStats(stats, statsFormat, timings);
+        return status;
+    }
+
+    //Lyka modules are lexed together on the worker pool, IR modules are compiled to objects one by one
+    //with their functions spread over the same number of workers
+    std::vector<const char*> lykaPaths;
+    std::vector<const char*> irPaths;
+    for (const char* path : paths)
+    {
+        (isIRFile(path) ? irPaths : lykaPaths).push_back(path);
+    }
+    int status = 0;
+    for (const LexResult& result : lexModules(lykaPaths, cache, jobs))
+    {
+        for (const std::string& error : result.errors)
+        {
+            fprintf(stderr, "%s\n", error.c_str());
+            status = 65;
+        }
+        addPhaseSeconds(&stats, PHASE_READ, result.readSeconds);
+        addPhaseSeconds(&stats, PHASE_LEX, result.lexSeconds);
+        stats.moduleCount++;
+        stats.sourceBytes += result.sourceBytes;
+        stats.tokenCount += result.tokenCount;
+    }
+    for (const char* path : irPaths)
+    {
+        const int moduleStatus = compileIRModule(argv[0], path, *machine, options, jobs, stats,
+                                                 statsFormat != STATS_OFF ? &timings : nullptr);
+        if (status == 0) status = moduleStatus;
+    }
+    if (statsFormat != STATS_OFF) reportStats(stats, statsFormat, timings);
+    return status;
+}
@@ -0,0 +1,342 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "tier.hpp"
+#include "llvm_utils.hpp"
+#include "types.h"
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/Verifier.h>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Struct to hold the state of translating one chunk
+struct ChunkTranslator
+{
+    const Chunk* chunk;
+    llvm::LLVMContext& context;
+    llvm::IRBuilder<> builder;
+    llvm::Function* function = nullptr;
+    std::vector<llvm::AllocaInst*> registers; //One stack slot per register, promoted to SSA by the optimizer
+    std::vector<llvm::BasicBlock*> blocks;    //One block per instruction, the optimizer merges straight runs
+    std::vector<llvm::BasicBlock*> failures;  //Created on demand, returns the index + 1 of the instruction
+    bool valid = true;                        //Cleared when an operand names a register outside the frame
+
+    ChunkTranslator(const Chunk* chunk, llvm::LLVMContext& context) : chunk(chunk), context(context), builder(context) {}
+
+    llvm::Type* i64() { return builder.getInt64Ty(); }
+    llvm::AllocaInst* slot(const unsigned r)
+    {
+        if (r < registers.size()) return registers[r];
+        valid = false;
+        return registers[0];
+    }
+    llvm::Value* getInt(const unsigned r) { return builder.CreateLoad(i64(), slot(r)); }
+    llvm::Value* getFloat(const unsigned r) { return builder.CreateBitCast(getInt(r), builder.getDoubleTy()); }
+    void setInt(const unsigned r, llvm::Value* value) { builder.CreateStore(value, slot(r)); }
+    void setFloat(const unsigned r, llvm::Value* value) { setInt(r, builder.CreateBitCast(value, i64())); }
+    void setBool(const unsigned r, llvm::Value* flag) { setInt(r, builder.CreateZExt(flag, i64())); }
+
+    //Helper to get the block that reports a runtime error at instruction 'index'
+    llvm::BasicBlock* failure(const int index)
+    {
+        if (failures[index] == nullptr)
+        {
+            failures[index] = llvm::BasicBlock::Create(context, "fail", function);
+            llvm::IRBuilder<> failBuilder(failures[index]);
+            failBuilder.CreateRet(failBuilder.getInt32(index + 1));
+        }
+        return failures[index];
+    }
+
+    //Helper to branch to the failure block when 'divisor' is zero, continues in a fresh block
+    void checkDivisor(const int index, llvm::Value* divisor)
+    {
+        llvm::BasicBlock* ok = llvm::BasicBlock::Create(context, "divisor_ok", function);
+        builder.CreateCondBr(builder.CreateICmpEQ(divisor, builder.getInt64(0)), failure(index), ok);
+        builder.SetInsertPoint(ok);
+    }
+
+    //Helper to check that a jump lands inside the chunk
+    bool validTarget(const int target) const { return target >= 0 && target < chunk->count; }
+
+    bool translate(llvm::Module& module, const std::string& name);
+    bool translateInstruction(int index, llvm::Value* result);
+};
+
+//Function to emit the whole chunk as 'i32 name(i64* registers, i64* result, i32 entry)'
+bool ChunkTranslator::translate(llvm::Module& module, const std::string& name)
+{
+    if (chunk->registerCount == 0) return false;
+    llvm::Type* slotPointer = i64()->getPointerTo();
+    auto* type = llvm::FunctionType::get(builder.getInt32Ty(), {slotPointer, slotPointer, builder.getInt32Ty()}, false);
+    function = llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, module);
+    llvm::Value* registerFile = function->getArg(0);
+    llvm::Value* result = function->getArg(1);
+    llvm::Value* entry = function->getArg(2);
+
+    //The entry block copies the interpreter's registers into locals
+    llvm::BasicBlock* entryBlock = llvm::BasicBlock::Create(context, "entry", function);
+    builder.SetInsertPoint(entryBlock);
+    for (int r = 0; r < chunk->registerCount; r++)
+    {
+        registers.push_back(builder.CreateAlloca(i64(), nullptr, "r" + std::to_string(r)));
+    }
+    for (int r = 0; r < chunk->registerCount; r++)
+    {
+        setInt((unsigned)r, builder.CreateLoad(i64(), builder.CreateConstGEP1_32(i64(), registerFile, (unsigned)r)));
+    }
+    for (int i = 0; i <= chunk->count; i++)
+    {
+        blocks.push_back(llvm::BasicBlock::Create(context, "i" + std::to_string(i), function));
+    }
+    failures.assign((size_t)chunk->count, nullptr);
+
+    //Execution can start at 0 or at any backward jump target (on-stack replacement of a running loop)
+    std::vector<bool> isEntry((size_t)chunk->count, false);
+    for (int i = 0; i < chunk->count; i++)
+    {
+        if (!isJumpOpcode((OpCode)INSTR_OP(chunk->code[i]))) continue;
+        const int offset = INSTR_SBX(chunk->code[i]);
+        if (!validTarget(i + 1 + offset)) return false;
+        if (offset < 0) isEntry[(size_t)(i + 1 + offset)] = true;
+    }
+    llvm::SwitchInst* dispatch = builder.CreateSwitch(entry, blocks[0]);
+    for (int i = 1; i < chunk->count; i++)
+    {
+        if (isEntry[(size_t)i]) dispatch->addCase(builder.getInt32((uint32_t)i), blocks[(size_t)i]);
+    }
+
+    for (int i = 0; i < chunk->count; i++)
+    {
+        builder.SetInsertPoint(blocks[(size_t)i]);
+        if (!translateInstruction(i, result)) return false;
+    }
+    //Running off the end behaves like OP_HALT
+    builder.SetInsertPoint(blocks[(size_t)chunk->count]);
+    builder.CreateStore(builder.getInt64(0), result);
+    builder.CreateRet(builder.getInt32(0));
+    return valid && !llvm::verifyFunction(*function, &llvm::errs());
+}
+
+//Function to emit one instruction, false for instructions the tier does not handle
+bool ChunkTranslator::translateInstruction(const int index, llvm::Value* result)
+{
+    const Instruction instruction = chunk->code[index];
+    const unsigned a = INSTR_A(instruction);
+    const unsigned b = INSTR_B(instruction);
+    const unsigned c = INSTR_C(instruction);
+    llvm::BasicBlock* next = blocks[(size_t)index + 1];
+    switch ((OpCode)INSTR_OP(instruction))
+    {
+    case OP_MOVE: setInt(a, getInt(b)); break;
+    case OP_LOAD_CONST:
+        if ((int)INSTR_BX(instruction) >= chunk->constantCount) return false;
+        setInt(a, builder.getInt64(chunk->constants[INSTR_BX(instruction)].u));
+        break;
+    case OP_LOAD_INT: setInt(a, builder.getInt64((uint64_t)(int64_t)INSTR_SBX(instruction))); break;
+
+    case OP_ADD_INT: setInt(a, builder.CreateAdd(getInt(b), getInt(c))); break;
+    case OP_SUB_INT: setInt(a, builder.CreateSub(getInt(b), getInt(c))); break;
+    case OP_MUL_INT: setInt(a, builder.CreateMul(getInt(b), getInt(c))); break;
+    case OP_DIV_INT:
+    case OP_MOD_INT:
+    {
+        llvm::Value* left = getInt(b);
+        llvm::Value* right = getInt(c);
+        checkDivisor(index, right);
+        //x / -1 is a negation in the interpreter, and must not trap on INT64_MIN here either
+        llvm::Value* minusOne = builder.CreateICmpEQ(right, builder.getInt64(UINT64_MAX));
+        llvm::Value* divisor = builder.CreateSelect(minusOne, builder.getInt64(1), right);
+        if (INSTR_OP(instruction) == OP_DIV_INT)
+        {
+            setInt(a, builder.CreateSelect(minusOne, builder.CreateSub(builder.getInt64(0), left), builder.CreateSDiv(left, divisor)));
+        }
+        else
+        {
+            setInt(a, builder.CreateSelect(minusOne, builder.getInt64(0), builder.CreateSRem(left, divisor)));
+        }
+        break;
+    }
+    case OP_DIV_UINT:
+    case OP_MOD_UINT:
+    {
+        llvm::Value* left = getInt(b);
+        llvm::Value* right = getInt(c);
+        checkDivisor(index, right);
+        setInt(a, INSTR_OP(instruction) == OP_DIV_UINT ? builder.CreateUDiv(left, right) : builder.CreateURem(left, right));
+        break;
+    }
+    case OP_ADDI_INT:
+        setInt(a, builder.CreateAdd(getInt(b), builder.getInt64((uint64_t)(int64_t)(int8_t)c)));
+        break;
+    case OP_NEG_INT: setInt(a, builder.CreateSub(builder.getInt64(0), getInt(b))); break;
+    case OP_BIT_AND: setInt(a, builder.CreateAnd(getInt(b), getInt(c))); break;
+    case OP_BIT_OR: setInt(a, builder.CreateOr(getInt(b), getInt(c))); break;
+    case OP_BIT_XOR: setInt(a, builder.CreateXor(getInt(b), getInt(c))); break;
+    case OP_BIT_NOT: setInt(a, builder.CreateNot(getInt(b))); break;
+    case OP_SHL: setInt(a, builder.CreateShl(getInt(b), builder.CreateAnd(getInt(c), 63))); break;
+    case OP_SHR: setInt(a, builder.CreateAShr(getInt(b), builder.CreateAnd(getInt(c), 63))); break;
+    case OP_SHR_UINT: setInt(a, builder.CreateLShr(getInt(b), builder.CreateAnd(getInt(c), 63))); break;
+
+    case OP_ADD_FLOAT: setFloat(a, builder.CreateFAdd(getFloat(b), getFloat(c))); break;
+    case OP_SUB_FLOAT: setFloat(a, builder.CreateFSub(getFloat(b), getFloat(c))); break;
+    case OP_MUL_FLOAT: setFloat(a, builder.CreateFMul(getFloat(b), getFloat(c))); break;
+    case OP_DIV_FLOAT: setFloat(a, builder.CreateFDiv(getFloat(b), getFloat(c))); break;
+    case OP_NEG_FLOAT: setFloat(a, builder.CreateFNeg(getFloat(b))); break;
+    case OP_INT_TO_FLOAT: setFloat(a, builder.CreateSIToFP(getInt(b), builder.getDoubleTy())); break;
+    case OP_FLOAT_TO_INT:
+    {
+        //Saturating, plain fptosi would make out of range values poison
+        llvm::Function* convert = llvm::Intrinsic::getDeclaration(function->getParent(), llvm::Intrinsic::fptosi_sat,
+                                                                  {i64(), builder.getDoubleTy()});
+        setInt(a, builder.CreateCall(convert, {getFloat(b)}));
+        break;
+    }
+    case OP_WRAP:
+    {
+        llvm::Value* value = getInt(b);
+        switch ((TypeKind)c)
+        {
+        case TYPE_I8: setInt(a, builder.CreateSExt(builder.CreateTrunc(value, builder.getInt8Ty()), i64())); break;
+        case TYPE_I16: setInt(a, builder.CreateSExt(builder.CreateTrunc(value, builder.getInt16Ty()), i64())); break;
+        case TYPE_I32: setInt(a, builder.CreateSExt(builder.CreateTrunc(value, builder.getInt32Ty()), i64())); break;
+        case TYPE_U8: setInt(a, builder.CreateAnd(value, 0xFF)); break;
+        case TYPE_U16: setInt(a, builder.CreateAnd(value, 0xFFFF)); break;
+        case TYPE_U32: setInt(a, builder.CreateAnd(value, 0xFFFFFFFF)); break;
+        case TYPE_BOOL: setBool(a, builder.CreateICmpNE(value, builder.getInt64(0))); break;
+        default: setInt(a, value); break;
+        }
+        break;
+    }
+
+    case OP_EQ_INT: setBool(a, builder.CreateICmpEQ(getInt(b), getInt(c))); break;
+    case OP_NE_INT: setBool(a, builder.CreateICmpNE(getInt(b), getInt(c))); break;
+    case OP_LT_INT: setBool(a, builder.CreateICmpSLT(getInt(b), getInt(c))); break;
+    case OP_LE_INT: setBool(a, builder.CreateICmpSLE(getInt(b), getInt(c))); break;
+    case OP_LT_UINT: setBool(a, builder.CreateICmpULT(getInt(b), getInt(c))); break;
+    case OP_LE_UINT: setBool(a, builder.CreateICmpULE(getInt(b), getInt(c))); break;
+    case OP_EQ_FLOAT: setBool(a, builder.CreateFCmpOEQ(getFloat(b), getFloat(c))); break;
+    case OP_LT_FLOAT: setBool(a, builder.CreateFCmpOLT(getFloat(b), getFloat(c))); break;
+    case OP_LE_FLOAT: setBool(a, builder.CreateFCmpOLE(getFloat(b), getFloat(c))); break;
+    case OP_NOT: setBool(a, builder.CreateICmpEQ(getInt(b), builder.getInt64(0))); break;
+
+    case OP_JUMP:
+        builder.CreateBr(blocks[(size_t)(index + 1 + INSTR_SBX(instruction))]);
+        return true;
+    case OP_JUMP_IF_FALSE:
+    case OP_JUMP_IF_TRUE:
+    {
+        llvm::BasicBlock* target = blocks[(size_t)(index + 1 + INSTR_SBX(instruction))];
+        llvm::Value* isTrue = builder.CreateICmpNE(getInt(a), builder.getInt64(0));
+        if (INSTR_OP(instruction) == OP_JUMP_IF_TRUE) builder.CreateCondBr(isTrue, target, next);
+        else builder.CreateCondBr(isTrue, next, target);
+        return true;
+    }
+    case OP_FOR_PREP:
+    case OP_FOR_LOOP:
+    {
+        llvm::BasicBlock* target = blocks[(size_t)(index + 1 + INSTR_SBX(instruction))];
+        llvm::Value* counter = getInt(a);
+        if (INSTR_OP(instruction) == OP_FOR_PREP)
+        {
+            builder.CreateCondBr(builder.CreateICmpSGE(counter, getInt(a + 1)), target, next);
+            return true;
+        }
+        //The step is known not to overflow, so the optimizer may widen or vectorize the loop
+        counter = builder.CreateNSWAdd(counter, getInt(a + 2));
+        setInt(a, counter);
+        builder.CreateCondBr(builder.CreateICmpSLT(counter, getInt(a + 1)), target, next);
+        return true;
+    }
+    case OP_SWITCH:
+    {
+        if ((int)INSTR_BX(instruction) >= chunk->switchCount) return false;
+        const SwitchTable* table = &chunk->switches[INSTR_BX(instruction)];
+        if (!validTarget(table->defaultTarget)) return false;
+        llvm::SwitchInst* dispatch = builder.CreateSwitch(getInt(a), blocks[(size_t)table->defaultTarget]);
+        for (int i = 0; i < table->count; i++)
+        {
+            const int target = table->targets[i];
+            if (!validTarget(target)) return false;
+            if (table->dense && target == table->defaultTarget) continue;
+            const uint64_t key = table->dense ? (uint64_t)table->low + (uint64_t)i : (uint64_t)table->keys[i];
+            dispatch->addCase(builder.getInt64(key), blocks[(size_t)target]);
+        }
+        return true;
+    }
+    case OP_RETURN:
+        builder.CreateStore(getInt(a), result);
+        builder.CreateRet(builder.getInt32(0));
+        return true;
+    case OP_HALT:
+        builder.CreateStore(builder.getInt64(0), result);
+        builder.CreateRet(builder.getInt32(0));
+        return true;
+
+    default:
+        //Arrays, and anything added to the VM later, stay in the interpreter
+        return false;
+    }
+    builder.CreateBr(next);
+    return true;
+}
+
+//Shared JIT of the process, created on the first tier-up
+static llvm::orc::LLJIT* tierJit()
+{
+    static std::unique_ptr<llvm::orc::LLJIT> jit;
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        initializeNativeTarget();
+        auto created = llvm::orc::LLJITBuilder().create();
+        if (created) jit = std::move(*created);
+        else fprintf(stderr, "lyka: jit tier disabled: %s\n", llvm::toString(created.takeError()).c_str());
+    });
+    return jit.get();
+}
+
+//Function to compile a chunk to native code, NULL when it cannot be translated
+NativeChunk compileChunkNative(const Chunk* chunk)
+{
+    llvm::orc::LLJIT* jit = tierJit();
+    if (jit == nullptr || chunk->count == 0) return nullptr;
+
+    static std::mutex lock;
+    static int chunkCount = 0;
+    std::string name;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        name = "lyka_chunk_" + std::to_string(chunkCount++);
+    }
+
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto module = std::make_unique<llvm::Module>(name, *context);
+    module->setDataLayout(jit->getDataLayout());
+    ChunkTranslator translator(chunk, *context);
+    if (!translator.translate(*module, name)) return nullptr;
+    optimizeModule(*module, nullptr, OptLevel::O2);
+
+    if (llvm::Error error = jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context))))
+    {
+        llvm::consumeError(std::move(error));
+        return nullptr;
+    }
+    auto symbol = jit->lookup(name);
+    if (!symbol)
+    {
+        llvm::consumeError(symbol.takeError());
+        return nullptr;
+    }
+#if LLVM_VERSION_MAJOR >= 15
+    return symbol->toPtr<NativeChunk>();
+#else
+    return reinterpret_cast<NativeChunk>(symbol->getAddress());
+#endif
+}
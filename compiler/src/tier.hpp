@@ -0,0 +1,25 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef TIER_HPP
+#define TIER_HPP
+
+#include "vm.h"
+
+//JIT tier of 'lyka' (built with LYKA_ENABLE_TIERING): translates a hot
+//bytecode chunk to LLVM IR, optimizes it at -O2 and compiles it in process.
+//The native function keeps the interpreter's register file as its frame, so
+//it can be entered at any backward jump target in the middle of a loop.
+//Chunks that use arrays are not translated and stay interpreted.
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Function to compile a chunk to native code, NULL when it cannot be translated (a TierUpHook)
+NativeChunk compileChunkNative(const Chunk* chunk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TIER_HPP
@@ -0,0 +1,61 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "array.h"
+#include "common.h"
+
+//Function to get the size of an element of a type, 0 if it cannot be an element
+int elementSizeOf(const TypeKind type)
+{
+    switch (type)
+    {
+    case TYPE_BOOL: case TYPE_CHAR: case TYPE_I8: case TYPE_U8: return 1;
+    case TYPE_I16: case TYPE_U16: return 2;
+    case TYPE_I32: case TYPE_U32: case TYPE_F32: return 4;
+    case TYPE_I64: case TYPE_U64: case TYPE_F64:
+    case TYPE_STRING: return 8; //Object pointer kept as a full Slot
+    default: return 0;
+    }
+}
+
+//Function to initialize an array of 'count' zeroed elements
+void initArray(ObjArray* array, const TypeKind elementType, const int count, const bool dynamic)
+{
+    array->obj.type = OBJ_ARRAY;
+    array->elementType = elementType;
+    array->elementSize = elementSizeOf(elementType);
+    array->dynamic = dynamic;
+    array->count = 0;
+    array->capacity = 0;
+    array->data = NULL;
+    if (count > 0) growArrayTo(array, count);
+}
+
+//Function to release the elements of an array
+void freeArray(ObjArray* array)
+{
+    free(array->data);
+    array->data = NULL;
+    array->count = 0;
+    array->capacity = 0;
+}
+
+//Function to make room for 'count' elements, new ones are zeroed
+void growArrayTo(ObjArray* array, const int count)
+{
+    if (count <= array->count) return;
+    if (count > array->capacity)
+    {
+        //Geometric growth keeps appends amortised O(1)
+        int capacity = array->capacity;
+        while (capacity < count)
+        {
+            capacity = capacity > INT32_MAX / 2 ? count : GROW_CAPACITY(capacity);
+        }
+        array->data = growArray(array->data, capacity, (size_t)array->elementSize);
+        array->capacity = capacity;
+    }
+    memset((char*)array->data + (size_t)array->count * (size_t)array->elementSize, 0,
+           (size_t)(count - array->count) * (size_t)array->elementSize);
+    array->count = count;
+}
@@ -0,0 +1,99 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include "value.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//Lyka arrays are homogeneous, so their elements are stored packed in their
+//native type ('i32 a[3]' is 12 bytes of int32_t, not three Values).
+//'name[N]' arrays have a fixed length; 'name[..]' arrays grow geometrically
+//when a write lands past the end, and the gap is zero filled.
+//The element buffer is resized in place, so it lives on the heap (see
+//docs/memory_management.md) and is released with freeArray().
+
+//Struct to hold an array
+typedef struct
+{
+    Obj obj;              //OBJ_ARRAY
+    TypeKind elementType;
+    int elementSize;      //Bytes per element
+    bool dynamic;         //'[..]' array
+    int count;
+    int capacity;
+    void* data;
+} ObjArray;
+
+//Function to initialize an array of 'count' zeroed elements
+void initArray(ObjArray* array, TypeKind elementType, int count, bool dynamic);
+//Function to release the elements of an array
+void freeArray(ObjArray* array);
+//Function to make room for 'count' elements, new ones are zeroed
+void growArrayTo(ObjArray* array, int count);
+//Function to get the size of an element of a type, 0 if it cannot be an element
+int elementSizeOf(TypeKind type);
+
+//Helper to read element 'index', the caller has checked the bounds
+static inline Slot arrayLoadUnchecked(const ObjArray* array, const int64_t index)
+{
+    Slot slot;
+    switch (array->elementType)
+    {
+    case TYPE_BOOL:
+    case TYPE_CHAR: //Chars are zero-extended like charValue(), so they compare equal to one in a register
+    case TYPE_U8: slot.u = ((const uint8_t*)array->data)[index]; break;
+    case TYPE_I8: slot.i = ((const int8_t*)array->data)[index]; break;
+    case TYPE_I16: slot.i = ((const int16_t*)array->data)[index]; break;
+    case TYPE_U16: slot.u = ((const uint16_t*)array->data)[index]; break;
+    case TYPE_I32: slot.i = ((const int32_t*)array->data)[index]; break;
+    case TYPE_U32: slot.u = ((const uint32_t*)array->data)[index]; break;
+    case TYPE_F32: slot.f = ((const float*)array->data)[index]; break;
+    default: memcpy(&slot, (const uint64_t*)array->data + index, sizeof(Slot)); break; //i64, u64, f64, string
+    }
+    return slot;
+}
+
+//Helper to write element 'index', the caller has checked the bounds
+static inline void arrayStoreUnchecked(ObjArray* array, const int64_t index, const Slot slot)
+{
+    switch (array->elementType)
+    {
+    case TYPE_BOOL: ((uint8_t*)array->data)[index] = slot.u != 0; break;
+    case TYPE_CHAR:
+    case TYPE_I8:
+    case TYPE_U8: ((uint8_t*)array->data)[index] = (uint8_t)slot.u; break;
+    case TYPE_I16:
+    case TYPE_U16: ((uint16_t*)array->data)[index] = (uint16_t)slot.u; break;
+    case TYPE_I32:
+    case TYPE_U32: ((uint32_t*)array->data)[index] = (uint32_t)slot.u; break;
+    case TYPE_F32: ((float*)array->data)[index] = (float)slot.f; break;
+    default: memcpy((uint64_t*)array->data + index, &slot, sizeof(Slot)); break;
+    }
+}
+
+//Function to read an element, false when 'index' is out of bounds
+static inline bool arrayLoad(const ObjArray* array, const int64_t index, Slot* slot)
+{
+    if (index < 0 || index >= array->count) return false;
+    *slot = arrayLoadUnchecked(array, index);
+    return true;
+}
+
+//Function to write an element, a dynamic array grows to take it.
+//False when 'index' is out of bounds of a fixed array
+static inline bool arrayStore(ObjArray* array, const int64_t index, const Slot slot)
+{
+    if (index < 0) return false;
+    if (index >= array->count)
+    {
+        if (!array->dynamic || index >= INT32_MAX) return false;
+        growArrayTo(array, (int)index + 1);
+    }
+    arrayStoreUnchecked(array, index, slot);
+    return true;
+}
+
+#endif //ARRAY_H
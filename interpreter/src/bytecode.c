@@ -0,0 +1,206 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "bytecode.h"
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//A switch gets a direct table when at least a quarter of its slots are real cases
+#define SWITCH_MIN_DENSITY 4
+//Largest direct table, bigger ranges are binary searched
+#define SWITCH_MAX_DENSE_RANGE 65536
+
+//Names of the opcodes, in enum order
+static const char* opcodeNames[OP_COUNT] =
+{
+#define OPCODE_NAME(name) #name,
+    FOR_EACH_OPCODE(OPCODE_NAME)
+#undef OPCODE_NAME
+};
+
+//Function to initialize an empty chunk
+void initChunk(Chunk* chunk)
+{
+    chunk->name = NULL;
+    chunk->code = NULL;
+    chunk->lines = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->constants = NULL;
+    chunk->constantCount = 0;
+    chunk->constantCapacity = 0;
+    chunk->registerCount = 0;
+    chunk->switches = NULL;
+    chunk->switchCount = 0;
+    chunk->switchCapacity = 0;
+    chunk->hotness = 0;
+    chunk->tierAttempted = false;
+    chunk->native = NULL;
+}
+
+//Function to release a chunk
+void freeChunk(Chunk* chunk)
+{
+    free(chunk->code);
+    free(chunk->lines);
+    free(chunk->constants);
+    for (int i = 0; i < chunk->switchCount; i++)
+    {
+        free(chunk->switches[i].keys);
+        free(chunk->switches[i].targets);
+    }
+    free(chunk->switches);
+    initChunk(chunk);
+}
+
+//Function to append an instruction, returns its index (used to patch jumps)
+int writeInstruction(Chunk* chunk, const Instruction instruction, const int line)
+{
+    if (chunk->count == chunk->capacity)
+    {
+        chunk->capacity = GROW_CAPACITY(chunk->capacity);
+        chunk->code = growArray(chunk->code, chunk->capacity, sizeof(Instruction));
+        chunk->lines = growArray(chunk->lines, chunk->capacity, sizeof(int));
+    }
+    chunk->code[chunk->count] = instruction;
+    chunk->lines[chunk->count] = line;
+    return chunk->count++;
+}
+
+//Function to add a constant, returns its index
+int addConstant(Chunk* chunk, const Slot value)
+{
+    if (chunk->constantCount == chunk->constantCapacity)
+    {
+        chunk->constantCapacity = GROW_CAPACITY(chunk->constantCapacity);
+        chunk->constants = growArray(chunk->constants, chunk->constantCapacity, sizeof(Slot));
+    }
+    chunk->constants[chunk->constantCount] = value;
+    return chunk->constantCount++;
+}
+
+//Function to point the jump at 'from' to 'to', false when the distance does not fit in sBx
+bool patchJump(Chunk* chunk, const int from, const int to)
+{
+    //Offsets are relative to the instruction after the jump, like the VM's pc
+    const int offset = to - (from + 1);
+    if (offset < SBX_MIN || offset > SBX_MAX) return false;
+    const Instruction jump = chunk->code[from];
+    chunk->code[from] = ENCODE_ASBX(INSTR_OP(jump), INSTR_A(jump), offset);
+    return true;
+}
+
+//Struct to hold one case while a switch table is built
+typedef struct
+{
+    int64_t key;
+    int target;
+    int order; //Position in the source, so the first of two equal keys wins
+} SwitchCase;
+
+//Helper to sort cases by key, then by source order
+static int compareCases(const void* a, const void* b)
+{
+    const SwitchCase* left = a;
+    const SwitchCase* right = b;
+    if (left->key != right->key) return left->key < right->key ? -1 : 1;
+    return left->order - right->order;
+}
+
+//Function to build the table of an OP_SWITCH from its cases, returns its index
+int addSwitchTable(Chunk* chunk, const int64_t* keys, const int* targets, const int count, const int defaultTarget)
+{
+    SwitchCase* cases = growArray(NULL, count > 0 ? count : 1, sizeof(SwitchCase));
+    for (int i = 0; i < count; i++)
+    {
+        cases[i].key = keys[i];
+        cases[i].target = targets[i];
+        cases[i].order = i;
+    }
+    qsort(cases, (size_t)count, sizeof(SwitchCase), compareCases);
+    int unique = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (unique == 0 || cases[unique - 1].key != cases[i].key) cases[unique++] = cases[i];
+    }
+
+    SwitchTable table;
+    table.defaultTarget = defaultTarget;
+    table.keys = NULL;
+    table.low = unique > 0 ? cases[0].key : 0;
+    //Distance from the lowest key to the highest, one less than the keys it covers so it cannot wrap
+    const uint64_t span = unique > 0 ? (uint64_t)cases[unique - 1].key - (uint64_t)table.low : 0;
+    table.dense = unique > 0 && span < SWITCH_MAX_DENSE_RANGE && span < (uint64_t)unique * SWITCH_MIN_DENSITY;
+    if (table.dense)
+    {
+        table.count = (int)span + 1;
+        table.targets = growArray(NULL, table.count, sizeof(int));
+        for (int i = 0; i < table.count; i++) table.targets[i] = defaultTarget;
+        for (int i = 0; i < unique; i++) table.targets[(uint64_t)cases[i].key - (uint64_t)table.low] = cases[i].target;
+    }
+    else
+    {
+        table.count = unique;
+        table.keys = growArray(NULL, unique > 0 ? unique : 1, sizeof(int64_t));
+        table.targets = growArray(NULL, unique > 0 ? unique : 1, sizeof(int));
+        for (int i = 0; i < unique; i++)
+        {
+            table.keys[i] = cases[i].key;
+            table.targets[i] = cases[i].target;
+        }
+    }
+    free(cases);
+
+    if (chunk->switchCount == chunk->switchCapacity)
+    {
+        chunk->switchCapacity = GROW_CAPACITY(chunk->switchCapacity);
+        chunk->switches = growArray(chunk->switches, chunk->switchCapacity, sizeof(SwitchTable));
+    }
+    chunk->switches[chunk->switchCount] = table;
+    return chunk->switchCount++;
+}
+
+//Function to print a chunk in readable form
+void disassembleChunk(const Chunk* chunk, const char* name)
+{
+    printf("== %s (%d registers, %d constants) ==\n", name, chunk->registerCount, chunk->constantCount);
+    for (int i = 0; i < chunk->count; i++)
+    {
+        const Instruction instruction = chunk->code[i];
+        const OpCode op = (OpCode)INSTR_OP(instruction);
+        printf("%04d %4d %-18s", i, chunk->lines[i], op < OP_COUNT ? opcodeNames[op] : "<invalid>");
+        switch (op)
+        {
+        case OP_LOAD_CONST:
+            printf("r%u k%u\n", INSTR_A(instruction), INSTR_BX(instruction));
+            break;
+        case OP_LOAD_INT:
+            printf("r%u %d\n", INSTR_A(instruction), INSTR_SBX(instruction));
+            break;
+        case OP_JUMP:
+            printf("-> %04d\n", i + 1 + INSTR_SBX(instruction));
+            break;
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+        case OP_FOR_PREP:
+        case OP_FOR_LOOP:
+        case OP_FOR_IN:
+            printf("r%u -> %04d\n", INSTR_A(instruction), i + 1 + INSTR_SBX(instruction));
+            break;
+        case OP_SWITCH:
+        {
+            const SwitchTable* table = &chunk->switches[INSTR_BX(instruction)];
+            printf("r%u s%u (%s, %d entries, default -> %04d)\n", INSTR_A(instruction), INSTR_BX(instruction),
+                   table->dense ? "dense" : "sparse", table->count, table->defaultTarget);
+            break;
+        }
+        case OP_ADDI_INT:
+            printf("r%u r%u %d\n", INSTR_A(instruction), INSTR_B(instruction), (int8_t)INSTR_C(instruction));
+            break;
+        default:
+            printf("r%u r%u r%u\n", INSTR_A(instruction), INSTR_B(instruction), INSTR_C(instruction));
+            break;
+        }
+    }
+}
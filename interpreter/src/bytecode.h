@@ -0,0 +1,221 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Instructions are 32-bit words: the opcode in the low byte, then either three
+//8-bit register operands (A, B, C) or A plus a 16-bit operand (Bx / sBx).
+//Lyka is statically typed, so every arithmetic opcode already knows whether it
+//works on integers or floats and registers need no type tag.
+typedef uint32_t Instruction;
+
+#define INSTR_OP(instruction)  ((instruction) & 0xFF)
+#define INSTR_A(instruction)   (((instruction) >> 8) & 0xFF)
+#define INSTR_B(instruction)   (((instruction) >> 16) & 0xFF)
+#define INSTR_C(instruction)   (((instruction) >> 24) & 0xFF)
+#define INSTR_BX(instruction)  ((instruction) >> 16)
+#define INSTR_SBX(instruction) ((int32_t)INSTR_BX(instruction) - SBX_BIAS)
+#define SBX_BIAS 0x7FFF
+//Range of the signed 16-bit operand
+#define SBX_MIN (-SBX_BIAS)
+#define SBX_MAX (0xFFFF - SBX_BIAS)
+
+#define ENCODE_ABC(op, a, b, c) \
+    ((Instruction)(op) | (Instruction)(a) << 8 | (Instruction)(b) << 16 | (Instruction)(c) << 24)
+#define ENCODE_ABX(op, a, bx) ((Instruction)(op) | (Instruction)(a) << 8 | (Instruction)(bx) << 16)
+#define ENCODE_ASBX(op, a, sbx) ENCODE_ABX(op, a, (uint32_t)((sbx) + SBX_BIAS))
+
+//Every opcode with what it does, kept as one list so the dispatch table and the disassembler never drift
+#define FOR_EACH_OPCODE(X) \
+    X(OP_MOVE)          /* R[A] = R[B]                          */ \
+    X(OP_LOAD_CONST)    /* R[A] = K[Bx]                         */ \
+    X(OP_LOAD_INT)      /* R[A] = sBx                           */ \
+    X(OP_ADD_INT)       /* R[A] = R[B] + R[C]                   */ \
+    X(OP_SUB_INT)       /* R[A] = R[B] - R[C]                   */ \
+    X(OP_MUL_INT)       /* R[A] = R[B] * R[C]                   */ \
+    X(OP_DIV_INT)       /* R[A] = R[B] / R[C], signed           */ \
+    X(OP_MOD_INT)       /* R[A] = R[B] % R[C], signed           */ \
+    X(OP_DIV_UINT)      /* R[A] = R[B] / R[C], unsigned         */ \
+    X(OP_MOD_UINT)      /* R[A] = R[B] % R[C], unsigned         */ \
+    X(OP_ADDI_INT)      /* R[A] = R[B] + (int8)C                */ \
+    X(OP_NEG_INT)       /* R[A] = -R[B]                         */ \
+    X(OP_BIT_AND)       /* R[A] = R[B] & R[C]                   */ \
+    X(OP_BIT_OR)        /* R[A] = R[B] | R[C]                   */ \
+    X(OP_BIT_XOR)       /* R[A] = R[B] ^ R[C]                   */ \
+    X(OP_BIT_NOT)       /* R[A] = ~R[B]                         */ \
+    X(OP_SHL)           /* R[A] = R[B] << R[C]                  */ \
+    X(OP_SHR)           /* R[A] = R[B] >> R[C], arithmetic      */ \
+    X(OP_SHR_UINT)      /* R[A] = R[B] >> R[C], logical         */ \
+    X(OP_ADD_FLOAT)     /* R[A] = R[B] + R[C]                   */ \
+    X(OP_SUB_FLOAT)     /* R[A] = R[B] - R[C]                   */ \
+    X(OP_MUL_FLOAT)     /* R[A] = R[B] * R[C]                   */ \
+    X(OP_DIV_FLOAT)     /* R[A] = R[B] / R[C]                   */ \
+    X(OP_NEG_FLOAT)     /* R[A] = -R[B]                         */ \
+    X(OP_INT_TO_FLOAT)  /* R[A] = (double)R[B]                  */ \
+    X(OP_FLOAT_TO_INT)  /* R[A] = (int64)R[B], saturating       */ \
+    X(OP_WRAP)          /* R[A] = R[B] narrowed to TypeKind C   */ \
+    X(OP_EQ_INT)        /* R[A] = R[B] == R[C]                  */ \
+    X(OP_NE_INT)        /* R[A] = R[B] != R[C]                  */ \
+    X(OP_LT_INT)        /* R[A] = R[B] < R[C], signed           */ \
+    X(OP_LE_INT)        /* R[A] = R[B] <= R[C], signed          */ \
+    X(OP_LT_UINT)       /* R[A] = R[B] < R[C], unsigned         */ \
+    X(OP_LE_UINT)       /* R[A] = R[B] <= R[C], unsigned        */ \
+    X(OP_EQ_FLOAT)      /* R[A] = R[B] == R[C]                  */ \
+    X(OP_LT_FLOAT)      /* R[A] = R[B] < R[C]                   */ \
+    X(OP_LE_FLOAT)      /* R[A] = R[B] <= R[C]                  */ \
+    X(OP_NOT)           /* R[A] = !R[B]                         */ \
+    X(OP_GET_ELEMENT)   /* R[A] = array R[B] [R[C]]             */ \
+    X(OP_SET_ELEMENT)   /* array R[A] [R[B]] = R[C]             */ \
+    X(OP_ARRAY_LENGTH)  /* R[A] = length of array R[B]          */ \
+    X(OP_JUMP)          /* pc += sBx                            */ \
+    X(OP_JUMP_IF_FALSE) /* if (!R[A]) pc += sBx                 */ \
+    X(OP_JUMP_IF_TRUE)  /* if (R[A]) pc += sBx                  */ \
+    X(OP_FOR_PREP)      /* if (R[A] >= R[A+1]) pc += sBx        */ \
+    X(OP_FOR_LOOP)      /* R[A] += R[A+2]                       */ \
+                        /* if (R[A] < R[A+1]) pc += sBx         */ \
+    X(OP_FOR_IN)        /* if (R[A+1] < length of array R[A])   */ \
+                        /* R[A+2] = R[A][R[A+1]++]; pc += sBx   */ \
+    X(OP_SWITCH)        /* pc = target of R[A] in switch Bx     */ \
+    X(OP_RETURN)        /* return R[A]                          */ \
+    X(OP_HALT)          /* stop, result 0                       */
+
+//Counted loops (see loops.h) keep their variable, limit and step in three
+//consecutive registers and compare them as signed integers ('i <= n' is
+//loaded with a limit of n + 1):
+//    FOR_PREP  A exit     skips a loop that runs zero times
+//  body:
+//    ...                  'continue' jumps to the FOR_LOOP
+//    FOR_LOOP  A body     steps and jumps back while below the limit
+//  exit:
+//A 'for-in' over an array keeps the array, the index and the element there:
+//    LOAD_INT  A+1 0
+//    JUMP      test
+//  body:
+//    ...                  'continue' jumps to the FOR_IN
+//  test:
+//    FOR_IN    A body     the index is within the length, so the load is not checked
+
+//Enum to hold all the opcodes
+typedef enum
+{
+#define OPCODE_ENUM(name) name,
+    FOR_EACH_OPCODE(OPCODE_ENUM)
+#undef OPCODE_ENUM
+    OP_COUNT
+} OpCode;
+
+//Struct to hold one register or constant, the instruction decides how it is read
+typedef union
+{
+    int64_t i;
+    uint64_t u;
+    double f;
+} Slot;
+
+//Struct to hold the jump table of a 'match' on an integer.
+//Dense case sets index 'targets' directly by 'key - low', sparse ones
+//binary search the sorted 'keys'. Targets are instruction indices
+typedef struct
+{
+    bool dense;
+    int64_t low;         //Smallest key (dense tables)
+    int64_t* keys;       //Sorted keys (sparse tables)
+    int* targets;        //One per key, or one per value in [low, low + count) when dense
+    int count;
+    int defaultTarget;   //Arm '(_)', or the end of the match
+} SwitchTable;
+
+//Native code of a chunk, produced by the JIT tier. It starts at instruction
+//'entry' (0 or the target of a backward jump) with the registers as the
+//interpreter left them, and returns 0 or the index + 1 of the instruction
+//that raised a runtime error
+typedef int (*NativeChunk)(Slot* registers, Slot* result, int entry);
+
+//Struct to hold a compiled unit of bytecode
+typedef struct
+{
+    const char* name;   //Function the chunk was compiled from, NULL for the top level (not owned)
+    Instruction* code;
+    int* lines;         //Source line of every instruction, for runtime errors and the profiler
+    int count;
+    int capacity;
+    Slot* constants;
+    int constantCount;
+    int constantCapacity;
+    int registerCount;  //Registers a frame of this chunk needs
+    SwitchTable* switches;
+    int switchCount;
+    int switchCapacity;
+    //Tiering state, see vm.h
+    uint32_t hotness;     //Times the chunk was entered
+    bool tierAttempted;   //The JIT tier has been asked for native code once
+    NativeChunk native;   //Native code, NULL while interpreted
+} Chunk;
+
+//Helper to check whether an opcode may add its sBx to pc
+static inline bool isJumpOpcode(const OpCode op)
+{
+    switch (op)
+    {
+    case OP_JUMP:
+    case OP_JUMP_IF_FALSE:
+    case OP_JUMP_IF_TRUE:
+    case OP_FOR_PREP:
+    case OP_FOR_LOOP:
+    case OP_FOR_IN:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//Function to initialize an empty chunk
+void initChunk(Chunk* chunk);
+//Function to release a chunk
+void freeChunk(Chunk* chunk);
+//Function to append an instruction, returns its index (used to patch jumps)
+int writeInstruction(Chunk* chunk, Instruction instruction, int line);
+//Function to add a constant, returns its index
+int addConstant(Chunk* chunk, Slot value);
+//Function to point the jump at 'from' to 'to'. Returns false, leaving the jump as it was,
+//when the distance does not fit in sBx; the caller reports it like Lox's "Too much code to jump over."
+bool patchJump(Chunk* chunk, int from, int to);
+//Function to build the table of an OP_SWITCH from its cases, returns its index.
+//Duplicate keys keep their first target
+int addSwitchTable(Chunk* chunk, const int64_t* keys, const int* targets, int count, int defaultTarget);
+//Helper to find the target of 'key' in a switch table
+static inline int switchTarget(const SwitchTable* table, const int64_t key)
+{
+    if (table->dense)
+    {
+        //One unsigned compare covers both ends of the range
+        const uint64_t index = (uint64_t)key - (uint64_t)table->low;
+        return index < (uint64_t)table->count ? table->targets[index] : table->defaultTarget;
+    }
+    int low = 0;
+    int high = table->count - 1;
+    while (low <= high)
+    {
+        const int middle = low + (high - low) / 2;
+        if (table->keys[middle] == key) return table->targets[middle];
+        if (table->keys[middle] < key) low = middle + 1;
+        else high = middle - 1;
+    }
+    return table->defaultTarget;
+}
+//Function to print a chunk in readable form
+void disassembleChunk(const Chunk* chunk, const char* name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //BYTECODE_H
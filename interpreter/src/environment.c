@@ -0,0 +1,429 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "environment.h"
+#include "common.h"
+#include "lexer.h"
+#include <stdio.h>
+#include <string.h>
+
+//-------------------------------------------------
+//Resolver
+//-------------------------------------------------
+
+//Most slots a single frame can have, locations store them in 16 bits
+#define MAX_FRAME_SLOTS 0xFFFF
+
+//Struct to hold a name that is currently in scope
+typedef struct
+{
+    uint32_t token;      //Name token of the declaration
+    NodeId declaration;
+    uint16_t slot;
+    int function;        //Index of the function the name belongs to
+    int scopeDepth;      //Block nesting the name was declared at
+} ScopedName;
+
+//Struct to hold the function (or script) whose frame slots are being handed out
+typedef struct
+{
+    NodeId node;
+    int slotCount;       //Slots in use right now
+    int maxSlots;        //Slots the frame needs, blocks reuse the slots of finished ones
+} FunctionState;
+
+//Struct to hold the state of one resolver run
+typedef struct
+{
+    const Ast* ast;
+    Resolution* resolution;
+    ScopedName* names;
+    int nameCount;
+    int nameCapacity;
+    FunctionState* functions;
+    int functionCount;
+    int functionCapacity;
+    int scopeDepth;
+} Resolver;
+
+static void resolveNode(Resolver* resolver, NodeId node);
+
+//Helper to read the text of a token
+static const char* tokenText(const Resolver* resolver, const uint32_t token, int* length)
+{
+    const TokenBuffer* tokens = resolver->ast->tokens;
+    *length = (int)tokens->lengths[token];
+    return tokens->source + tokens->offsets[token];
+}
+
+//Helper to compare the names of two tokens, interned ids make this a single compare
+static bool sameName(const Resolver* resolver, const uint32_t a, const uint32_t b)
+{
+    const TokenBuffer* tokens = resolver->ast->tokens;
+    if (tokens->interns != NULL) return tokens->symbols[a] == tokens->symbols[b];
+    int lengthA, lengthB;
+    const char* textA = tokenText(resolver, a, &lengthA);
+    const char* textB = tokenText(resolver, b, &lengthB);
+    return lengthA == lengthB && memcmp(textA, textB, (size_t)lengthA) == 0;
+}
+
+//Helper to report an error at a token
+static void resolveError(Resolver* resolver, const uint32_t token, const char* message)
+{
+    int length;
+    const char* text = tokenText(resolver, token, &length);
+    //The line table is built lazily, looking it up does not change the tokens
+    const int line = tokenLine((TokenBuffer*)resolver->ast->tokens, (int)token);
+    fprintf(stderr, "[line %d] Error at '%.*s': %s\n", line, length, text, message);
+    resolver->resolution->errorCount++;
+}
+
+//Helpers to open and close a block scope, closing one frees its slots for the next block
+static int beginScope(Resolver* resolver)
+{
+    resolver->scopeDepth++;
+    return resolver->functions[resolver->functionCount - 1].slotCount;
+}
+static void endScope(Resolver* resolver, const int savedSlots)
+{
+    resolver->scopeDepth--;
+    while (resolver->nameCount > 0 && resolver->names[resolver->nameCount - 1].scopeDepth > resolver->scopeDepth)
+    {
+        resolver->nameCount--;
+    }
+    resolver->functions[resolver->functionCount - 1].slotCount = savedSlots;
+}
+
+//Helpers to enter and leave the frame of a function
+static void beginFunction(Resolver* resolver, const NodeId node)
+{
+    if (resolver->functionCount == resolver->functionCapacity)
+    {
+        resolver->functionCapacity = GROW_CAPACITY(resolver->functionCapacity);
+        resolver->functions = growArray(resolver->functions, resolver->functionCapacity, sizeof(FunctionState));
+    }
+    FunctionState* function = &resolver->functions[resolver->functionCount++];
+    function->node = node;
+    function->slotCount = 0;
+    function->maxSlots = 0;
+    resolver->scopeDepth++;
+}
+static void endFunction(Resolver* resolver)
+{
+    const FunctionState* function = &resolver->functions[resolver->functionCount - 1];
+    resolver->resolution->frameSizes[function->node] = (uint16_t)function->maxSlots;
+    endScope(resolver, 0);
+    resolver->functionCount--;
+}
+
+//Function to declare the name of 'node' in the innermost scope and give it a slot
+static void declareName(Resolver* resolver, const NodeId node)
+{
+    const uint32_t token = nodeToken(resolver->ast, node);
+    for (int i = resolver->nameCount - 1; i >= 0 && resolver->names[i].scopeDepth == resolver->scopeDepth; i--)
+    {
+        if (sameName(resolver, resolver->names[i].token, token))
+        {
+            resolveError(resolver, token, "Already a variable with this name in this scope.");
+            break;
+        }
+    }
+    FunctionState* function = &resolver->functions[resolver->functionCount - 1];
+    if (function->slotCount == MAX_FRAME_SLOTS)
+    {
+        resolveError(resolver, token, "Too many variables in one function.");
+        return;
+    }
+    if (resolver->nameCount == resolver->nameCapacity)
+    {
+        resolver->nameCapacity = GROW_CAPACITY(resolver->nameCapacity);
+        resolver->names = growArray(resolver->names, resolver->nameCapacity, sizeof(ScopedName));
+    }
+    ScopedName* name = &resolver->names[resolver->nameCount++];
+    name->token = token;
+    name->declaration = node;
+    name->slot = (uint16_t)function->slotCount++;
+    name->function = resolver->functionCount - 1;
+    name->scopeDepth = resolver->scopeDepth;
+    if (function->slotCount > function->maxSlots) function->maxSlots = function->slotCount;
+
+    const VarLocation location = {0, name->slot};
+    resolver->resolution->locations[node] = location;
+    resolver->resolution->declarations[node] = node;
+}
+
+//Function to resolve a use of a name, innermost declaration first
+static void resolveIdentifier(Resolver* resolver, const NodeId node)
+{
+    const uint32_t token = nodeToken(resolver->ast, node);
+    for (int i = resolver->nameCount - 1; i >= 0; i--)
+    {
+        const ScopedName* name = &resolver->names[i];
+        if (sameName(resolver, name->token, token))
+        {
+            const VarLocation location = {(uint16_t)(resolver->functionCount - 1 - name->function), name->slot};
+            resolver->resolution->locations[node] = location;
+            resolver->resolution->declarations[node] = name->declaration;
+            return;
+        }
+    }
+    int length;
+    const char* text = tokenText(resolver, token, &length);
+    if (length == 5 && memcmp(text, "print", 5) == 0)
+    {
+        const VarLocation location = {LOCATION_BUILTIN, BUILTIN_PRINT};
+        resolver->resolution->locations[node] = location;
+        return;
+    }
+    resolveError(resolver, token, "Undefined variable.");
+}
+
+//Function to check that an assignment target is a 'mut' binding ('a = ..' or 'a[i] = ..')
+static void checkAssignable(Resolver* resolver, NodeId target)
+{
+    while (nodeKind(resolver->ast, target) == NODE_INDEX)
+    {
+        target = nodeData(resolver->ast, target).lhs;
+    }
+    if (nodeKind(resolver->ast, target) != NODE_IDENTIFIER) return;
+    const NodeId declaration = resolver->resolution->declarations[target];
+    if (declaration == NODE_NONE) return; //Undefined, already reported
+    const NodeKind kind = nodeKind(resolver->ast, declaration);
+    if (kind == NODE_FN_DECL || !(nodeFlags(resolver->ast, declaration) & NODE_FLAG_MUT))
+    {
+        resolveError(resolver, nodeToken(resolver->ast, target), "Cannot assign to an immutable variable.");
+    }
+}
+
+//Helper to resolve the nodes of an extra range
+static void resolveRange(Resolver* resolver, const uint32_t start, const uint32_t end)
+{
+    for (uint32_t i = start; i < end; i++)
+    {
+        resolveNode(resolver, extraWord(resolver->ast, i));
+    }
+}
+
+//Function to resolve the parameters and body of a function in a frame of its own
+static void resolveFunction(Resolver* resolver, const NodeId node)
+{
+    const NodeData data = nodeData(resolver->ast, node);
+    beginFunction(resolver, node);
+    const uint32_t paramsStart = extraWord(resolver->ast, data.lhs);
+    const uint32_t paramsEnd = extraWord(resolver->ast, data.lhs + 1);
+    for (uint32_t i = paramsStart; i < paramsEnd; i++)
+    {
+        declareName(resolver, extraWord(resolver->ast, i));
+    }
+    //The body block shares the scope of the parameters
+    const NodeData body = nodeData(resolver->ast, data.rhs);
+    resolveRange(resolver, body.lhs, body.rhs);
+    endFunction(resolver);
+}
+
+//Function to resolve one node and everything below it
+static void resolveNode(Resolver* resolver, const NodeId node)
+{
+    if (node == NODE_NONE) return;
+    const Ast* ast = resolver->ast;
+    const NodeData data = nodeData(ast, node);
+    switch (nodeKind(ast, node))
+    {
+    case NODE_IDENTIFIER:
+        resolveIdentifier(resolver, node);
+        break;
+    case NODE_UNARY:
+    case NODE_CAST:
+    case NODE_EXPR_STMT:
+    case NODE_RETURN:
+        resolveNode(resolver, data.lhs);
+        break;
+    case NODE_BINARY:
+    case NODE_INDEX:
+    case NODE_WHILE:
+    case NODE_DO_WHILE:
+        resolveNode(resolver, data.lhs);
+        resolveNode(resolver, data.rhs);
+        break;
+    case NODE_ASSIGN:
+        resolveNode(resolver, data.rhs);
+        resolveNode(resolver, data.lhs);
+        checkAssignable(resolver, data.lhs);
+        break;
+    case NODE_TERNARY:
+    case NODE_IF:
+        resolveNode(resolver, data.lhs);
+        resolveNode(resolver, extraWord(ast, data.rhs));
+        resolveNode(resolver, extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_CALL:
+    case NODE_MATCH:
+        resolveNode(resolver, data.lhs);
+        resolveRange(resolver, extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_ARRAY_LITERAL:
+        resolveRange(resolver, data.lhs, data.rhs);
+        break;
+    case NODE_MATCH_ARM:
+        resolveNode(resolver, data.lhs);
+        resolveNode(resolver, data.rhs);
+        break;
+    case NODE_VAR_DECL:
+        //The initializer cannot see the variable it initializes
+        resolveNode(resolver, data.lhs);
+        resolveNode(resolver, data.rhs);
+        declareName(resolver, node);
+        break;
+    case NODE_BLOCK:
+    {
+        const int saved = beginScope(resolver);
+        resolveRange(resolver, data.lhs, data.rhs);
+        endScope(resolver, saved);
+        break;
+    }
+    case NODE_FOR:
+    {
+        const int saved = beginScope(resolver);
+        resolveNode(resolver, extraWord(ast, data.lhs));
+        resolveNode(resolver, extraWord(ast, data.lhs + 1));
+        resolveNode(resolver, extraWord(ast, data.lhs + 2));
+        resolveNode(resolver, data.rhs);
+        endScope(resolver, saved);
+        break;
+    }
+    case NODE_FOR_IN:
+    {
+        resolveNode(resolver, data.lhs);
+        const int saved = beginScope(resolver);
+        declareName(resolver, node);
+        resolveNode(resolver, data.rhs);
+        endScope(resolver, saved);
+        break;
+    }
+    case NODE_LOOP:
+        resolveNode(resolver, data.lhs);
+        break;
+    case NODE_FN_DECL:
+        //A nested function can call itself
+        declareName(resolver, node);
+        resolveFunction(resolver, node);
+        break;
+    default:
+        //Literals, break, continue
+        break;
+    }
+}
+
+//Function to resolve the whole program in the script frame
+static void resolveProgram(Resolver* resolver, const NodeId program)
+{
+    const Ast* ast = resolver->ast;
+    const NodeData data = nodeData(ast, program);
+    beginFunction(resolver, program);
+    //Top-level functions are visible everywhere, so they are declared first
+    for (uint32_t i = data.lhs; i < data.rhs; i++)
+    {
+        const NodeId node = extraWord(ast, i);
+        if (nodeKind(ast, node) == NODE_FN_DECL) declareName(resolver, node);
+    }
+    for (uint32_t i = data.lhs; i < data.rhs; i++)
+    {
+        const NodeId node = extraWord(ast, i);
+        if (nodeKind(ast, node) != NODE_FN_DECL) resolveNode(resolver, node);
+    }
+    //Bodies go last so they see every global, the script frame is zeroed before it runs
+    for (uint32_t i = data.lhs; i < data.rhs; i++)
+    {
+        const NodeId node = extraWord(ast, i);
+        if (nodeKind(ast, node) == NODE_FN_DECL) resolveFunction(resolver, node);
+    }
+    endFunction(resolver);
+}
+
+//Function to resolve every name of a parsed tree, errors are printed to stderr
+bool resolveAst(const Ast* ast, Resolution* resolution)
+{
+    const size_t count = (size_t)ast->count;
+    resolution->nodeCount = ast->count;
+    resolution->errorCount = 0;
+    resolution->locations = malloc(count * sizeof(VarLocation));
+    resolution->declarations = calloc(count, sizeof(NodeId));
+    resolution->frameSizes = calloc(count, sizeof(uint16_t));
+    if (resolution->locations == NULL || resolution->declarations == NULL || resolution->frameSizes == NULL)
+    {
+        fprintf(stderr, "Not enough memory to resolve %d nodes\n", ast->count);
+        exit(74);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        resolution->locations[i].depth = LOCATION_UNRESOLVED;
+        resolution->locations[i].slot = 0;
+    }
+
+    Resolver resolver;
+    memset(&resolver, 0, sizeof(Resolver));
+    resolver.ast = ast;
+    resolver.resolution = resolution;
+    if (ast->root != NODE_NONE) resolveProgram(&resolver, ast->root);
+    free(resolver.names);
+    free(resolver.functions);
+    return resolution->errorCount == 0;
+}
+
+//Function to release a resolution
+void freeResolution(Resolution* resolution)
+{
+    free(resolution->locations);
+    free(resolution->declarations);
+    free(resolution->frameSizes);
+    memset(resolution, 0, sizeof(Resolution));
+}
+
+//-------------------------------------------------
+//Runtime frames
+//-------------------------------------------------
+
+//Function to initialize an empty environment
+void initEnvironment(Environment* environment)
+{
+    memset(environment, 0, sizeof(Environment));
+}
+
+//Function to release an environment
+void freeEnvironment(Environment* environment)
+{
+    free(environment->stack);
+    free(environment->frames);
+    memset(environment, 0, sizeof(Environment));
+}
+
+//Function to push a zeroed frame of 'size' slots, 'enclosing' is the frame it was declared in
+void pushFrame(Environment* environment, const int size, const int enclosing)
+{
+    if (environment->stackTop + size > environment->stackCapacity)
+    {
+        int capacity = environment->stackCapacity;
+        while (capacity < environment->stackTop + size)
+        {
+            capacity = GROW_CAPACITY(capacity);
+        }
+        environment->stack = growArray(environment->stack, capacity, sizeof(Slot));
+        environment->stackCapacity = capacity;
+    }
+    if (environment->frameCount == environment->frameCapacity)
+    {
+        environment->frameCapacity = GROW_CAPACITY(environment->frameCapacity);
+        environment->frames = growArray(environment->frames, environment->frameCapacity, sizeof(Frame));
+    }
+    Frame* frame = &environment->frames[environment->frameCount++];
+    frame->base = environment->stackTop;
+    frame->enclosing = enclosing;
+    memset(environment->stack + frame->base, 0, (size_t)size * sizeof(Slot));
+    environment->stackTop += size;
+}
+
+//Function to pop the innermost frame
+void popFrame(Environment* environment)
+{
+    environment->stackTop = environment->frames[--environment->frameCount].base;
+}
@@ -0,0 +1,91 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef ENVIRONMENT_H
+#define ENVIRONMENT_H
+
+#include "ast.h"
+#include "bytecode.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//Variables are resolved once, right after parsing. Every declaration and every
+//use of a name gets a (depth, slot) location: 'depth' counts the function
+//frames between the use and the declaration (0 = the current frame, a global
+//read from inside a function is depth 1) and 'slot' is its index inside that
+//frame. At runtime a frame is a flat array of Slots, so a variable access is
+//one indexed load and names are only looked at again to print diagnostics.
+
+//Struct to hold where a variable lives
+typedef struct
+{
+    uint16_t depth;
+    uint16_t slot;
+} VarLocation;
+
+//Depth of names that are not variables
+#define LOCATION_UNRESOLVED 0xFFFF //Undeclared, an error was reported
+#define LOCATION_BUILTIN    0xFFFE //Built-in function such as print, 'slot' is its BuiltinId
+
+//Enum to hold the built-in functions
+typedef enum
+{
+    BUILTIN_PRINT
+} BuiltinId;
+
+//Struct to hold the result of resolving a tree
+typedef struct
+{
+    VarLocation* locations; //Indexed by NodeId, set for identifiers and declarations
+    NodeId* declarations;   //Indexed by NodeId, the declaration an identifier refers to
+    uint16_t* frameSizes;   //Indexed by NodeId, slots needed by a NODE_FN_DECL or NODE_PROGRAM frame
+    int nodeCount;
+    int errorCount;
+} Resolution;
+
+//Function to resolve every name of a parsed tree, errors are printed to stderr.
+//Returns false when any name could not be resolved
+bool resolveAst(const Ast* ast, Resolution* resolution);
+//Function to release a resolution
+void freeResolution(Resolution* resolution);
+
+//Struct to hold one runtime frame
+typedef struct
+{
+    int base;      //First slot of the frame in the environment stack
+    int enclosing; //Index of the lexically enclosing frame, -1 for the script
+} Frame;
+
+//Struct to hold the frames of a running program, all slots live in one stack
+typedef struct
+{
+    Slot* stack;
+    int stackTop;
+    int stackCapacity;
+    Frame* frames;
+    int frameCount;
+    int frameCapacity;
+} Environment;
+
+//Function to initialize an empty environment
+void initEnvironment(Environment* environment);
+//Function to release an environment
+void freeEnvironment(Environment* environment);
+//Function to push a zeroed frame of 'size' slots, 'enclosing' is the frame it was declared in
+void pushFrame(Environment* environment, int size, int enclosing);
+//Function to pop the innermost frame
+void popFrame(Environment* environment);
+
+//Helper to get the slot of a location, depth 0 is a single indexed load.
+//The pointer is only valid until the next pushFrame, which may move the stack
+static inline Slot* locationSlot(const Environment* environment, const VarLocation location)
+{
+    int frame = environment->frameCount - 1;
+    for (int depth = location.depth; depth > 0; depth--)
+    {
+        frame = environment->frames[frame].enclosing;
+    }
+    return &environment->stack[environment->frames[frame].base + location.slot];
+}
+
+#endif //ENVIRONMENT_H
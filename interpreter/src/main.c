@@ -0,0 +1,134 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "lexer.h"
+#include "precompiled.h"
+#include "profile.h"
+#include "serve.h"
+#include "stats.h"
+#include "vm.h"
+#ifdef LYKA_TIERING
+#include "tier.hpp"
+#endif
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(const int argc , char *argv[])
+{
+#ifdef LYKA_TIERING
+    setTierUpHook(compileChunkNative);
+#endif
+    //'--time-report', '--stats[=text|json]', '--profile[=<file>]', '--compile' and the '--serve' options
+    //may appear anywhere, everything else is the script
+    StatsFormat statsFormat = STATS_OFF;
+    bool profile = false;
+    bool compile = false;
+    bool serve = false;
+    ServeOptions serveOptions = {0, NULL, (size_t)SERVE_DEFAULT_CACHE_MB * 1024 * 1024};
+    const char* foldedPath = NULL;
+    const char* path = NULL;
+    int pathCount = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (parseStatsFlag(argv[i], &statsFormat)) continue;
+        if (strcmp(argv[i], "--compile") == 0)
+        {
+            compile = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--serve") == 0 || strncmp(argv[i], "--serve=", 8) == 0)
+        {
+            serve = true;
+            if (argv[i][7] == '=') serveOptions.socketPath = argv[i] + 8;
+            continue;
+        }
+        if (strncmp(argv[i], "--jobs=", 7) == 0)
+        {
+            char* end;
+            const unsigned long count = strtoul(argv[i] + 7, &end, 10);
+            if (*end != '\0' || count == 0 || count > 4096)
+            {
+                fprintf(stderr, "%s: error: invalid job count in '%s'\n", argv[0], argv[i]);
+                return 64;
+            }
+            serveOptions.jobs = (int)count;
+            continue;
+        }
+        if (strncmp(argv[i], "--cache-size=", 13) == 0)
+        {
+            //0 turns the cache off, a size that does not fit in bytes is refused rather than wrapped
+            const char* digits = argv[i] + 13;
+            char* end;
+            const unsigned long long megabytes = strtoull(digits, &end, 10);
+            if (end == digits || *end != '\0' || digits[0] == '-' || megabytes > SIZE_MAX / (1024 * 1024))
+            {
+                fprintf(stderr, "%s: error: invalid cache size in '%s'\n", argv[0], argv[i]);
+                return 64;
+            }
+            serveOptions.cacheBytes = (size_t)megabytes * 1024 * 1024;
+            continue;
+        }
+        if (strcmp(argv[i], "--profile") == 0 || strncmp(argv[i], "--profile=", 10) == 0)
+        {
+            profile = true;
+            if (argv[i][9] == '=') foldedPath = argv[i] + 10;
+            continue;
+        }
+        path = argv[i];
+        pathCount++;
+    }
+
+    if (serve)
+    {
+        //Scripts come from the input, and a profile describes one run where a server runs many at once
+        if (pathCount == 0 && !profile) return serveScripts(&serveOptions);
+        printf("--serve reads its scripts from its input and cannot be profiled.\n");
+        printf("Program terminated.\n");
+    }
+    else if (pathCount == 0)
+    {
+        printf("No input file provided.\n");
+        printf("Usage: %s [--time-report|--stats=json] [--profile[=<folded file>]] <file.lk|file.lkc>\n" , argv[0]);
+        printf("       %s --compile <file.lk>   (writes file.lkc)\n" , argv[0]);
+        printf("       %s --serve[=<socket>] [--jobs=<n>] [--cache-size=<MB>]   (paths or '@<bytes>' sources, one per line)\n" , argv[0]);
+        printf("Program terminated.\n");
+    }
+    else if (pathCount == 1 && compile)
+    {
+        //Lex errors are reported like lykac does, with its exit code
+        return precompileFile(path) ? 0 : 65;
+    }
+    else if (pathCount == 1)
+    {
+        Stats stats;
+        initStats(&stats);
+        if (profile) startProfile();
+        runFile(path, statsFormat != STATS_OFF ? &stats : NULL);
+        if (statsFormat != STATS_OFF) printStats(stderr, &stats, statsFormat, NULL, 0);
+        if (profile)
+        {
+            printProfile(stderr);
+            //Folded stacks feed straight into flamegraph.pl or speedscope
+            FILE* folded = foldedPath != NULL ? fopen(foldedPath, "w") : NULL;
+            if (folded != NULL)
+            {
+                writeFoldedStacks(folded);
+                fclose(folded);
+            }
+            else if (foldedPath != NULL) fprintf(stderr, "Could not write profile \"%s\".\n", foldedPath);
+            stopProfile();
+        }
+    }
+    else
+    {
+        printf("Too many arguments.\n");
+        printf("Usage: %s [--time-report|--stats=json] [--profile[=<folded file>]] <file.lk|file.lkc>\n" , argv[0]);
+        printf("       %s --compile <file.lk>   (writes file.lkc)\n" , argv[0]);
+        printf("       %s --serve[=<socket>] [--jobs=<n>] [--cache-size=<MB>]   (paths or '@<bytes>' sources, one per line)\n" , argv[0]);
+        printf("Program terminated.\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "print.h"
+#include "value.h"
+#include <math.h>
+#include <string.h>
+
+//Default digits after the point, as with "%f"
+#define DEFAULT_PRECISION 6
+//Largest precision the integer fast path of writeFloat handles
+#define FAST_PRECISION 9
+//Enough for "%.17f" of the largest double
+#define FLOAT_BUFFER_SIZE 400
+
+//Every two-digit number, so integers are written two digits per division
+static const char digitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//Powers of ten up to FAST_PRECISION
+static const uint64_t powersOfTen[FAST_PRECISION + 1] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+//Function to initialize an empty buffer writing to 'file'
+void initOutput(OutputBuffer* output, FILE* file)
+{
+    output->file = file;
+    output->length = 0;
+}
+
+//Function to write everything buffered so far
+void flushOutput(OutputBuffer* output)
+{
+    if (output->length > 0)
+    {
+        fwrite(output->data, 1, (size_t)output->length, output->file);
+        output->length = 0;
+    }
+    fflush(output->file);
+}
+
+//Helper to make sure 'length' more bytes fit, false when they never will
+static inline bool reserveOutput(OutputBuffer* output, const int length)
+{
+    if (output->length + length <= OUTPUT_BUFFER_SIZE) return true;
+    flushOutput(output);
+    return length <= OUTPUT_BUFFER_SIZE;
+}
+
+//Function to append raw bytes
+void writeText(OutputBuffer* output, const char* text, const int length)
+{
+    if (!reserveOutput(output, length))
+    {
+        //Longer than the whole buffer, write it straight through
+        fwrite(text, 1, (size_t)length, output->file);
+        return;
+    }
+    memcpy(output->data + output->length, text, (size_t)length);
+    output->length += length;
+}
+
+//Helper to write the digits of 'value' ending at 'end', returns the first digit
+static char* formatDigits(char* end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        const unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--end = digitPairs[pair + 1];
+        *--end = digitPairs[pair];
+    }
+    if (value >= 10)
+    {
+        const unsigned pair = (unsigned)value * 2;
+        *--end = digitPairs[pair + 1];
+        *--end = digitPairs[pair];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+//Function to append an unsigned integer in decimal
+void writeUnsigned(OutputBuffer* output, const uint64_t value)
+{
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    const char* start = formatDigits(end, value);
+    writeText(output, start, (int)(end - start));
+}
+
+//Function to append a signed integer in decimal
+void writeInteger(OutputBuffer* output, const int64_t value)
+{
+    char digits[21];
+    char* end = digits + sizeof(digits);
+    //Negate as unsigned so INT64_MIN works
+    char* start = formatDigits(end, value < 0 ? 0 - (uint64_t)value : (uint64_t)value);
+    if (value < 0) *--start = '-';
+    writeText(output, start, (int)(end - start));
+}
+
+//Function to append a float with 'precision' digits after the point (-1 means 6), like "%.*f"
+void writeFloat(OutputBuffer* output, const double value, int precision)
+{
+    if (precision < 0) precision = DEFAULT_PRECISION;
+    if (isnan(value))
+    {
+        writeText(output, signbit(value) ? "-nan" : "nan", signbit(value) ? 4 : 3);
+        return;
+    }
+    if (isinf(value))
+    {
+        writeText(output, value < 0 ? "-inf" : "inf", value < 0 ? 4 : 3);
+        return;
+    }
+    //Fast path: scale to an integer and round once. Scaling can be off by an ulp,
+    //which only changes the result when the scaled value is right at a half,
+    //so those values (and anything too big or too precise) go through snprintf
+    if (precision <= FAST_PRECISION)
+    {
+        const double scaled = fabs(value) * (double)powersOfTen[precision];
+        if (scaled < 9007199254740992.0) //2^53, every integer below is exact
+        {
+            const double whole = floor(scaled);
+            const double fraction = scaled - whole;
+            if (fabs(fraction - 0.5) > 1e-6)
+            {
+                const uint64_t rounded = (uint64_t)whole + (fraction > 0.5 ? 1 : 0);
+                char digits[48];
+                char* end = digits + sizeof(digits);
+                char* start = end;
+                if (precision > 0)
+                {
+                    uint64_t fractionDigits = rounded % powersOfTen[precision];
+                    for (int i = 0; i < precision; i++)
+                    {
+                        *--start = (char)('0' + fractionDigits % 10);
+                        fractionDigits /= 10;
+                    }
+                    *--start = '.';
+                }
+                start = formatDigits(start, rounded / powersOfTen[precision]);
+                if (signbit(value)) *--start = '-';
+                writeText(output, start, (int)(end - start));
+                return;
+            }
+        }
+    }
+    char buffer[FLOAT_BUFFER_SIZE];
+    const int length = snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    writeText(output, buffer, length < (int)sizeof(buffer) ? length : (int)sizeof(buffer) - 1);
+}
+
+//Function to print a compiled format, 'args' holds format->holeCount registers
+void printFormat(OutputBuffer* output, const FormatString* format, const Slot* args)
+{
+    for (int i = 0; i < format->segmentCount; i++)
+    {
+        const FormatSegment* segment = &format->segments[i];
+        if (!segment->isHole)
+        {
+            writeText(output, segment->text, segment->length);
+            continue;
+        }
+        const Slot arg = *args++;
+        switch (segment->type)
+        {
+        case TYPE_I8: case TYPE_I16: case TYPE_I32: case TYPE_I64:
+            writeInteger(output, arg.i);
+            break;
+        case TYPE_U8: case TYPE_U16: case TYPE_U32: case TYPE_U64:
+            writeUnsigned(output, arg.u);
+            break;
+        case TYPE_F32: case TYPE_F64:
+            writeFloat(output, arg.f, segment->precision);
+            break;
+        case TYPE_CHAR:
+        {
+            const char c = (char)arg.i;
+            writeText(output, &c, 1);
+            break;
+        }
+        case TYPE_BOOL:
+            writeText(output, arg.i != 0 ? "true" : "false", arg.i != 0 ? 4 : 5);
+            break;
+        case TYPE_STRING:
+        {
+            const ObjString* string = (const ObjString*)(uintptr_t)arg.u;
+            writeText(output, string->chars, string->length);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef PRINT_H
+#define PRINT_H
+
+#include "bytecode.h"
+#include "format.h"
+#include <stdint.h>
+#include <stdio.h>
+
+//print() never goes through printf: a compiled FormatString is walked and
+//every piece is written into one reusable buffer, which is flushed when it
+//fills up, before anything is written to stderr and when the program ends.
+
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+//Struct to hold a buffered output stream
+typedef struct
+{
+    FILE* file;
+    int length;
+    char data[OUTPUT_BUFFER_SIZE];
+} OutputBuffer;
+
+//Function to initialize an empty buffer writing to 'file'
+void initOutput(OutputBuffer* output, FILE* file);
+//Function to write everything buffered so far
+void flushOutput(OutputBuffer* output);
+//Function to append raw bytes
+void writeText(OutputBuffer* output, const char* text, int length);
+//Function to append a signed integer in decimal
+void writeInteger(OutputBuffer* output, int64_t value);
+//Function to append an unsigned integer in decimal
+void writeUnsigned(OutputBuffer* output, uint64_t value);
+//Function to append a float with 'precision' digits after the point (-1 means 6), like "%.*f"
+void writeFloat(OutputBuffer* output, double value, int precision);
+//Function to print a compiled format, 'args' holds format->holeCount registers
+void printFormat(OutputBuffer* output, const FormatString* format, const Slot* args);
+
+#endif //PRINT_H
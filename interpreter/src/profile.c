@@ -0,0 +1,346 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "profile.h"
+#include "common.h"
+#include "stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+//Lines listed by printProfile
+#define PROFILE_TOP_LINES 20
+
+//Set while a profile is being collected, read by runChunk
+bool profileEnabled = false;
+
+//Root of the calling context tree and the node of the chunk running now
+static ProfileNode root;
+static ProfileNode* current = &root;
+//Every node but the root, so they can be walked and freed without recursion
+static ProfileNode** nodes = NULL;
+static int nodeCount = 0;
+static int nodeCapacity = 0;
+
+//Struct to hold the totals of one function or one line while a report is built
+typedef struct
+{
+    const Chunk* chunk;
+    int line;              //0 for function totals
+    uint64_t calls;
+    uint64_t instructions;
+    double selfSeconds;
+    double totalSeconds;
+} ProfileEntry;
+
+//Struct to hold a growing list of entries
+typedef struct
+{
+    ProfileEntry* entries;
+    int count;
+    int capacity;
+} ProfileEntries;
+
+//Helper to name a chunk in reports, the top level has no function name
+static const char* chunkName(const Chunk* chunk)
+{
+    return chunk->name != NULL ? chunk->name : "<script>";
+}
+
+//Function to start collecting a profile, call it before running anything
+void startProfile(void)
+{
+    stopProfile();
+    profileEnabled = true;
+}
+
+//Function to enter a run of 'chunk' under the current node, returns the node to count into
+ProfileNode* enterProfile(const Chunk* chunk)
+{
+    ProfileNode* node = current->firstChild;
+    while (node != NULL && node->chunk != chunk) node = node->nextSibling;
+    if (node == NULL)
+    {
+        node = calloc(1, sizeof(ProfileNode));
+        if (node == NULL)
+        {
+            fprintf(stderr, "Not enough memory for the profile\n");
+            exit(74);
+        }
+        node->chunk = chunk;
+        node->parent = current;
+        node->nextSibling = current->firstChild;
+        current->firstChild = node;
+        if (nodeCount == nodeCapacity)
+        {
+            nodeCapacity = GROW_CAPACITY(nodeCapacity);
+            nodes = growArray(nodes, nodeCapacity, sizeof(ProfileNode*));
+        }
+        nodes[nodeCount++] = node;
+        //Chunks are complete before they run, so the counters never need to grow
+        node->codeCount = chunk->count;
+        node->taken = calloc((size_t)chunk->count * 2 + 1, sizeof(uint64_t));
+        if (node->taken == NULL)
+        {
+            fprintf(stderr, "Not enough memory for the profile\n");
+            exit(74);
+        }
+    }
+    node->calls++;
+    current = node;
+    return node;
+}
+
+//Function to leave the run of 'node' that started at 'start' (statsClock seconds)
+void leaveProfile(ProfileNode* node, const double start)
+{
+    const double seconds = statsClock() - start;
+    node->seconds += seconds;
+    node->parent->childSeconds += seconds;
+    current = node->parent;
+}
+
+//Helper to count how often control falls through from instruction 'index' into the next one
+static uint64_t fallThrough(const ProfileNode* node, const uint64_t* counts, const int index)
+{
+    switch ((OpCode)INSTR_OP(node->chunk->code[index]))
+    {
+    case OP_JUMP_IF_FALSE:
+    case OP_JUMP_IF_TRUE:
+    case OP_FOR_PREP:
+    case OP_FOR_LOOP:
+    case OP_FOR_IN:
+        return counts[index] - node->taken[index];
+    case OP_JUMP:
+    case OP_SWITCH:
+    case OP_RETURN:
+    case OP_HALT:
+        return 0;
+    default:
+        return counts[index];
+    }
+}
+
+//Helper to rebuild how often each instruction of a node ran, returns the total.
+//An instruction runs once per call (the first one), per jump taken to it, per switch that
+//picked it and per fall-through from the one before it. Jump targets are known from the code,
+//so the arrivals are added up first and one forward pass adds the fall-throughs. A run that
+//raised a runtime error counts the rest of its block once more than it ran
+static uint64_t countInstructions(const ProfileNode* node, uint64_t* counts)
+{
+    const Instruction* code = node->chunk->code;
+    const int count = node->codeCount;
+    if (count == 0) return 0;
+    for (int i = 0; i < count; i++) counts[i] = node->taken[count + i];
+    counts[0] += node->calls;
+    for (int i = 0; i < count; i++)
+    {
+        if (!isJumpOpcode((OpCode)INSTR_OP(code[i]))) continue;
+        const int target = i + 1 + INSTR_SBX(code[i]);
+        if (target >= 0 && target < count) counts[target] += node->taken[i];
+    }
+    uint64_t total = counts[0];
+    for (int i = 1; i < count; i++)
+    {
+        counts[i] += fallThrough(node, counts, i - 1);
+        total += counts[i];
+    }
+    return total;
+}
+
+//Helper to tell whether 'node' runs inside another run of its own chunk, so its time is already counted
+static bool isRecursive(const ProfileNode* node)
+{
+    for (const ProfileNode* caller = node->parent; caller->chunk != NULL; caller = caller->parent)
+    {
+        if (caller->chunk == node->chunk) return true;
+    }
+    return false;
+}
+
+//Helper to append an entry to a list
+static ProfileEntry* addEntry(ProfileEntries* list, const Chunk* chunk, const int line)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = GROW_CAPACITY(list->capacity);
+        list->entries = growArray(list->entries, list->capacity, sizeof(ProfileEntry));
+    }
+    ProfileEntry* entry = &list->entries[list->count++];
+    memset(entry, 0, sizeof(ProfileEntry));
+    entry->chunk = chunk;
+    entry->line = line;
+    return entry;
+}
+
+//Helper to sort entries by chunk, then by line
+static int compareKeys(const void* a, const void* b)
+{
+    const ProfileEntry* left = a;
+    const ProfileEntry* right = b;
+    if (left->chunk != right->chunk) return (uintptr_t)left->chunk < (uintptr_t)right->chunk ? -1 : 1;
+    return left->line - right->line;
+}
+
+//Helper to sort entries by self time, then by instructions, hottest first
+static int compareHotness(const void* a, const void* b)
+{
+    const ProfileEntry* left = a;
+    const ProfileEntry* right = b;
+    if (left->selfSeconds != right->selfSeconds) return left->selfSeconds > right->selfSeconds ? -1 : 1;
+    if (left->instructions != right->instructions) return left->instructions > right->instructions ? -1 : 1;
+    return compareKeys(a, b);
+}
+
+//Helper to sort a list by key and add up the entries with the same key
+static void mergeEntries(ProfileEntries* list)
+{
+    if (list->count == 0) return;
+    qsort(list->entries, (size_t)list->count, sizeof(ProfileEntry), compareKeys);
+    int merged = 0;
+    for (int i = 1; i < list->count; i++)
+    {
+        ProfileEntry* last = &list->entries[merged];
+        const ProfileEntry* next = &list->entries[i];
+        if (compareKeys(last, next) == 0)
+        {
+            last->calls += next->calls;
+            last->instructions += next->instructions;
+            last->selfSeconds += next->selfSeconds;
+            last->totalSeconds += next->totalSeconds;
+        }
+        else list->entries[++merged] = *next;
+    }
+    list->count = merged + 1;
+}
+
+//Helper to add the lines of one node to 'lines', skipping lines that never ran
+static void addLines(ProfileEntries* lines, const ProfileNode* node, const uint64_t* counts, const uint64_t total)
+{
+    const double selfSeconds = node->seconds - node->childSeconds;
+    for (int i = 0; i < node->codeCount; i++)
+    {
+        if (counts[i] == 0) continue;
+        ProfileEntry* entry = addEntry(lines, node->chunk, node->chunk->lines[i]);
+        entry->instructions = counts[i];
+        entry->selfSeconds = selfSeconds * (double)counts[i] / (double)total;
+    }
+}
+
+//Function to print the hottest functions and lines
+void printProfile(FILE* file)
+{
+    if (nodeCount == 0)
+    {
+        //Nothing lowers scripts to bytecode yet, so a run of one leaves no node to report
+        fprintf(file, "===== Lyka profile =====\n");
+        fprintf(file, "  No bytecode ran, so there is nothing to profile (scripts are not lowered to bytecode yet).\n");
+        return;
+    }
+    ProfileEntries functions = {NULL, 0, 0};
+    ProfileEntries lines = {NULL, 0, 0};
+    uint64_t* counts = NULL;
+    int countCapacity = 0;
+    uint64_t allInstructions = 0;
+    for (int n = 0; n < nodeCount; n++)
+    {
+        const ProfileNode* node = nodes[n];
+        if (node->codeCount > countCapacity)
+        {
+            countCapacity = node->codeCount;
+            counts = growArray(counts, countCapacity, sizeof(uint64_t));
+        }
+        const uint64_t total = countInstructions(node, counts);
+        allInstructions += total;
+        ProfileEntry* function = addEntry(&functions, node->chunk, 0);
+        function->calls = node->calls;
+        function->instructions = total;
+        function->selfSeconds = node->seconds - node->childSeconds;
+        function->totalSeconds = isRecursive(node) ? 0 : node->seconds;
+        if (total > 0) addLines(&lines, node, counts, total);
+    }
+    free(counts);
+    mergeEntries(&functions);
+    mergeEntries(&lines);
+    qsort(functions.entries, (size_t)functions.count, sizeof(ProfileEntry), compareHotness);
+    qsort(lines.entries, (size_t)lines.count, sizeof(ProfileEntry), compareHotness);
+
+    fprintf(file, "===== Lyka profile =====\n");
+    fprintf(file, "  %-24s %12s %12s %10s %14s\n", "function", "self s", "total s", "calls", "instructions");
+    for (int i = 0; i < functions.count; i++)
+    {
+        const ProfileEntry* entry = &functions.entries[i];
+        fprintf(file, "  %-24s %12.6f %12.6f %10llu %14llu\n", chunkName(entry->chunk), entry->selfSeconds,
+                entry->totalSeconds, (unsigned long long)entry->calls, (unsigned long long)entry->instructions);
+    }
+    fprintf(file, "  %-24s %12s %7s %14s\n", "hot line", "self s", "share", "instructions");
+    for (int i = 0; i < lines.count && i < PROFILE_TOP_LINES; i++)
+    {
+        const ProfileEntry* entry = &lines.entries[i];
+        char where[64];
+        snprintf(where, sizeof(where), "%s:%d", chunkName(entry->chunk), entry->line);
+        fprintf(file, "  %-24s %12.6f %6.1f%% %14llu\n", where, entry->selfSeconds,
+                allInstructions > 0 ? 100.0 * (double)entry->instructions / (double)allInstructions : 0.0,
+                (unsigned long long)entry->instructions);
+    }
+    free(functions.entries);
+    free(lines.entries);
+}
+
+//Helper to write the frames from the outermost caller down to 'node', separated by ';'
+static void writeStack(FILE* file, const ProfileNode* node)
+{
+    if (node->parent->chunk != NULL)
+    {
+        writeStack(file, node->parent);
+        fputc(';', file);
+    }
+    fputs(chunkName(node->chunk), file);
+}
+
+//Function to write flamegraph-compatible folded stacks ("caller;callee:line instructions")
+void writeFoldedStacks(FILE* file)
+{
+    ProfileEntries lines = {NULL, 0, 0};
+    uint64_t* counts = NULL;
+    int countCapacity = 0;
+    for (int n = 0; n < nodeCount; n++)
+    {
+        const ProfileNode* node = nodes[n];
+        if (node->codeCount > countCapacity)
+        {
+            countCapacity = node->codeCount;
+            counts = growArray(counts, countCapacity, sizeof(uint64_t));
+        }
+        lines.count = 0;
+        const uint64_t total = countInstructions(node, counts);
+        if (total == 0) continue;
+        addLines(&lines, node, counts, total);
+        mergeEntries(&lines);
+        //The line is the leaf frame, so a function's width in the graph splits into its lines
+        for (int i = 0; i < lines.count; i++)
+        {
+            writeStack(file, node);
+            fprintf(file, ";%s:%d %llu\n", chunkName(node->chunk), lines.entries[i].line,
+                    (unsigned long long)lines.entries[i].instructions);
+        }
+    }
+    free(counts);
+    free(lines.entries);
+}
+
+//Function to stop profiling and release every node
+void stopProfile(void)
+{
+    for (int n = 0; n < nodeCount; n++)
+    {
+        free(nodes[n]->taken);
+        free(nodes[n]);
+    }
+    free(nodes);
+    nodes = NULL;
+    nodeCount = 0;
+    nodeCapacity = 0;
+    memset(&root, 0, sizeof(ProfileNode));
+    current = &root;
+    profileEnabled = false;
+}
@@ -0,0 +1,62 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "bytecode.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Opt-in profiler of the interpreter ('lyka --profile'). Every run of a chunk
+//is charged to a node of a calling context tree, so one function reached from
+//two callers is reported under both stacks. Instead of counting every
+//instruction, the VM only counts taken branches. Instruction counts are
+//rebuilt from those and the number of calls when the report is printed, so
+//straight-line code and branches that fall through run at full speed, and a
+//loop pays one increment per iteration. Time is measured per run of a chunk;
+//the time of a line is its function's self time split by the line's share of
+//the function's instructions. Tiering is off while profiling, so hot loops
+//stay in the interpreter where they can be counted.
+
+//Struct to hold one node of the calling context tree
+typedef struct ProfileNode
+{
+    const Chunk* chunk;              //NULL for the root
+    struct ProfileNode* parent;
+    struct ProfileNode* firstChild;
+    struct ProfileNode* nextSibling;
+    uint64_t* taken;                 //Per instruction, times the jump there was taken, then per
+                                     //instruction again, times an OP_SWITCH arrived there
+    int codeCount;                   //Instructions of the chunk
+    uint64_t calls;
+    double seconds;                  //Inclusive time of every run
+    double childSeconds;             //Part of 'seconds' spent in callees
+} ProfileNode;
+
+//Set while a profile is being collected, read by runChunk
+extern bool profileEnabled;
+
+//Function to start collecting a profile, call it before running anything
+void startProfile(void);
+//Function to enter a run of 'chunk' under the current node, returns the node to count into
+ProfileNode* enterProfile(const Chunk* chunk);
+//Function to leave the run of 'node' that started at 'start' (statsClock seconds)
+void leaveProfile(ProfileNode* node, double start);
+//Function to print the hottest functions and lines
+void printProfile(FILE* file);
+//Function to write flamegraph-compatible folded stacks ("caller;callee:line instructions")
+void writeFoldedStacks(FILE* file);
+//Function to stop profiling and release every node
+void stopProfile(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PROFILE_H
@@ -0,0 +1,766 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "serve.h"
+#include "common.h"
+#include "intern.h"
+#include "lexer.h"
+#include "parallel_lex.h"
+#include "precompiled.h"
+#include "source.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//Largest inline source a request may carry
+#define SERVE_MAX_INLINE_SOURCE ((size_t)INT32_MAX)
+
+//Struct to hold a growing text buffer
+typedef struct
+{
+    char* chars;
+    int length;
+    int capacity;
+} ServeBuffer;
+
+//Struct to hold what running one unit produced, cached by the hash of its source
+typedef struct CachedUnit
+{
+    uint64_t hash;
+    size_t sourceLength;
+    int exitCode;
+    char* diagnostics;          //Lines of ':<line>: error: <message>', the script's name goes in front
+    int diagnosticsLength;
+    size_t bytes;               //What the unit is charged against the budget
+    struct CachedUnit* chain;   //Next unit in the same bucket
+    struct CachedUnit* newer;   //Neighbours in least recently used order
+    struct CachedUnit* older;
+} CachedUnit;
+
+//Struct to hold the units of every script run so far, shared by the workers
+typedef struct
+{
+    pthread_mutex_t lock;
+    CachedUnit** buckets;
+    int bucketCount;            //Always a power of two
+    int count;
+    size_t bytes;
+    size_t budget;
+    CachedUnit* newest;
+    CachedUnit* oldest;
+} UnitCache;
+
+struct Connection;
+
+//Struct to hold one request and, once it ran, its answer
+typedef struct Job
+{
+    struct Connection* connection;
+    char* name;                 //Path of the script, or '<source n>'
+    char* source;               //Inline source ('\0' terminated), NULL for a path
+    size_t sourceLength;
+    ServeBuffer response;
+    int exitCode;
+    bool done;
+    struct Job* next;           //Queue of the pool
+    struct Job* nextReply;      //Answers of the connection, in request order
+} Job;
+
+//Struct to hold the pool of workers and the queue they take jobs from
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t ready;       //A job was queued, or the pool is stopping
+    Job* first;
+    Job* last;
+    bool stopping;
+    pthread_t* threads;
+    int threadCount;
+    UnitCache cache;
+} WorkerPool;
+
+//Struct to hold one client, standard input or a socket connection
+typedef struct Connection
+{
+    WorkerPool* pool;
+    FILE* in;
+    FILE* out;
+    pthread_mutex_t lock;
+    pthread_cond_t drained;     //Every answer was written
+    Job* firstReply;
+    Job* lastReply;
+    int pending;
+    int inlineCount;            //Inline sources so far, to name them
+} Connection;
+
+//Struct to hold what a worker keeps between runs
+typedef struct
+{
+    WorkerPool* pool;
+    TokenBuffer tokens;
+    InternTable interns;
+    ServeBuffer diagnostics;
+} Worker;
+
+//-------------------------------------------------
+//Text buffers
+//-------------------------------------------------
+
+//Helper to append formatted text to a buffer
+static void appendFormat(ServeBuffer* buffer, const char* format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    va_list copy;
+    va_copy(copy, arguments);
+    const int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (buffer->length + length + 1 > buffer->capacity)
+    {
+        int capacity = GROW_CAPACITY(buffer->capacity);
+        while (capacity < buffer->length + length + 1) capacity *= 2;
+        buffer->chars = growArray(buffer->chars, capacity, sizeof(char));
+        buffer->capacity = capacity;
+    }
+    vsnprintf(buffer->chars + buffer->length, (size_t)length + 1, format, arguments);
+    buffer->length += length;
+    va_end(arguments);
+}
+
+//Helper to append cached diagnostics with the name of the script in front of every line
+static void appendDiagnostics(ServeBuffer* buffer, const char* name, const char* diagnostics, const int length)
+{
+    int start = 0;
+    while (start < length)
+    {
+        const char* end = memchr(diagnostics + start, '\n', (size_t)(length - start));
+        const int lineLength = end != NULL ? (int)(end - diagnostics) - start : length - start;
+        appendFormat(buffer, "%s%.*s\n", name, lineLength, diagnostics + start);
+        start += lineLength + 1;
+    }
+}
+
+//-------------------------------------------------
+//Unit cache
+//-------------------------------------------------
+
+//Function to initialize an empty cache of at most 'budget' bytes
+static void initUnitCache(UnitCache* cache, const size_t budget)
+{
+    pthread_mutex_init(&cache->lock, NULL);
+    cache->bucketCount = 64;
+    cache->buckets = calloc((size_t)cache->bucketCount, sizeof(CachedUnit*));
+    if (cache->buckets == NULL)
+    {
+        fprintf(stderr, "Not enough memory for the unit cache\n");
+        exit(74);
+    }
+    cache->count = 0;
+    cache->bytes = 0;
+    cache->budget = budget;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+}
+
+//Function to release a cache and every unit in it
+static void freeUnitCache(UnitCache* cache)
+{
+    CachedUnit* unit = cache->newest;
+    while (unit != NULL)
+    {
+        CachedUnit* older = unit->older;
+        free(unit->diagnostics);
+        free(unit);
+        unit = older;
+    }
+    free(cache->buckets);
+    pthread_mutex_destroy(&cache->lock);
+}
+
+//Helper to find the link that points at the unit of a source, or at the NULL ending its bucket
+static CachedUnit** findUnit(UnitCache* cache, const uint64_t hash, const size_t sourceLength)
+{
+    CachedUnit** link = &cache->buckets[hash & (uint64_t)(cache->bucketCount - 1)];
+    while (*link != NULL && ((*link)->hash != hash || (*link)->sourceLength != sourceLength))
+    {
+        link = &(*link)->chain;
+    }
+    return link;
+}
+
+//Helpers to take a unit out of the recency list and to put it back as the newest one
+static void unlinkRecency(UnitCache* cache, CachedUnit* unit)
+{
+    if (unit->newer != NULL) unit->newer->older = unit->older;
+    else cache->newest = unit->older;
+    if (unit->older != NULL) unit->older->newer = unit->newer;
+    else cache->oldest = unit->newer;
+}
+static void linkNewest(UnitCache* cache, CachedUnit* unit)
+{
+    unit->newer = NULL;
+    unit->older = cache->newest;
+    if (cache->newest != NULL) cache->newest->newer = unit;
+    else cache->oldest = unit;
+    cache->newest = unit;
+}
+
+//Function to answer a job from the cache, diagnostics are reported under 'name'. False when its source was never run
+static bool replayUnit(UnitCache* cache, const uint64_t hash, const size_t sourceLength, const char* name, Job* job)
+{
+    if (cache->budget == 0) return false;
+    pthread_mutex_lock(&cache->lock);
+    CachedUnit* unit = *findUnit(cache, hash, sourceLength);
+    if (unit != NULL)
+    {
+        unlinkRecency(cache, unit);
+        linkNewest(cache, unit);
+        //Copied out under the lock, the unit may be evicted as soon as it is released
+        appendDiagnostics(&job->response, name, unit->diagnostics, unit->diagnosticsLength);
+        job->exitCode = unit->exitCode;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return unit != NULL;
+}
+
+//Helper to rehash the units into twice as many buckets
+static void growBuckets(UnitCache* cache)
+{
+    const int bucketCount = cache->bucketCount * 2;
+    CachedUnit** buckets = calloc((size_t)bucketCount, sizeof(CachedUnit*));
+    if (buckets == NULL)
+    {
+        fprintf(stderr, "Not enough memory to grow the unit cache\n");
+        exit(74);
+    }
+    for (int i = 0; i < cache->bucketCount; i++)
+    {
+        CachedUnit* unit = cache->buckets[i];
+        while (unit != NULL)
+        {
+            CachedUnit* chain = unit->chain;
+            CachedUnit** bucket = &buckets[unit->hash & (uint64_t)(bucketCount - 1)];
+            unit->chain = *bucket;
+            *bucket = unit;
+            unit = chain;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucketCount = bucketCount;
+}
+
+//Function to remember the outcome of a run, the least recently used units make room for it
+static void storeUnit(UnitCache* cache, const uint64_t hash, const size_t sourceLength, const int exitCode,
+                      const ServeBuffer* diagnostics)
+{
+    const size_t bytes = sizeof(CachedUnit) + (size_t)diagnostics->length;
+    if (bytes > cache->budget) return;
+    pthread_mutex_lock(&cache->lock);
+    //Two workers may have run the same source at once
+    if (*findUnit(cache, hash, sourceLength) != NULL)
+    {
+        pthread_mutex_unlock(&cache->lock);
+        return;
+    }
+    while (cache->bytes + bytes > cache->budget)
+    {
+        CachedUnit* oldest = cache->oldest;
+        *findUnit(cache, oldest->hash, oldest->sourceLength) = oldest->chain;
+        unlinkRecency(cache, oldest);
+        cache->bytes -= oldest->bytes;
+        cache->count--;
+        free(oldest->diagnostics);
+        free(oldest);
+    }
+    CachedUnit* unit = malloc(sizeof(CachedUnit));
+    char* copy = malloc((size_t)diagnostics->length + 1);
+    if (unit == NULL || copy == NULL)
+    {
+        fprintf(stderr, "Not enough memory for the unit cache\n");
+        exit(74);
+    }
+    if (diagnostics->length > 0) memcpy(copy, diagnostics->chars, (size_t)diagnostics->length);
+    unit->hash = hash;
+    unit->sourceLength = sourceLength;
+    unit->exitCode = exitCode;
+    unit->diagnostics = copy;
+    unit->diagnosticsLength = diagnostics->length;
+    unit->bytes = bytes;
+    CachedUnit** bucket = findUnit(cache, hash, sourceLength);
+    unit->chain = NULL;
+    *bucket = unit;
+    linkNewest(cache, unit);
+    cache->bytes += bytes;
+    if (++cache->count > cache->bucketCount) growBuckets(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+//-------------------------------------------------
+//Running scripts
+//-------------------------------------------------
+
+//Helper to answer a request for a precompiled module, which is mapped and needs no cache.
+//Returns the source to lex instead when the module is stale or foreign, like runFile does
+static char* runPrecompiledJob(Job* job)
+{
+    PrecompiledModule module;
+    const PrecompiledStatus status = openPrecompiled(&module, job->name);
+    char* sourcePath = NULL;
+    if (status == PRECOMPILED_OK)
+    {
+        job->exitCode = 0;
+    }
+    else
+    {
+        sourcePath = module.sourcePath;
+        module.sourcePath = NULL;
+        if (sourcePath != NULL)
+        {
+            appendFormat(&job->response, "\"%s\" is %s, lexing \"%s\" instead.\n", job->name,
+                         precompiledStatusMessage(status), sourcePath);
+        }
+        else
+        {
+            appendFormat(&job->response, "\"%s\" is %s.\n", job->name, precompiledStatusMessage(status));
+            job->exitCode = status == PRECOMPILED_UNREADABLE ? 74 : 65;
+        }
+    }
+    closePrecompiled(&module);
+    return sourcePath;
+}
+
+//Function to run one script on a worker, the answer is left in the job
+static void runJob(Worker* worker, Job* job)
+{
+    const char* name = job->name;
+    char* fallback = NULL;
+    if (job->source == NULL && isPrecompiledPath(name))
+    {
+        fallback = runPrecompiledJob(job);
+        if (fallback == NULL) return;
+        name = fallback;
+    }
+    Source source;
+    if (job->source != NULL)
+    {
+        source.data = job->source;
+        source.length = job->sourceLength;
+        source.mapSize = 0;
+    }
+    else
+    {
+        const char* error;
+        if (!tryLoadSource(name, &source, &error))
+        {
+            appendFormat(&job->response, "%s \"%s\"\n", error, name);
+            job->exitCode = 74;
+            free(fallback);
+            return;
+        }
+    }
+
+    UnitCache* cache = &worker->pool->cache;
+    const uint64_t hash = hashSource(source.data, source.length);
+    if (!replayUnit(cache, hash, source.length, name, job))
+    {
+        //The buffers only grow, so once they fit the largest script nothing is allocated here
+        resetInternTable(&worker->interns);
+        worker->tokens.interns = &worker->interns;
+        tokenizeAll(&worker->tokens, source.data, source.length);
+        worker->diagnostics.length = 0;
+        for (int i = 0; i < worker->tokens.errorCount; i++)
+        {
+            appendFormat(&worker->diagnostics, ":%d: error: %s\n",
+                         tokenLine(&worker->tokens, worker->tokens.errors[i].index), worker->tokens.errors[i].message);
+        }
+        job->exitCode = worker->tokens.errorCount > 0 ? 65 : 0;
+        appendDiagnostics(&job->response, name, worker->diagnostics.chars, worker->diagnostics.length);
+        if (cache->budget > 0) storeUnit(cache, hash, source.length, job->exitCode, &worker->diagnostics);
+    }
+    if (job->source == NULL) freeSource(&source);
+    free(fallback);
+}
+
+//Helper to release a job
+static void freeJob(Job* job)
+{
+    free(job->name);
+    free(job->source);
+    free(job->response.chars);
+    free(job);
+}
+
+//Function to mark a job as answered and write every answer of its connection that is due
+static void finishJob(Job* job)
+{
+    Connection* connection = job->connection;
+    pthread_mutex_lock(&connection->lock);
+    job->done = true;
+    bool wrote = false;
+    while (connection->firstReply != NULL && connection->firstReply->done)
+    {
+        Job* reply = connection->firstReply;
+        connection->firstReply = reply->nextReply;
+        if (connection->firstReply == NULL) connection->lastReply = NULL;
+        if (reply->response.length > 0) fwrite(reply->response.chars, 1, (size_t)reply->response.length, connection->out);
+        fprintf(connection->out, "exit %d %s\n", reply->exitCode, reply->name);
+        freeJob(reply);
+        connection->pending--;
+        wrote = true;
+    }
+    //One flush per batch of answers, so a client waiting on them is not held up
+    if (wrote) fflush(connection->out);
+    if (connection->pending == 0) pthread_cond_broadcast(&connection->drained);
+    pthread_mutex_unlock(&connection->lock);
+}
+
+//Function run by every worker thread
+static void* workerMain(void* argument)
+{
+    Worker worker;
+    worker.pool = argument;
+    initTokenBuffer(&worker.tokens);
+    initInternTable(&worker.interns);
+    worker.diagnostics.chars = NULL;
+    worker.diagnostics.length = 0;
+    worker.diagnostics.capacity = 0;
+    WorkerPool* pool = worker.pool;
+    while (true)
+    {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->first == NULL && !pool->stopping) pthread_cond_wait(&pool->ready, &pool->lock);
+        Job* job = pool->first;
+        if (job != NULL)
+        {
+            pool->first = job->next;
+            if (pool->first == NULL) pool->last = NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        if (job == NULL) break;
+        runJob(&worker, job);
+        finishJob(job);
+    }
+    freeTokenBuffer(&worker.tokens);
+    freeInternTable(&worker.interns);
+    free(worker.diagnostics.chars);
+    return NULL;
+}
+
+//Function to start a pool of 'threadCount' workers
+static void startPool(WorkerPool* pool, const int threadCount, const size_t cacheBytes)
+{
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->ready, NULL);
+    pool->first = NULL;
+    pool->last = NULL;
+    pool->stopping = false;
+    initUnitCache(&pool->cache, cacheBytes);
+    pool->threads = malloc((size_t)threadCount * sizeof(pthread_t));
+    if (pool->threads == NULL)
+    {
+        fprintf(stderr, "Not enough memory for %d workers\n", threadCount);
+        exit(74);
+    }
+    pool->threadCount = 0;
+    for (int i = 0; i < threadCount; i++)
+    {
+        if (pthread_create(&pool->threads[pool->threadCount], NULL, workerMain, pool) == 0) pool->threadCount++;
+    }
+    if (pool->threadCount == 0)
+    {
+        fprintf(stderr, "Could not start a worker thread\n");
+        exit(70);
+    }
+}
+
+//Function to let the workers finish the queue and release the pool
+static void stopPool(WorkerPool* pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->threadCount; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+    free(pool->threads);
+    freeUnitCache(&pool->cache);
+    pthread_cond_destroy(&pool->ready);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+//-------------------------------------------------
+//Requests
+//-------------------------------------------------
+
+//Helper to make a job for a request of a connection, its answer is reserved a place in the order
+static Job* newJob(Connection* connection, char* name)
+{
+    Job* job = calloc(1, sizeof(Job));
+    if (job == NULL || name == NULL)
+    {
+        fprintf(stderr, "Not enough memory for a request\n");
+        exit(74);
+    }
+    job->connection = connection;
+    job->name = name;
+    pthread_mutex_lock(&connection->lock);
+    if (connection->lastReply != NULL) connection->lastReply->nextReply = job;
+    else connection->firstReply = job;
+    connection->lastReply = job;
+    connection->pending++;
+    pthread_mutex_unlock(&connection->lock);
+    return job;
+}
+
+//Helper to hand a job to the workers
+static void queueJob(WorkerPool* pool, Job* job)
+{
+    pthread_mutex_lock(&pool->lock);
+    if (pool->last != NULL) pool->last->next = job;
+    else pool->first = job;
+    pool->last = job;
+    pthread_cond_signal(&pool->ready);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+//Helper to copy a string to the heap
+static char* copyString(const char* chars, const size_t length)
+{
+    char* copy = malloc(length + 1);
+    if (copy == NULL) return NULL;
+    memcpy(copy, chars, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+//Function to read an '@<n>' request, false (with the answer set) when it is malformed or cut short
+static bool readInlineSource(Connection* connection, const char* count, Job* job)
+{
+    char* end;
+    errno = 0;
+    const unsigned long long length = strtoull(count, &end, 10);
+    if (end == count || *end != '\0' || errno != 0 || length > SERVE_MAX_INLINE_SOURCE || count[0] == '-')
+    {
+        appendFormat(&job->response, "Malformed request \"@%s\"\n", count);
+        job->exitCode = 64;
+        return false;
+    }
+    job->source = malloc((size_t)length + 1);
+    if (job->source == NULL)
+    {
+        fprintf(stderr, "Not enough memory to read a source of %llu bytes\n", length);
+        exit(74);
+    }
+    job->sourceLength = fread(job->source, 1, (size_t)length, connection->in);
+    job->source[job->sourceLength] = '\0';
+    if (job->sourceLength != (size_t)length)
+    {
+        appendFormat(&job->response, "Source ended after %zu of %llu bytes\n", job->sourceLength, length);
+        job->exitCode = 64;
+        return false;
+    }
+    return true;
+}
+
+//Function to read the requests of a connection until it ends, and wait for their answers
+static void serveConnection(Connection* connection)
+{
+    char* line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &capacity, connection->in)) > 0)
+    {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) line[--length] = '\0';
+        if (length == 0) continue;
+        if (line[0] != '@')
+        {
+            Job* job = newJob(connection, copyString(line, (size_t)length));
+            if (strcmp(line, "-") == 0)
+            {
+                //A worker reading standard input would race this loop for the requests
+                appendFormat(&job->response, "Standard input is not a script here, send its source as '@<n>'\n");
+                job->exitCode = 64;
+                finishJob(job);
+            }
+            else
+            {
+                queueJob(connection->pool, job);
+            }
+            continue;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "<source %d>", ++connection->inlineCount);
+        Job* job = newJob(connection, copyString(name, strlen(name)));
+        if (readInlineSource(connection, line + 1, job))
+        {
+            queueJob(connection->pool, job);
+        }
+        else
+        {
+            //The rest of the stream cannot be framed any more
+            finishJob(job);
+            break;
+        }
+    }
+    free(line);
+    pthread_mutex_lock(&connection->lock);
+    while (connection->pending > 0) pthread_cond_wait(&connection->drained, &connection->lock);
+    pthread_mutex_unlock(&connection->lock);
+}
+
+//Helper to set up a connection over two streams
+static void initConnection(Connection* connection, WorkerPool* pool, FILE* in, FILE* out)
+{
+    connection->pool = pool;
+    connection->in = in;
+    connection->out = out;
+    pthread_mutex_init(&connection->lock, NULL);
+    pthread_cond_init(&connection->drained, NULL);
+    connection->firstReply = NULL;
+    connection->lastReply = NULL;
+    connection->pending = 0;
+    connection->inlineCount = 0;
+}
+
+//Helper to release a connection once it is drained
+static void freeConnection(Connection* connection)
+{
+    pthread_cond_destroy(&connection->drained);
+    pthread_mutex_destroy(&connection->lock);
+}
+
+//Struct to hold what a client thread needs
+typedef struct
+{
+    WorkerPool* pool;
+    int socket;
+} Client;
+
+//Function run by the thread of every socket client
+static void* clientMain(void* argument)
+{
+    Client client = *(Client*)argument;
+    free(argument);
+    FILE* in = fdopen(client.socket, "rb");
+    const int writeSocket = dup(client.socket);
+    FILE* out = writeSocket >= 0 ? fdopen(writeSocket, "wb") : NULL;
+    if (in == NULL || out == NULL)
+    {
+        if (in != NULL) fclose(in);
+        else close(client.socket);
+        if (out != NULL) fclose(out);
+        else if (writeSocket >= 0) close(writeSocket);
+        return NULL;
+    }
+    Connection connection;
+    initConnection(&connection, client.pool, in, out);
+    serveConnection(&connection);
+    freeConnection(&connection);
+    fclose(in);
+    fclose(out);
+    return NULL;
+}
+
+//Function to accept clients on a Unix socket, every one on a thread of its own
+static int serveSocket(WorkerPool* pool, const char* path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "Socket path \"%s\" is too long\n", path);
+        return 64;
+    }
+    strcpy(address.sun_path, path);
+    //A socket left behind by an earlier server is replaced, any other file is not
+    struct stat info;
+    if (stat(path, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(path);
+    const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0 || bind(server, (const struct sockaddr*)&address, sizeof(address)) != 0 || listen(server, SOMAXCONN) != 0)
+    {
+        fprintf(stderr, "Could not listen on \"%s\": %s\n", path, strerror(errno));
+        if (server >= 0) close(server);
+        return 74;
+    }
+    //A client that leaves before its answers must not take the server down with it
+    signal(SIGPIPE, SIG_IGN);
+    while (true)
+    {
+        const int descriptor = accept(server, NULL, NULL);
+        if (descriptor < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            fprintf(stderr, "Could not accept a client: %s\n", strerror(errno));
+            break;
+        }
+        Client* client = malloc(sizeof(Client));
+        if (client == NULL)
+        {
+            fprintf(stderr, "Not enough memory for a client\n");
+            exit(74);
+        }
+        client->pool = pool;
+        client->socket = descriptor;
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, clientMain, client) != 0)
+        {
+            close(descriptor);
+            free(client);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+    close(server);
+    unlink(path);
+    return 74;
+}
+
+//Function to serve requests until standard input ends (a socket is served until the process is stopped)
+int serveScripts(const ServeOptions* options)
+{
+    WorkerPool pool;
+    startPool(&pool, options->jobs > 0 ? options->jobs : lexerThreadCount(), options->cacheBytes);
+    if (options->socketPath != NULL)
+    {
+        //Clients may still be running when the socket fails, the process ends with them
+        return serveSocket(&pool, options->socketPath);
+    }
+    Connection connection;
+    initConnection(&connection, &pool, stdin, stdout);
+    serveConnection(&connection);
+    freeConnection(&connection);
+    stopPool(&pool);
+    return 0;
+}
+
+#else
+
+//Function to serve requests, the server needs POSIX threads and sockets
+int serveScripts(const ServeOptions* options)
+{
+    (void)options;
+    fprintf(stderr, "--serve is not supported on this platform\n");
+    return 64;
+}
+
+#endif
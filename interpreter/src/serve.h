@@ -0,0 +1,37 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef SERVE_H
+#define SERVE_H
+
+#include <stddef.h>
+
+//Batch/server mode ('lyka --serve'). One warm process runs many scripts, so
+//process startup is paid once. Requests are read from standard input, or from
+//every client of a Unix socket, and run on a pool of worker threads. A request
+//is one line holding the path of a script, or '@<n>' followed by the n bytes of
+//a script's source. The path '-' is refused, standard input carries the
+//requests. Every worker keeps its token buffer and intern table from one run to
+//the next, so a warm worker does not allocate in the lexer. The outcome of a
+//run is cached under the xxHash64 and length of the source, and an unchanged
+//script costs one read and one hash. Each client gets its answers in the order
+//it sent the requests: the script's diagnostics, then the line
+//'exit <code> <name>' (0, 65 for lex errors, 74 when the script cannot be read,
+//64 for a malformed request).
+
+//Default budget of the unit cache
+#define SERVE_DEFAULT_CACHE_MB 64
+
+//Struct to hold the options of a server
+typedef struct
+{
+    int jobs;                //Worker threads, 0 for every core
+    const char* socketPath;  //Unix socket to listen on, NULL for standard input
+    size_t cacheBytes;       //Budget of the unit cache, 0 turns it off
+} ServeOptions;
+
+//Function to serve requests until standard input ends (a socket is served until the process is stopped).
+//Returns the exit code of the process
+int serveScripts(const ServeOptions* options);
+
+#endif //SERVE_H
@@ -0,0 +1,226 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef VALUE_H
+#define VALUE_H
+
+#include "common.h"
+#include "types.h"
+#include "bytecode.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+//A Value is one 64-bit word (NaN boxing). Any double is stored as itself.
+//Everything else is hidden in the payload of a negative quiet NaN:
+//
+//   1111 1111 1111 1 TTT  PPPP ... PPPP (48 bits)
+//   sign, exponent, quiet  tag  payload
+//
+//Real NaNs are always stored as the positive canonical NaN, so they never
+//collide with a boxed value. Integers that fit in 48 bits (every i8..i32 and
+//u8..u32, and most i64/u64) live in the payload. Wider ones and strings live
+//behind an object pointer, which fits because user space addresses on x86-64
+//and AArch64 are at most 48 bits wide.
+//The VM itself keeps untyped Slots in registers, Values are for storage that
+//has to carry its own type (generic containers, constants, debugging output).
+typedef uint64_t Value;
+
+_Static_assert(sizeof(Value) == 8, "Value must stay one machine word");
+_Static_assert(sizeof(void*) <= 8, "Object pointers must fit in a Value");
+
+#define VALUE_BOX_MASK     ((uint64_t)0xFFF8000000000000) //Sign, exponent and quiet bit
+#define VALUE_TAG_SHIFT    48
+#define VALUE_TAG_MASK     ((uint64_t)0x7 << VALUE_TAG_SHIFT)
+#define VALUE_PAYLOAD_MASK ((uint64_t)0x0000FFFFFFFFFFFF)
+#define VALUE_CANONICAL_NAN ((uint64_t)0x7FF8000000000000)
+
+//Tags of boxed values, tag 0 is left unused so no boxed value is a bare NaN pattern
+typedef enum
+{
+    VALUE_TAG_NULL = 1,
+    VALUE_TAG_BOOL = 2,
+    VALUE_TAG_CHAR = 3,
+    VALUE_TAG_INT = 4,  //Signed, payload sign-extended from 48 bits
+    VALUE_TAG_UINT = 5, //Unsigned, payload zero-extended
+    VALUE_TAG_OBJ = 6   //Pointer to an Obj
+} ValueTag;
+
+#define VALUE_INT_MIN (-((int64_t)1 << 47))
+#define VALUE_INT_MAX (((int64_t)1 << 47) - 1)
+#define VALUE_UINT_MAX (((uint64_t)1 << 48) - 1)
+
+//Enum to hold the kinds of heap objects a Value can point to
+typedef enum
+{
+    OBJ_STRING,
+    OBJ_INT64,  //i64 outside the 48-bit payload
+    OBJ_UINT64, //u64 outside the 48-bit payload
+    OBJ_ARRAY   //Typed array, see array.h
+} ObjType;
+
+//Struct to hold the header every object starts with
+typedef struct
+{
+    ObjType type;
+} Obj;
+
+//Struct to hold a string, the characters are not owned (intern table or arena)
+typedef struct
+{
+    Obj obj;
+    int length;
+    const char* chars;
+} ObjString;
+
+//Struct to hold a 64-bit integer that does not fit in a payload
+typedef struct
+{
+    Obj obj;
+    uint64_t bits;
+} ObjWideInt;
+
+#define VALUE_NULL ((Value)(VALUE_BOX_MASK | (uint64_t)VALUE_TAG_NULL << VALUE_TAG_SHIFT))
+
+//Helpers to box a value
+static inline Value boxTagged(const ValueTag tag, const uint64_t payload)
+{
+    return VALUE_BOX_MASK | (uint64_t)tag << VALUE_TAG_SHIFT | (payload & VALUE_PAYLOAD_MASK);
+}
+static inline Value doubleValue(const double number)
+{
+    if (isnan(number)) return VALUE_CANONICAL_NAN;
+    Value value;
+    memcpy(&value, &number, sizeof(value));
+    return value;
+}
+static inline Value boolValue(const bool boolean)
+{
+    return boxTagged(VALUE_TAG_BOOL, boolean ? 1 : 0);
+}
+static inline Value charValue(const char character)
+{
+    return boxTagged(VALUE_TAG_CHAR, (unsigned char)character);
+}
+static inline Value objValue(Obj* object)
+{
+    return boxTagged(VALUE_TAG_OBJ, (uint64_t)(uintptr_t)object);
+}
+
+//Helpers to inspect a value
+static inline bool isDouble(const Value value)
+{
+    return (value & VALUE_BOX_MASK) != VALUE_BOX_MASK;
+}
+static inline ValueTag valueTag(const Value value)
+{
+    return (ValueTag)((value & VALUE_TAG_MASK) >> VALUE_TAG_SHIFT);
+}
+static inline bool isTagged(const Value value, const ValueTag tag)
+{
+    return !isDouble(value) && valueTag(value) == tag;
+}
+static inline bool isNull(const Value value)
+{
+    return value == VALUE_NULL;
+}
+static inline bool isObjType(const Value value, const ObjType type)
+{
+    return isTagged(value, VALUE_TAG_OBJ) && ((Obj*)(uintptr_t)(value & VALUE_PAYLOAD_MASK))->type == type;
+}
+
+//Helpers to unbox a value, the caller has checked the type
+static inline double asDouble(const Value value)
+{
+    double number;
+    memcpy(&number, &value, sizeof(number));
+    return number;
+}
+static inline bool asBool(const Value value)
+{
+    return (value & 1) != 0;
+}
+static inline char asChar(const Value value)
+{
+    return (char)(value & 0xFF);
+}
+static inline Obj* asObj(const Value value)
+{
+    return (Obj*)(uintptr_t)(value & VALUE_PAYLOAD_MASK);
+}
+static inline ObjString* asString(const Value value)
+{
+    return (ObjString*)asObj(value);
+}
+
+//Function to box a signed integer, only values wider than 48 bits touch the arena
+static inline Value intValue(Arena* arena, const int64_t integer)
+{
+    if (integer >= VALUE_INT_MIN && integer <= VALUE_INT_MAX) return boxTagged(VALUE_TAG_INT, (uint64_t)integer);
+    ObjWideInt* wide = ARENA_NEW(arena, ObjWideInt);
+    wide->obj.type = OBJ_INT64;
+    wide->bits = (uint64_t)integer;
+    return objValue(&wide->obj);
+}
+//Function to box an unsigned integer, only values wider than 48 bits touch the arena
+static inline Value uintValue(Arena* arena, const uint64_t integer)
+{
+    if (integer <= VALUE_UINT_MAX) return boxTagged(VALUE_TAG_UINT, integer);
+    ObjWideInt* wide = ARENA_NEW(arena, ObjWideInt);
+    wide->obj.type = OBJ_UINT64;
+    wide->bits = integer;
+    return objValue(&wide->obj);
+}
+//Function to make a string value over characters that outlive it
+static inline Value stringValue(Arena* arena, const char* chars, const int length)
+{
+    ObjString* string = ARENA_NEW(arena, ObjString);
+    string->obj.type = OBJ_STRING;
+    string->length = length;
+    string->chars = chars;
+    return objValue(&string->obj);
+}
+
+//Helper to check for any integer, inline or wide
+static inline bool isInteger(const Value value)
+{
+    return isTagged(value, VALUE_TAG_INT) || isTagged(value, VALUE_TAG_UINT) ||
+           isObjType(value, OBJ_INT64) || isObjType(value, OBJ_UINT64);
+}
+//Helper to read any integer as its 64-bit pattern
+static inline uint64_t asIntegerBits(const Value value)
+{
+    switch (valueTag(value))
+    {
+    case VALUE_TAG_INT: return (uint64_t)(((int64_t)(value << 16)) >> 16); //Sign-extend the payload
+    case VALUE_TAG_UINT: return value & VALUE_PAYLOAD_MASK;
+    default: return ((ObjWideInt*)asObj(value))->bits;
+    }
+}
+
+//Function to box a VM register whose static type is known
+static inline Value slotToValue(Arena* arena, const Slot slot, const TypeKind type)
+{
+    if (isFloatType(type)) return doubleValue(slot.f);
+    if (isSignedType(type)) return intValue(arena, slot.i);
+    if (isUnsignedType(type)) return uintValue(arena, slot.u);
+    switch (type)
+    {
+    case TYPE_BOOL: return boolValue(slot.i != 0);
+    case TYPE_CHAR: return charValue((char)slot.i);
+    case TYPE_STRING: return objValue((Obj*)(uintptr_t)slot.u);
+    default: return VALUE_NULL;
+    }
+}
+//Function to load a value back into a VM register
+static inline Slot valueToSlot(const Value value)
+{
+    Slot slot;
+    if (isDouble(value)) slot.f = asDouble(value);
+    else if (isInteger(value)) slot.u = asIntegerBits(value);
+    else if (isTagged(value, VALUE_TAG_OBJ)) slot.u = (uint64_t)(uintptr_t)asObj(value);
+    else slot.u = value & VALUE_PAYLOAD_MASK; //null, bool, char
+    return slot;
+}
+
+#endif //VALUE_H
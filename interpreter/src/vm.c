@@ -0,0 +1,118 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "vm.h"
+#include "array.h"
+#include "profile.h"
+#include "stats.h"
+#include "types.h"
+#include <stdio.h>
+
+//GCC and Clang get a computed-goto dispatch table (one indirect branch per opcode,
+//which predicts far better than a single switch). LYKA_VM_SWITCH forces the portable loop
+#if defined(__GNUC__) && !defined(LYKA_VM_SWITCH)
+#define VM_COMPUTED_GOTO
+#endif
+
+//Helper to report a runtime error at the instruction that was just executed
+static InterpretResult runtimeError(const Chunk* chunk, const Instruction* pc, const char* message)
+{
+    const int index = (int)(pc - chunk->code) - 1;
+    fprintf(stderr, "Runtime error: %s\n[line %d] in script\n", message, chunk->lines[index]);
+    return INTERPRET_RUNTIME_ERROR;
+}
+
+//Hook that compiles hot chunks, set once at startup
+static TierUpHook tierUpHook = NULL;
+
+//Function to install the tier-up hook
+void setTierUpHook(const TierUpHook hook)
+{
+    tierUpHook = hook;
+}
+
+//Helper to ask the JIT tier for native code, once per chunk. A profiled run stays interpreted
+static bool tierUp(Chunk* chunk)
+{
+    if (!chunk->tierAttempted && tierUpHook != NULL && !profileEnabled)
+    {
+        chunk->tierAttempted = true;
+        chunk->native = tierUpHook(chunk);
+    }
+    return chunk->native != NULL;
+}
+
+//Helper to continue a chunk in native code at instruction 'entry'
+static InterpretResult runNative(const Chunk* chunk, Slot* registers, Slot* result, const int entry)
+{
+    Slot ignored;
+    const int failed = chunk->native(registers, result != NULL ? result : &ignored, entry);
+    if (failed == 0) return INTERPRET_OK;
+    //Native code only fails where the interpreter would, and reports the same error
+    const OpCode op = (OpCode)INSTR_OP(chunk->code[failed - 1]);
+    const char* message = op == OP_GET_ELEMENT || op == OP_SET_ELEMENT ? "Array index out of bounds." : "Division by zero.";
+    return runtimeError(chunk, chunk->code + failed, message);
+}
+
+//Helper to narrow a 64-bit register to a smaller integer type
+static int64_t wrapToType(const int64_t value, const TypeKind type)
+{
+    switch (type)
+    {
+    case TYPE_I8: return (int8_t)value;
+    case TYPE_I16: return (int16_t)value;
+    case TYPE_I32: return (int32_t)value;
+    case TYPE_U8: return (uint8_t)value;
+    case TYPE_U16: return (uint16_t)value;
+    case TYPE_U32: return (uint32_t)value;
+    case TYPE_BOOL: return value != 0;
+    default: return value;
+    }
+}
+
+//Helper to convert a float register to an integer, saturating like the JIT tier's fptosi_sat:
+//NaN becomes 0 and values outside int64 clamp to its bounds instead of being undefined in C
+static int64_t floatToInt(const double value)
+{
+    if (value != value) return 0;
+    if (value >= 9223372036854775808.0) return INT64_MAX;
+    if (value < -9223372036854775808.0) return INT64_MIN;
+    return (int64_t)value;
+}
+
+#ifdef VM_COMPUTED_GOTO
+//Labels as values are a GNU extension
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#define VM_DISPATCH_NAME interpret
+#define VM_DISPATCH_PROFILED 0
+#include "vm_dispatch.h"
+
+#define VM_DISPATCH_NAME interpretProfiled
+#define VM_DISPATCH_PROFILED 1
+#include "vm_dispatch.h"
+
+#ifdef VM_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+//Function to run a chunk on a register file of at least chunk->registerCount slots.
+//The value of OP_RETURN is stored in 'result' (may be NULL)
+InterpretResult runChunk(Chunk* chunk, Slot* registers, Slot* result)
+{
+    if (profileEnabled)
+    {
+        const double start = statsClock();
+        ProfileNode* node = enterProfile(chunk);
+        const InterpretResult outcome = interpretProfiled(chunk, registers, result, node->taken);
+        leaveProfile(node, start);
+        return outcome;
+    }
+    if (chunk->native != NULL || (++chunk->hotness == TIER_UP_THRESHOLD && tierUp(chunk)))
+    {
+        return runNative(chunk, registers, result, 0);
+    }
+    return interpret(chunk, registers, result, NULL);
+}
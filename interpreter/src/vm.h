@@ -0,0 +1,44 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef VM_H
+#define VM_H
+
+#include "bytecode.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Enum to hold the outcome of running a program
+typedef enum
+{
+    INTERPRET_OK,
+    INTERPRET_COMPILE_ERROR,
+    INTERPRET_RUNTIME_ERROR
+} InterpretResult;
+
+//Tiered execution: every chunk starts in the interpreter. Once it has been
+//entered TIER_UP_THRESHOLD times, or one run has taken that many backward
+//jumps, the tier-up hook (the LLVM JIT when lyka is built with
+//LYKA_ENABLE_TIERING) is asked once for native code. A hot loop switches over
+//at that backward jump with its registers as they are, and every later run
+//of the chunk starts native. The hook returns NULL for chunks it cannot
+//compile, which then stay interpreted
+#define TIER_UP_THRESHOLD 1000
+
+//Function that compiles a chunk to native code, or returns NULL
+typedef NativeChunk (*TierUpHook)(const Chunk* chunk);
+
+//Function to install the tier-up hook, call it once before running anything (NULL disables tiering)
+void setTierUpHook(TierUpHook hook);
+
+//Function to run a chunk on a register file of at least chunk->registerCount slots.
+//The value of OP_RETURN is stored in 'result' (may be NULL)
+InterpretResult runChunk(Chunk* chunk, Slot* registers, Slot* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //VM_H
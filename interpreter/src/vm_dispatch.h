@@ -0,0 +1,207 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+//The dispatch loop of the VM, included by vm.c once per variant with
+//VM_DISPATCH_NAME and VM_DISPATCH_PROFILED set. Keeping the profiled copy
+//separate means runs without '--profile' do not test for it on every branch.
+//No include guard on purpose.
+
+//Function to interpret a chunk from its first instruction. The profiled copy counts every taken
+//branch into 'taken' (see ProfileNode), the other ignores it
+static InterpretResult VM_DISPATCH_NAME(Chunk* chunk, Slot* registers, Slot* result, uint64_t* taken)
+{
+    (void)taken;
+    //Backward jumps this run may take before it asks for native code, a local so it stays in a register
+    uint32_t tierBudget = chunk->tierAttempted || tierUpHook == NULL || VM_DISPATCH_PROFILED ? UINT32_MAX : TIER_UP_THRESHOLD;
+    const Instruction* pc = chunk->code;
+    const Slot* constants = chunk->constants;
+    Slot* R = registers;
+    Instruction instruction;
+
+#define A INSTR_A(instruction)
+#define B INSTR_B(instruction)
+#define C INSTR_C(instruction)
+//Backward jumps are where loops spend their time, so that is where a hot chunk switches to native code
+#define BACK_EDGE(offset) \
+    if ((offset) < 0 && --tierBudget == 0) \
+    { \
+        if (tierUp(chunk)) return runNative(chunk, R, result, (int)(pc - chunk->code)); \
+        tierBudget = UINT32_MAX; \
+    }
+//Only taken branches are counted, the profiler rebuilds everything else from them
+#if VM_DISPATCH_PROFILED
+#define TAKEN() taken[pc - 1 - chunk->code]++
+#define SWITCHED() taken[chunk->count + (pc - chunk->code)]++
+#else
+#define TAKEN()
+#define SWITCHED()
+#endif
+
+#ifdef VM_COMPUTED_GOTO
+    static const void* dispatchTable[OP_COUNT] =
+    {
+#define OPCODE_LABEL(name) &&do_##name,
+        FOR_EACH_OPCODE(OPCODE_LABEL)
+#undef OPCODE_LABEL
+    };
+#define CASE(name) do_##name:
+#define DISPATCH() do { instruction = *pc++; goto *dispatchTable[INSTR_OP(instruction)]; } while (0)
+    DISPATCH();
+#else
+#define CASE(name) case name:
+#define DISPATCH() continue
+    for (;;)
+    {
+        instruction = *pc++;
+        switch ((OpCode)INSTR_OP(instruction))
+        {
+#endif
+
+    CASE(OP_MOVE)         R[A] = R[B]; DISPATCH();
+    CASE(OP_LOAD_CONST)   R[A] = constants[INSTR_BX(instruction)]; DISPATCH();
+    CASE(OP_LOAD_INT)     R[A].i = INSTR_SBX(instruction); DISPATCH();
+
+    //Integer arithmetic wraps like the target machine, so it runs on unsigned bits
+    CASE(OP_ADD_INT)      R[A].u = R[B].u + R[C].u; DISPATCH();
+    CASE(OP_SUB_INT)      R[A].u = R[B].u - R[C].u; DISPATCH();
+    CASE(OP_MUL_INT)      R[A].u = R[B].u * R[C].u; DISPATCH();
+    CASE(OP_DIV_INT)
+        if (R[C].i == 0) return runtimeError(chunk, pc, "Division by zero.");
+        if (R[C].i == -1) R[A].u = 0 - R[B].u; else R[A].i = R[B].i / R[C].i;
+        DISPATCH();
+    CASE(OP_MOD_INT)
+        if (R[C].i == 0) return runtimeError(chunk, pc, "Division by zero.");
+        if (R[C].i == -1) R[A].i = 0; else R[A].i = R[B].i % R[C].i;
+        DISPATCH();
+    CASE(OP_DIV_UINT)
+        if (R[C].u == 0) return runtimeError(chunk, pc, "Division by zero.");
+        R[A].u = R[B].u / R[C].u;
+        DISPATCH();
+    CASE(OP_MOD_UINT)
+        if (R[C].u == 0) return runtimeError(chunk, pc, "Division by zero.");
+        R[A].u = R[B].u % R[C].u;
+        DISPATCH();
+    CASE(OP_ADDI_INT)     R[A].u = R[B].u + (uint64_t)(int64_t)(int8_t)C; DISPATCH();
+    CASE(OP_NEG_INT)      R[A].u = 0 - R[B].u; DISPATCH();
+    CASE(OP_BIT_AND)      R[A].u = R[B].u & R[C].u; DISPATCH();
+    CASE(OP_BIT_OR)       R[A].u = R[B].u | R[C].u; DISPATCH();
+    CASE(OP_BIT_XOR)      R[A].u = R[B].u ^ R[C].u; DISPATCH();
+    CASE(OP_BIT_NOT)      R[A].u = ~R[B].u; DISPATCH();
+    CASE(OP_SHL)          R[A].u = R[B].u << (R[C].u & 63); DISPATCH();
+    CASE(OP_SHR)          R[A].i = R[B].i >> (R[C].u & 63); DISPATCH();
+    CASE(OP_SHR_UINT)     R[A].u = R[B].u >> (R[C].u & 63); DISPATCH();
+
+    CASE(OP_ADD_FLOAT)    R[A].f = R[B].f + R[C].f; DISPATCH();
+    CASE(OP_SUB_FLOAT)    R[A].f = R[B].f - R[C].f; DISPATCH();
+    CASE(OP_MUL_FLOAT)    R[A].f = R[B].f * R[C].f; DISPATCH();
+    CASE(OP_DIV_FLOAT)    R[A].f = R[B].f / R[C].f; DISPATCH();
+    CASE(OP_NEG_FLOAT)    R[A].f = -R[B].f; DISPATCH();
+    CASE(OP_INT_TO_FLOAT) R[A].f = (double)R[B].i; DISPATCH();
+    CASE(OP_FLOAT_TO_INT) R[A].i = floatToInt(R[B].f); DISPATCH();
+    CASE(OP_WRAP)         R[A].i = wrapToType(R[B].i, (TypeKind)C); DISPATCH();
+
+    CASE(OP_EQ_INT)       R[A].i = R[B].u == R[C].u; DISPATCH();
+    CASE(OP_NE_INT)       R[A].i = R[B].u != R[C].u; DISPATCH();
+    CASE(OP_LT_INT)       R[A].i = R[B].i < R[C].i; DISPATCH();
+    CASE(OP_LE_INT)       R[A].i = R[B].i <= R[C].i; DISPATCH();
+    CASE(OP_LT_UINT)      R[A].i = R[B].u < R[C].u; DISPATCH();
+    CASE(OP_LE_UINT)      R[A].i = R[B].u <= R[C].u; DISPATCH();
+    CASE(OP_EQ_FLOAT)     R[A].i = R[B].f == R[C].f; DISPATCH();
+    CASE(OP_LT_FLOAT)     R[A].i = R[B].f < R[C].f; DISPATCH();
+    CASE(OP_LE_FLOAT)     R[A].i = R[B].f <= R[C].f; DISPATCH();
+    CASE(OP_NOT)          R[A].i = R[B].i == 0; DISPATCH();
+
+    //Arrays are held in registers as ObjArray pointers
+    CASE(OP_GET_ELEMENT)
+        if (!arrayLoad((const ObjArray*)(uintptr_t)R[B].u, R[C].i, &R[A]))
+            return runtimeError(chunk, pc, "Array index out of bounds.");
+        DISPATCH();
+    CASE(OP_SET_ELEMENT)
+        if (!arrayStore((ObjArray*)(uintptr_t)R[A].u, R[B].i, R[C]))
+            return runtimeError(chunk, pc, "Array index out of bounds.");
+        DISPATCH();
+    CASE(OP_ARRAY_LENGTH) R[A].i = ((const ObjArray*)(uintptr_t)R[B].u)->count; DISPATCH();
+
+    CASE(OP_JUMP)
+        TAKEN();
+        pc += INSTR_SBX(instruction);
+        BACK_EDGE(INSTR_SBX(instruction));
+        DISPATCH();
+    CASE(OP_JUMP_IF_FALSE)
+        if (R[A].i == 0)
+        {
+            TAKEN();
+            pc += INSTR_SBX(instruction);
+            BACK_EDGE(INSTR_SBX(instruction));
+        }
+        DISPATCH();
+    CASE(OP_JUMP_IF_TRUE)
+        if (R[A].i != 0)
+        {
+            TAKEN();
+            pc += INSTR_SBX(instruction);
+            BACK_EDGE(INSTR_SBX(instruction));
+        }
+        DISPATCH();
+
+    //Counted loops, the compiler has proven the step never overflows (see loops.h)
+    CASE(OP_FOR_PREP)
+        if (R[A].i >= R[A + 1].i)
+        {
+            TAKEN();
+            pc += INSTR_SBX(instruction);
+        }
+        DISPATCH();
+    CASE(OP_FOR_LOOP)
+        R[A].i += R[A + 2].i;
+        if (R[A].i < R[A + 1].i)
+        {
+            TAKEN();
+            pc += INSTR_SBX(instruction);
+            BACK_EDGE(INSTR_SBX(instruction));
+        }
+        DISPATCH();
+    CASE(OP_FOR_IN)
+    {
+        const ObjArray* array = (const ObjArray*)(uintptr_t)R[A].u;
+        if (R[A + 1].i < array->count)
+        {
+            R[A + 2] = arrayLoadUnchecked(array, R[A + 1].i++);
+            TAKEN();
+            pc += INSTR_SBX(instruction);
+            BACK_EDGE(INSTR_SBX(instruction));
+        }
+        DISPATCH();
+    }
+
+    CASE(OP_SWITCH)
+        pc = chunk->code + switchTarget(&chunk->switches[INSTR_BX(instruction)], R[A].i);
+        SWITCHED();
+        DISPATCH();
+
+    CASE(OP_RETURN)
+        if (result != NULL) *result = R[A];
+        return INTERPRET_OK;
+    CASE(OP_HALT)
+        if (result != NULL) result->i = 0;
+        return INTERPRET_OK;
+
+#ifndef VM_COMPUTED_GOTO
+        default:
+            return runtimeError(chunk, pc, "Invalid opcode.");
+        }
+    }
+#endif
+
+#undef CASE
+#undef DISPATCH
+#undef BACK_EDGE
+#undef TAKEN
+#undef SWITCHED
+#undef A
+#undef B
+#undef C
+}
+
+#undef VM_DISPATCH_NAME
+#undef VM_DISPATCH_PROFILED
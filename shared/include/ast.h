@@ -0,0 +1,150 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef AST_H
+#define AST_H
+
+#include "token.h"
+#include "types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//The AST is a flat pool of nodes addressed by 32-bit ids instead of a pointer
+//tree. Every node is a kind, a flags byte, its main token and two 32-bit data
+//words (lhs, rhs) kept in parallel arrays. Nodes with more than two children
+//store them in the 'extra' side array and point at them through lhs/rhs.
+//Tokens are indices into the TokenBuffer the tree was parsed from, so a
+//declaration's type keyword is simply the token in front of its name.
+
+//Id of a node inside an Ast, 0 is never a real node
+typedef uint32_t NodeId;
+#define NODE_NONE ((NodeId)0)
+
+//Enum to hold all the node kinds, with what 'token', 'lhs' and 'rhs' mean for each
+typedef enum
+{
+    NODE_INVALID,         //Slot 0, never used by a real node
+    //1. Literals and names - token only
+    NODE_INT_LITERAL, NODE_FLOAT_LITERAL, NODE_STRING_LITERAL, NODE_CHAR_LITERAL,
+    NODE_BOOL_LITERAL, NODE_NULL_LITERAL, NODE_IDENTIFIER,
+    NODE_CONSTANT,        //token: of the folded node  lhs, rhs: low and high word of the value   flags: its TypeKind
+    //2. Expressions
+    NODE_UNARY,           //token: operator        lhs: operand
+    NODE_BINARY,          //token: operator        lhs: left             rhs: right
+    NODE_ASSIGN,          //token: '=', '+=', ...  lhs: target           rhs: value
+    NODE_TERNARY,         //token: '?'             lhs: condition        rhs: extra[then, else]
+    NODE_CALL,            //token: '('             lhs: callee           rhs: extra[argsStart, argsEnd]
+    NODE_INDEX,           //token: '['             lhs: array            rhs: index
+    NODE_CAST,            //token: type keyword    lhs: operand
+    NODE_ARRAY_LITERAL,   //token: '{'             lhs..rhs: element range in extra
+    //3. Statements
+    NODE_EXPR_STMT,       //token: first token     lhs: expression
+    NODE_VAR_DECL,        //token: name            lhs: array length     rhs: initializer
+    NODE_BLOCK,           //token: '{'             lhs..rhs: statement range in extra
+    NODE_IF,              //token: 'if'            lhs: condition        rhs: extra[then, else]
+    NODE_WHILE,           //token: 'while'         lhs: condition        rhs: body
+    NODE_DO_WHILE,        //token: 'do'            lhs: body             rhs: condition
+    NODE_FOR,             //token: 'for'           lhs: extra[init, condition, step]   rhs: body
+    NODE_FOR_IN,          //token: element name    lhs: iterable         rhs: body
+    NODE_LOOP,            //token: 'loop'          lhs: body
+    NODE_BREAK,           //token: 'break'
+    NODE_CONTINUE,        //token: 'continue'
+    NODE_RETURN,          //token: 'return'        lhs: value
+    NODE_MATCH,           //token: 'match'         lhs: scrutinee        rhs: extra[armsStart, armsEnd]
+    NODE_MATCH_ARM,       //token: '('             lhs: pattern (NODE_NONE for '_')   rhs: body
+    NODE_PARAM,           //token: name
+    NODE_FN_DECL,         //token: name            lhs: extra[paramsStart, paramsEnd, returnTypeToken]   rhs: body
+    NODE_PROGRAM          //token: 0               lhs..rhs: declaration range in extra
+} NodeKind;
+
+//Flags of declarations (NODE_VAR_DECL, NODE_PARAM, NODE_FOR_IN)
+#define NODE_FLAG_MUT           0x01 //'mut' binding
+#define NODE_FLAG_CONST         0x02 //'const' binding
+#define NODE_FLAG_ARRAY         0x04 //'name[N]', the length expression is in lhs
+#define NODE_FLAG_DYNAMIC_ARRAY 0x08 //'name[..]'
+#define NODE_FLAG_UNSIZED_ARRAY 0x10 //'name[]'
+
+//Flags of NODE_CONSTANT, besides the TypeKind in the low bits
+#define NODE_FLAG_UNTYPED       0x80 //Folded from literals only, the context gives it a type like a literal
+#define NODE_CONSTANT_TYPE_MASK 0x7F
+
+//Struct to hold the two data words of a node
+typedef struct
+{
+    uint32_t lhs;
+    uint32_t rhs;
+} NodeData;
+
+//Struct to hold a whole tree
+typedef struct
+{
+    const TokenBuffer* tokens; //Token stream every 'token' index refers to
+    uint8_t* kinds;
+    uint8_t* flags;
+    uint32_t* mainTokens;
+    NodeData* data;
+    int count;
+    int capacity;
+    //Children of nodes with more than two of them, and other overflow data
+    uint32_t* extra;
+    int extraCount;
+    int extraCapacity;
+    NodeId root;
+} Ast;
+
+//Function to initialize an empty tree over a token stream
+void initAst(Ast* ast, const TokenBuffer* tokens);
+//Function to release a tree
+void freeAst(Ast* ast);
+//Function to append a node and get its id
+NodeId addNode(Ast* ast, NodeKind kind, uint32_t token, uint32_t lhs, uint32_t rhs);
+//Function to append words to the extra array, returns the index of the first one
+uint32_t addExtra(Ast* ast, const uint32_t* words, int count);
+//Function to store a list of nodes in extra, sets [start, end) of the range
+void addNodeList(Ast* ast, const NodeId* nodes, int count, uint32_t* start, uint32_t* end);
+
+//Helpers to read a node
+static inline NodeKind nodeKind(const Ast* ast, const NodeId node)
+{
+    return (NodeKind)ast->kinds[node];
+}
+static inline uint32_t nodeToken(const Ast* ast, const NodeId node)
+{
+    return ast->mainTokens[node];
+}
+static inline NodeData nodeData(const Ast* ast, const NodeId node)
+{
+    return ast->data[node];
+}
+static inline uint8_t nodeFlags(const Ast* ast, const NodeId node)
+{
+    return ast->flags[node];
+}
+static inline void setNodeFlags(Ast* ast, const NodeId node, const uint8_t flags)
+{
+    ast->flags[node] = flags;
+}
+//Helpers to read a NODE_CONSTANT: integers are int64_t (signed and untyped) or uint64_t bits,
+//floats are double bits (already rounded to float for f32) and bools are 0 or 1
+static inline uint64_t constantBits(const Ast* ast, const NodeId node)
+{
+    return (uint64_t)ast->data[node].lhs | ((uint64_t)ast->data[node].rhs << 32);
+}
+static inline TypeKind constantType(const Ast* ast, const NodeId node)
+{
+    return (TypeKind)(ast->flags[node] & NODE_CONSTANT_TYPE_MASK);
+}
+//Helper to read a word of extra data, e.g. the 'else' branch of an if is extraWord(ast, rhs + 1)
+static inline uint32_t extraWord(const Ast* ast, const uint32_t index)
+{
+    return ast->extra[index];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //AST_H
@@ -0,0 +1,201 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef COMMON_H
+#define COMMON_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Macro to compute the next capacity of a growing array
+#define GROW_CAPACITY(capacity) ((capacity) < 8 ? 8 : (capacity) * 2)
+
+//Function to resize a heap array to 'capacity' elements, running out of memory is fatal like in readFile
+static inline void* growArray(void* array, const int capacity, const size_t elementSize)
+{
+    void* grown = realloc(array, (size_t)capacity * elementSize);
+    if (grown == NULL)
+    {
+        fprintf(stderr, "Not enough memory to grow an array to %d elements\n", capacity);
+        exit(74);
+    }
+    return grown;
+}
+
+//-------------------------------------------------
+//Arena allocator
+//-------------------------------------------------
+//Every frontend allocation of a compilation unit (tokens, AST, types, runtime
+//values) is bumped out of one arena and released together with freeArena().
+//See docs/memory_management.md for the ownership rules.
+
+//Alignment of every arena allocation, enough for any scalar type Lyka uses
+#define ARENA_ALIGNMENT 16
+//Size of the first block, later blocks double in size up to ARENA_MAX_BLOCK_SIZE
+#define ARENA_MIN_BLOCK_SIZE (64 * 1024)
+#define ARENA_MAX_BLOCK_SIZE (64 * 1024 * 1024)
+
+//Struct to hold one block of arena memory, the usable bytes follow the header
+typedef struct ArenaBlock
+{
+    struct ArenaBlock* next;
+    size_t capacity; //Usable bytes after the header
+    size_t used;
+} ArenaBlock;
+
+//Header size rounded up so the first allocation of a block is aligned
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+//Struct to hold an arena and its allocation statistics
+typedef struct
+{
+    ArenaBlock* head;      //Block currently being bumped into
+    size_t nextBlockSize;  //Capacity of the next regular block
+    size_t bytesAllocated; //Bytes handed out since the last reset
+    size_t peakBytes;      //Highest bytesAllocated ever reached
+    size_t bytesReserved;  //Bytes currently held from the system, headers included
+    int blockCount;
+} Arena;
+
+//Function to initialize an empty arena, no memory is taken until the first allocation
+static inline void initArena(Arena* arena)
+{
+    arena->head = NULL;
+    arena->nextBlockSize = ARENA_MIN_BLOCK_SIZE;
+    arena->bytesAllocated = 0;
+    arena->peakBytes = 0;
+    arena->bytesReserved = 0;
+    arena->blockCount = 0;
+}
+
+//Helper to take a new block from the system, running out of memory is fatal
+static inline ArenaBlock* arenaNewBlock(Arena* arena, const size_t capacity)
+{
+    ArenaBlock* block = (ArenaBlock*)malloc(ARENA_HEADER_SIZE + capacity);
+    if (block == NULL)
+    {
+        fprintf(stderr, "Not enough memory (arena block of %zu bytes)\n", capacity);
+        exit(74);
+    }
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    arena->bytesReserved += ARENA_HEADER_SIZE + capacity;
+    arena->blockCount++;
+    return block;
+}
+
+//Helper for the slow path of arenaAlloc, when the head block is full
+static inline void* arenaAllocSlow(Arena* arena, const size_t size)
+{
+    //Oversized requests get a block of their own behind the head, so the head keeps filling up
+    if (size > arena->nextBlockSize / 4 && arena->head != NULL)
+    {
+        ArenaBlock* block = arenaNewBlock(arena, size);
+        block->used = size;
+        block->next = arena->head->next;
+        arena->head->next = block;
+        return (unsigned char*)block + ARENA_HEADER_SIZE;
+    }
+    size_t capacity = arena->nextBlockSize;
+    while (capacity < size) capacity *= 2;
+    if (arena->nextBlockSize < ARENA_MAX_BLOCK_SIZE) arena->nextBlockSize *= 2;
+
+    ArenaBlock* block = arenaNewBlock(arena, capacity);
+    block->used = size;
+    block->next = arena->head;
+    arena->head = block;
+    return (unsigned char*)block + ARENA_HEADER_SIZE;
+}
+
+//Function to allocate 'size' bytes from the arena, the memory is not zeroed
+static inline void* arenaAlloc(Arena* arena, size_t size)
+{
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    arena->bytesAllocated += size;
+    if (arena->bytesAllocated > arena->peakBytes) arena->peakBytes = arena->bytesAllocated;
+
+    ArenaBlock* block = arena->head;
+    if (block != NULL && block->capacity - block->used >= size)
+    {
+        void* memory = (unsigned char*)block + ARENA_HEADER_SIZE + block->used;
+        block->used += size;
+        return memory;
+    }
+    return arenaAllocSlow(arena, size);
+}
+
+//Function to allocate 'count' elements of 'size' bytes, the memory is not zeroed
+static inline void* arenaAllocArray(Arena* arena, const size_t count, const size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+    {
+        fprintf(stderr, "Arena allocation of %zu x %zu bytes overflows\n", count, size);
+        exit(74);
+    }
+    return arenaAlloc(arena, count * size);
+}
+
+//Function to allocate zeroed memory for 'count' elements of 'size' bytes
+static inline void* arenaAllocZeroed(Arena* arena, const size_t count, const size_t size)
+{
+    void* memory = arenaAllocArray(arena, count, size);
+    memset(memory, 0, count * size);
+    return memory;
+}
+
+//Function to copy 'length' bytes into the arena as a '\0' terminated string
+static inline char* arenaCopyString(Arena* arena, const char* chars, const size_t length)
+{
+    char* copy = (char*)arenaAlloc(arena, length + 1);
+    memcpy(copy, chars, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+//Function to drop every allocation but keep the newest regular block for reuse, statistics keep their peak
+static inline void resetArena(Arena* arena)
+{
+    //Regular blocks only ever grow, so the head is the largest of them. Oversized blocks sit
+    //behind it and can be bigger still, they are freed since they were sized for one request
+    ArenaBlock* keep = arena->head;
+    if (keep != NULL)
+    {
+        ArenaBlock* block = keep->next;
+        while (block != NULL)
+        {
+            ArenaBlock* next = block->next;
+            arena->bytesReserved -= ARENA_HEADER_SIZE + block->capacity;
+            arena->blockCount--;
+            free(block);
+            block = next;
+        }
+        keep->next = NULL;
+        keep->used = 0;
+    }
+    arena->bytesAllocated = 0;
+}
+
+//Function to release an arena and every allocation made from it
+static inline void freeArena(Arena* arena)
+{
+    //Blocks grow geometrically, so this frees a handful of blocks, not one object at a time
+    ArenaBlock* block = arena->head;
+    while (block != NULL)
+    {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    initArena(arena);
+}
+
+//Macro to allocate one object of a type from an arena
+#define ARENA_NEW(arena, type) ((type*)arenaAlloc((arena), sizeof(type)))
+//Macro to allocate an array of a type from an arena
+#define ARENA_ARRAY(arena, type, count) ((type*)arenaAllocArray((arena), (size_t)(count), sizeof(type)))
+
+#endif //COMMON_H
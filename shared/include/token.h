@@ -3,6 +3,10 @@
 //
 #ifndef TOKEN_H
 #define TOKEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
 //Enum to hold all the token types
 typedef enum
 {
@@ -45,9 +49,66 @@ typedef enum
 typedef struct
 {
     TokenType token;
+    uint32_t symbol;   //Interned id of identifiers and string literals, 0 when not interned
     const char* start;
     int length;
     int line;
 } Token;
+//Struct to hold the decoded value of a number literal
+typedef struct
+{
+    bool isFloat;
+    bool overflow;   //Does not fit in 64 bits (integers) or in a double (floats)
+    union
+    {
+        uint64_t integer;
+        double real;
+    } as;
+} LiteralValue;
+//Struct to hold the value of a number token inside a token buffer
+typedef struct
+{
+    int index;           //Token the value belongs to
+    LiteralValue value;
+} TokenLiteral;
+//Struct to hold the message of an error token inside a token buffer
+typedef struct
+{
+    int index;           //Token the message belongs to
+    const char* message;
+} TokenError;
+//Struct to hold the decoded length of a string token with escape sequences inside a token buffer
+typedef struct
+{
+    int index;           //Token the length belongs to
+    int decodedLength;
+} TokenString;
+//Struct to hold a whole token stream as parallel arrays (EOF included)
+typedef struct
+{
+    const char* source;   //Buffer every offset points into
+    uint8_t* kinds;       //TokenType of each token
+    uint32_t* offsets;    //Start of each lexeme, relative to 'source'
+    uint32_t* lengths;    //Length of each lexeme in bytes
+    uint32_t* symbols;    //Interned id of each token, only filled when 'interns' is set
+    struct InternTable* interns; //Optional table identifiers and string literals are interned into
+    int count;
+    int capacity;
+    //Error tokens keep their source span above, their messages are kept here
+    TokenError* errors;
+    int errorCount;
+    int errorCapacity;
+    //Values of the number tokens, decoded once while lexing
+    TokenLiteral* literals;
+    int literalCount;
+    int literalCapacity;
+    //Decoded lengths of the string tokens with escapes, any other string decodes to its contents as written
+    TokenString* escapedStrings;
+    int escapedCount;
+    int escapedCapacity;
+    //Offsets where each line starts, built on the first line lookup
+    uint32_t* lineStarts;
+    int lineCount;
+} TokenBuffer;
 
 #endif //TOKEN_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef TYPES_H
+#define TYPES_H
+
+#include "token.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Enum to hold the built-in Lyka types
+typedef enum
+{
+    TYPE_VOID, TYPE_BOOL, TYPE_CHAR, TYPE_STRING,
+    //Signed integers
+    TYPE_I8, TYPE_I16, TYPE_I32, TYPE_I64,
+    //Unsigned integers
+    TYPE_U8, TYPE_U16, TYPE_U32, TYPE_U64,
+    //Floating point
+    TYPE_F32, TYPE_F64,
+    TYPE_NULL,
+    TYPE_ERROR //Not a type keyword
+} TypeKind;
+
+//Helper to check for i8..i64
+static inline bool isSignedType(const TypeKind type)
+{
+    return type >= TYPE_I8 && type <= TYPE_I64;
+}
+//Helper to check for u8..u64
+static inline bool isUnsignedType(const TypeKind type)
+{
+    return type >= TYPE_U8 && type <= TYPE_U64;
+}
+//Helper to check for any integer type
+static inline bool isIntegerType(const TypeKind type)
+{
+    return type >= TYPE_I8 && type <= TYPE_U64;
+}
+//Helper to check for f32 and f64
+static inline bool isFloatType(const TypeKind type)
+{
+    return type == TYPE_F32 || type == TYPE_F64;
+}
+//Helper to get the width of a numeric type in bits, 0 for everything else
+static inline int typeBits(const TypeKind type)
+{
+    switch (type)
+    {
+    case TYPE_I8: case TYPE_U8: return 8;
+    case TYPE_I16: case TYPE_U16: return 16;
+    case TYPE_I32: case TYPE_U32: case TYPE_F32: return 32;
+    case TYPE_I64: case TYPE_U64: case TYPE_F64: return 64;
+    default: return 0;
+    }
+}
+//Helper to map a type keyword token to its type
+static inline TypeKind typeFromToken(const TokenType token)
+{
+    switch (token)
+    {
+    case TOKEN_I8: return TYPE_I8;
+    case TOKEN_I16: return TYPE_I16;
+    case TOKEN_I32: return TYPE_I32;
+    case TOKEN_I64: return TYPE_I64;
+    case TOKEN_U8: return TYPE_U8;
+    case TOKEN_U16: return TYPE_U16;
+    case TOKEN_U32: return TYPE_U32;
+    case TOKEN_U64: return TYPE_U64;
+    case TOKEN_F32: return TYPE_F32;
+    case TOKEN_F64: return TYPE_F64;
+    case TOKEN_CHAR: return TYPE_CHAR;
+    case TOKEN_STRING: return TYPE_STRING;
+    case TOKEN_BOOL: return TYPE_BOOL;
+    case TOKEN_VOID: return TYPE_VOID;
+    case TOKEN_NULL: return TYPE_NULL;
+    default: return TYPE_ERROR;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TYPES_H
@@ -0,0 +1,114 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "intern.h"
+#include <string.h>
+
+//Hash set is grown once it is three quarters full
+#define INTERN_MAX_LOAD_NUM 3
+#define INTERN_MAX_LOAD_DEN 4
+
+//Helper to hash a string (FNV-1a)
+static uint32_t hashString(const char* chars, const int length)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t)chars[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//Function to initialize an empty intern table
+void initInternTable(InternTable* table)
+{
+    initArena(&table->strings);
+    table->capacity = GROW_CAPACITY(0);
+    table->symbols = growArray(NULL, table->capacity, sizeof(Symbol));
+    table->count = 1; //SYMBOL_NONE takes slot 0
+    table->slots = NULL;
+    table->slotCapacity = 0;
+    table->symbols[SYMBOL_NONE].chars = "";
+    table->symbols[SYMBOL_NONE].length = 0;
+    table->symbols[SYMBOL_NONE].hash = 0;
+}
+
+//Function to release an intern table and every string in it
+void freeInternTable(InternTable* table)
+{
+    freeArena(&table->strings);
+    free(table->symbols);
+    free(table->slots);
+    table->symbols = NULL;
+    table->slots = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->slotCapacity = 0;
+}
+
+//Function to empty an intern table but keep its memory for the next source
+void resetInternTable(InternTable* table)
+{
+    resetArena(&table->strings);
+    table->count = 1;
+    if (table->slots != NULL) memset(table->slots, 0, (size_t)table->slotCapacity * sizeof(SymbolId));
+}
+
+//Helper to rebuild the hash set with a new capacity
+static void resizeSlots(InternTable* table, const int slotCapacity)
+{
+    SymbolId* slots = calloc((size_t)slotCapacity, sizeof(SymbolId));
+    if (slots == NULL)
+    {
+        fprintf(stderr, "Not enough memory to grow the intern table\n");
+        exit(74);
+    }
+    const uint32_t mask = (uint32_t)slotCapacity - 1;
+    for (int id = 1; id < table->count; id++)
+    {
+        uint32_t index = table->symbols[id].hash & mask;
+        while (slots[index] != SYMBOL_NONE)
+        {
+            index = (index + 1) & mask;
+        }
+        slots[index] = (SymbolId)id;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slotCapacity = slotCapacity;
+}
+
+//Function to get the id of a string, adding a copy of it the first time it is seen
+SymbolId internString(InternTable* table, const char* chars, const int length)
+{
+    if ((table->count + 1) * INTERN_MAX_LOAD_DEN > table->slotCapacity * INTERN_MAX_LOAD_NUM)
+    {
+        resizeSlots(table, table->slotCapacity < 64 ? 64 : table->slotCapacity * 2);
+    }
+    const uint32_t hash = hashString(chars, length);
+    const uint32_t mask = (uint32_t)table->slotCapacity - 1;
+    uint32_t index = hash & mask;
+    //Linear probing, the stored hash rejects almost every mismatch before memcmp runs
+    while (table->slots[index] != SYMBOL_NONE)
+    {
+        const Symbol* symbol = &table->symbols[table->slots[index]];
+        if (symbol->hash == hash && symbol->length == length && memcmp(symbol->chars, chars, (size_t)length) == 0)
+        {
+            return table->slots[index];
+        }
+        index = (index + 1) & mask;
+    }
+
+    if (table->count == table->capacity)
+    {
+        table->capacity = GROW_CAPACITY(table->capacity);
+        table->symbols = growArray(table->symbols, table->capacity, sizeof(Symbol));
+    }
+    const SymbolId id = (SymbolId)table->count++;
+    table->symbols[id].chars = arenaCopyString(&table->strings, chars, (size_t)length);
+    table->symbols[id].length = length;
+    table->symbols[id].hash = hash;
+    table->slots[index] = id;
+    return id;
+}
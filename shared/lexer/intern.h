@@ -0,0 +1,55 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "common.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Id of an interned string, equal text always gets the same id. 0 means "not interned"
+typedef uint32_t SymbolId;
+#define SYMBOL_NONE ((SymbolId)0)
+
+//Struct to hold one interned string
+typedef struct
+{
+    const char* chars; //'\0' terminated copy owned by the table
+    int length;
+    uint32_t hash;
+} Symbol;
+
+//Struct to hold an intern table. A table is not thread safe, give each scanner thread its own
+typedef struct InternTable
+{
+    Arena strings;     //Copies of the interned text
+    Symbol* symbols;   //Indexed by SymbolId, slot 0 is unused
+    int count;
+    int capacity;
+    SymbolId* slots;   //Open addressing hash set of ids, SYMBOL_NONE marks an empty slot
+    int slotCapacity;  //Always a power of two
+} InternTable;
+
+//Function to initialize an empty intern table
+void initInternTable(InternTable* table);
+//Function to release an intern table and every string in it
+void freeInternTable(InternTable* table);
+//Function to empty an intern table but keep its memory for the next source
+void resetInternTable(InternTable* table);
+//Function to get the id of a string, adding a copy of it the first time it is seen
+SymbolId internString(InternTable* table, const char* chars, int length);
+//Function to get the interned string behind an id
+static inline const Symbol* symbolAt(const InternTable* table, const SymbolId id)
+{
+    return &table->symbols[id];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //INTERN_H
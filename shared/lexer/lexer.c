@@ -2,511 +2,1007 @@
 //Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
 //
 #include "lexer.h"
+#include "common.h"
+#include "intern.h"
+#include "literal.h"
+#include "parallel_lex.h"
+#include "precompiled.h"
+#include "simd_scan.h"
+#include "source.h"
 #include "token.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
-//struct to iterate through the source code
-typedef struct
+//Tokens are returned by value on every scan, escape data of strings lives in TokenBuffer.escapedStrings instead
+_Static_assert(sizeof(void*) != 8 || sizeof(Token) == 24, "Token no longer fits in 24 bytes");
+//Default instance used by the free-function wrappers
+static Scanner globalScanner;
+//Function to initialize a scanner
+void scannerInit(Scanner* scanner, const char* source)
 {
-    const char* start;
-    const char* current;
-    int line;
-} Scanner;
-//Instance created
-Scanner scanner;
-//Function to initialize our scanner
-void initScanner(const char* source)
-{
-    scanner.start = source;
-    scanner.current = source;
-    scanner.line = 1;
+    scanner->start = source;
+    scanner->current = source;
+    scanner->line = 1;
+    scanner->interns = NULL;
+    scanner->escapes = 0;
 }
 //Function that checks if we read the complete file or not
-bool isAtEnd(void)
+bool scannerIsAtEnd(const Scanner* scanner)
 {
-    if (*scanner.current == '\0')
+    if (*scanner->current == '\0')
     {
         return true;
     }
     return false;
 }
 //Function that moves the pointer 'current' forward
-char advance(void)
+char scannerAdvance(Scanner* scanner)
 {
-    if (isAtEnd()) return '\0';
-    return *scanner.current++;
+    if (scannerIsAtEnd(scanner)) return '\0';
+    return *scanner->current++;
 }
 //Function to check the next character
-char peek(void)
+char scannerPeek(const Scanner* scanner)
 {
-    return *scanner.current;
+    return *scanner->current;
 }
 //Function to check the second next character
-char peekNext(void)
+char scannerPeekNext(const Scanner* scanner)
 {
-    if (*scanner.current == '\0' && scanner.current[1] == '\0')
+    if (*scanner->current == '\0' && scanner->current[1] == '\0')
     {
         return '\0';
     }
-    return scanner.current[1];
+    return scanner->current[1];
 }
 //Function to skip whitespace characters
-void skipWhitespace(void)
+void scannerSkipWhitespace(Scanner* scanner)
 {
     while (true)
     {
-        const char current_char = peek();
-
-        switch (current_char)
+        //Blank runs are skipped a block at a time, newlines are counted on the way
+        scanner->current = skipBlankRun(scanner->current, &scanner->line);
+        if (scannerPeek(scanner) != '/' || scannerPeekNext(scanner) != '/')
         {
-        case ' ':
-        case '\t':
-        case '\r':
-            advance();
-            break;
-        case '\n':
-            scanner.line++;
-            advance();
-            break;
-        case '/':
-            if (peekNext() == '/')
-            {
-                //Consumes the two '/' before entering loop
-                advance();
-                advance();
-                while (!isAtEnd() && peek() != '\n')
-                {
-                    advance();
-                }
-            } else
-            {
-                return;
-            }
-            break;
-        default:
             return;
         }
+        //Consumes the two '/' and jumps to the '\n' (or the end), which the next run then counts
+        scanner->current = findLineEnd(scanner->current + 2);
     }
 }
 //Function to create a token
-Token createToken(const TokenType token_type)
+Token scannerCreateToken(const Scanner* scanner, const TokenType token_type)
 {
     Token token;
     token.token = token_type;
-    token.start = scanner.start;
-    token.length = (int)(scanner.current - scanner.start);
-    token.line = scanner.line;
+    token.symbol = 0;
+    token.start = scanner->start;
+    token.length = (int)(scanner->current - scanner->start);
+    token.line = scanner->line;
     return token;
 }
 //Function for error reporting
-Token errorToken(const char* message)
+Token scannerErrorToken(const Scanner* scanner, const char* message)
 {
     Token token;
     token.token = TOKEN_ERROR;
+    token.symbol = 0;
     token.start = message;
     token.length = (int)strlen(message);
-    token.line = scanner.line;
+    token.line = scanner->line;
     return token;
 }
-//Function to read input file into a buffer
+//Function to read input file into a heap buffer owned by the caller (prefer loadSource, which avoids the copy)
 char *readFile(const char *path)
 {
-    //Opens the file
-    FILE* file = fopen(path , "rb");
-    //Checks if the file exists
-    if (file == NULL)
+    Source source = loadSource(path);
+    //Chunked reads already produced a heap buffer, hand it over as is
+    if (source.mapSize == 0)
     {
-        fprintf(stderr , "Could not open file \"%s\"\n",path);
-        exit(74);
+        return (char*)source.data;
     }
-    //Check the end of the file to get the size and check for errors
-    if (fseek(file, 0L, SEEK_END) != 0) {
-        fprintf(stderr, "Could not seek to end of file \"%s\"\n", path);
-        exit(74);
-    }
-    //fileSize contains the size of the file in long, as error can return -1
-    const long fileSize = ftell(file);
-    //Checks if fileSize is non-negative, means size is found without any error
-    if (fileSize < 0)
-    {
-        fprintf(stderr, "Could not determine size of file \"%s\"\n", path);
-        exit(74);
-    }
-    //fileSize(long) is being casted to size_t(unsigned int) for larger buffer
-    const size_t uFileSize = (size_t) fileSize;
-    rewind(file);
-    //Allocate memory for the buffer (+1 for the NULL terminator)
-    char* buffer = malloc(uFileSize + 1);
-    //Checks if allocation is successful
+    char* buffer = malloc(source.length + 1);
     if (buffer == NULL)
     {
         fprintf(stderr , "Not enough memory to read \"%s\"\n",path);
         exit(74);
     }
-    //Read bytes into the buffer
-    const size_t bytesRead = fread(buffer , sizeof(char) , uFileSize , file);
-    //Checks if reading was successful
-    if (bytesRead < uFileSize)
-    {
-        fprintf(stderr , "Could not read file \"%s\"\n",path);
-        exit(74);
-    }
-    //Null terminate the string
-    buffer[bytesRead] = '\0';
-    //Cleanup and return
-    fclose(file);
+    memcpy(buffer , source.data , source.length + 1);
+    freeSource(&source);
     return buffer;
-
 }
 //Helper function to evaluate conditional advances - '!=' , '=='
-bool match(const char expected)
+bool scannerMatch(Scanner* scanner, const char expected)
 {
-    if (isAtEnd()) return false;
-    if (*scanner.current != expected) return false;
-    scanner.current++;
+    if (scannerIsAtEnd(scanner)) return false;
+    if (*scanner->current != expected) return false;
+    scanner->current++;
     return true;
 }
+//Character classes used by the scanner
+#define CHAR_ALPHA 0x01
+#define CHAR_DIGIT 0x02
+#define A CHAR_ALPHA
+#define D CHAR_DIGIT
+//Class of every byte value, indexed by the unsigned character
+static const uint8_t charClass[256] =
+{
+    //0x00 - 0x0F
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    //0x10 - 0x1F
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    //0x20 - 0x2F
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    //0x30 - 0x3F : 0-9
+    D, D, D, D, D, D, D, D, D, D, 0, 0, 0, 0, 0, 0,
+    //0x40 - 0x4F : A-O
+    0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    //0x50 - 0x5F : P-Z, _
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, A,
+    //0x60 - 0x6F : a-o
+    0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    //0x70 - 0x7F : p-z
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, 0,
+    //0x80 - 0xFF : never part of an identifier
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+#undef A
+#undef D
 //Helper function to check if it is a digit
 bool isDigit(const char c)
 {
-    return c >= '0' && c <= '9';
+    return (charClass[(unsigned char)c] & CHAR_DIGIT) != 0;
 }
 //Helper function to check if it is an alphabet
 bool isAlpha(const char c)
 {
-    return (c >= 'a' && c <= 'z') ||
-           (c >= 'A' && c <= 'Z') ||
-               c == '_';
+    return (charClass[(unsigned char)c] & CHAR_ALPHA) != 0;
+}
+//Helper function to check if it can continue an identifier
+static bool isAlphaNumeric(const char c)
+{
+    return (charClass[(unsigned char)c] & (CHAR_ALPHA | CHAR_DIGIT)) != 0;
 }
 //Helper function to check if it is a character literal (Inside single quotes)
-static Token isCharLiteral(void)
+static Token isCharLiteral(Scanner* scanner)
 {
     // 1. Check for empty literal ''
-    if (peek() == '\'') {
-        return errorToken("Empty character literal.");
+    if (scannerPeek(scanner) == '\'') {
+        return scannerErrorToken(scanner, "Empty character literal.");
     }
 
     // 2. Handle Escape Sequence
-    if (peek() == '\\') {
-        advance(); // consume '\'
+    if (scannerPeek(scanner) == '\\') {
+        scannerAdvance(scanner); // consume '\'
 
-        const char escaped = peek();
+        const char escaped = scannerPeek(scanner);
         switch (escaped) {
         case '\'': case '"': case '\\': case 'n':
         case '{':  case '}': case 't':  case 'r': case '0':
-            advance(); // consume the valid escaped char
+            scannerAdvance(scanner); // consume the valid escaped char
             break;
         default:
-            return errorToken("Invalid escape sequence in character literal.");
+            return scannerErrorToken(scanner, "Invalid escape sequence in character literal.");
         }
     }
     // 3. Handle Regular Character
     else {
-        advance();
+        scannerAdvance(scanner);
     }
 
     // 4. Ensure it closes correctly immediately after the character
-    if (peek() != '\'') {
-        return errorToken("Character literal must contain exactly one character.");
+    if (scannerPeek(scanner) != '\'') {
+        return scannerErrorToken(scanner, "Character literal must contain exactly one character.");
     }
 
-    advance(); // Consume the closing '
-    return createToken(TOKEN_CHAR_LITERAL);
+    scannerAdvance(scanner); // Consume the closing '
+    return scannerCreateToken(scanner, TOKEN_CHAR_LITERAL);
 }
 //Helper function to check if it is a string literal (Inside double quotes)
-static Token isStringLiteral(void)
+static Token isStringLiteral(Scanner* scanner)
 {
-    while (peek() != '"' && !isAtEnd())
+    //Plain text is skipped a block at a time, only quotes, escapes, newlines and the end stop the scan
+    int escapes = 0;
+    while (true)
     {
+        scanner->current = findStringStop(scanner->current);
+        if (scannerPeek(scanner) == '"') break;
+        if (scannerIsAtEnd(scanner))
+        {
+            return scannerErrorToken(scanner, "Unterminated string");
+        }
         // If newline then line count is increased, thus allowing multiline string
-        if (peek() == '\n')
+        if (scannerAdvance(scanner) == '\n')
         {
-            scanner.line++;
+            scanner->line++;
+            continue;
         }
         // To check escape sequence
-        if (peek() == '\\')
+        if (scannerIsAtEnd(scanner))
         {
-            advance();
-            if (isAtEnd())
-            {
-                return errorToken("Unterminated string after escape.");
-            }
-            switch (peek())
-            {
-                // Specified escape character list
-            case '\'':
-            case '"':
-            case '\\':
-            case 'n':
-            case '{':
-            case '}':
-            case 't':
-            case 'r':
-            case '0':
-                advance(); // Valid escape sequence, consume the char
-                break;
-            default:
-                return errorToken("Invalid escape sequence.");
-            }
+            return scannerErrorToken(scanner, "Unterminated string after escape.");
         }
-        else
+        switch (scannerPeek(scanner))
         {
-            advance();
+            // Specified escape character list, each one decodes to a single byte
+        case '\'':
+        case '"':
+        case '\\':
+        case 'n':
+        case '{':
+        case '}':
+        case 't':
+        case 'r':
+        case '0':
+            scannerAdvance(scanner); // Valid escape sequence, consume the char
+            escapes++;
+            break;
+        default:
+            return scannerErrorToken(scanner, "Invalid escape sequence.");
         }
     }
-    if (isAtEnd())
+    //Consume the closing quote
+    scannerAdvance(scanner);
+    Token token = scannerCreateToken(scanner, TOKEN_STRING_LITERAL);
+    //Later stages allocate the decoded text once, or use the source bytes as they are without escapes
+    scanner->escapes = escapes;
+    //Literals are interned by their contents (quotes stripped, escapes left as written)
+    if (scanner->interns != NULL)
     {
-        return errorToken("Unterminated string");
+        token.symbol = internString(scanner->interns, token.start + 1, token.length - 2);
     }
-    //Consume the closing quote
-    advance();
-    return createToken(TOKEN_STRING_LITERAL);
+    return token;
 }
 //Helper function to check if it is a number literal (Integer literal of float literal)
-static Token isNumberLiteral(void)
+static Token isNumberLiteral(Scanner* scanner)
 {
     //Flag to check if an integer or float
     bool isFloat = false;
     //Consume digits
-    while (isDigit(peek()))
+    while (isDigit(scannerPeek(scanner)))
     {
-        advance();
+        scannerAdvance(scanner);
     }
     //If a dot is found and the next character is also a digit it is considered a float
-    if (peek() == '.' && isDigit(peekNext()))
+    if (scannerPeek(scanner) == '.' && isDigit(scannerPeekNext(scanner)))
     {
         isFloat = true;
-        advance();
-        while (isDigit(peek()))
+        scannerAdvance(scanner);
+        while (isDigit(scannerPeek(scanner)))
         {
-            advance();
+            scannerAdvance(scanner);
         }
     }
     //Create a token based on flag
-    return createToken(isFloat ? TOKEN_FLOAT_LITERAL : TOKEN_INT_LITERAL);
+    return scannerCreateToken(scanner, isFloat ? TOKEN_FLOAT_LITERAL : TOKEN_INT_LITERAL);
 }
 //Helper to check keyword
-TokenType checkKeyword(const int start ,const int length , const char* rest ,const TokenType type)
+TokenType scannerCheckKeyword(const Scanner* scanner, const int start ,const int length , const char* rest ,const TokenType type)
 {
-    if (scanner.current - scanner.start == start + length && memcmp(scanner.start + start , rest , length) == 0)
+    if (scanner->current - scanner->start == start + length && memcmp(scanner->start + start , rest , length) == 0)
     {
         return type;
     }
     return TOKEN_IDENTIFIER;
 }
+//Keywords are found with a perfect hash over (first char, second char, last char, length).
+//The multiplier was searched for so that every keyword lands in its own slot. The table
+//is laid out by the compiler from the same macro, so a keyword added later that collides
+//shows up as an overridden initializer (-Woverride-init) and needs a new multiplier.
+#define KEYWORD_MIN_LENGTH 2
+#define KEYWORD_MAX_LENGTH 8
+#define KEYWORD_SLOT_BITS 6
+#define KEYWORD_HASH(first, second, last, length) \
+    ((uint32_t)(((uint32_t)(unsigned char)(first) | (uint32_t)(unsigned char)(second) << 8 | \
+                 (uint32_t)(unsigned char)(last) << 16 | (uint32_t)(length) << 24) * UINT32_C(0x86CE563D)) >> \
+     (32 - KEYWORD_SLOT_BITS))
+//Struct to hold a keyword slot, empty slots have a length of 0
+typedef struct
+{
+    const char* text;
+    int length;
+    TokenType type;
+} Keyword;
+#define KEYWORD(first, second, last, length, text, type) \
+    [KEYWORD_HASH(first, second, last, length)] = { text, length, type }
+//Keyword table, indexed by KEYWORD_HASH
+static const Keyword keywords[1 << KEYWORD_SLOT_BITS] =
+{
+    KEYWORD('i', 'f', 'f', 2, "if", TOKEN_IF),
+    KEYWORD('e', 'l', 'e', 4, "else", TOKEN_ELSE),
+    KEYWORD('d', 'o', 'o', 2, "do", TOKEN_DO),
+    KEYWORD('w', 'h', 'e', 5, "while", TOKEN_WHILE),
+    KEYWORD('f', 'o', 'r', 3, "for", TOKEN_FOR),
+    KEYWORD('l', 'o', 'p', 4, "loop", TOKEN_LOOP),
+    KEYWORD('i', 'n', 'n', 2, "in", TOKEN_IN),
+    KEYWORD('b', 'r', 'k', 5, "break", TOKEN_BREAK),
+    KEYWORD('c', 'o', 'e', 8, "continue", TOKEN_CONTINUE),
+    KEYWORD('r', 'e', 'n', 6, "return", TOKEN_RETURN),
+    KEYWORD('f', 'n', 'n', 2, "fn", TOKEN_FN),
+    KEYWORD('c', 'o', 't', 5, "const", TOKEN_CONST),
+    KEYWORD('m', 'u', 't', 3, "mut", TOKEN_MUT),
+    KEYWORD('m', 'a', 'h', 5, "match", TOKEN_MATCH),
+    KEYWORD('t', 'r', 'e', 4, "true", TOKEN_TRUE),
+    KEYWORD('f', 'a', 'e', 5, "false", TOKEN_FALSE),
+    //Type keywords
+    KEYWORD('i', '8', '8', 2, "i8", TOKEN_I8),
+    KEYWORD('i', '1', '6', 3, "i16", TOKEN_I16),
+    KEYWORD('i', '3', '2', 3, "i32", TOKEN_I32),
+    KEYWORD('i', '6', '4', 3, "i64", TOKEN_I64),
+    KEYWORD('u', '8', '8', 2, "u8", TOKEN_U8),
+    KEYWORD('u', '1', '6', 3, "u16", TOKEN_U16),
+    KEYWORD('u', '3', '2', 3, "u32", TOKEN_U32),
+    KEYWORD('u', '6', '4', 3, "u64", TOKEN_U64),
+    KEYWORD('f', '3', '2', 3, "f32", TOKEN_F32),
+    KEYWORD('f', '6', '4', 3, "f64", TOKEN_F64),
+    KEYWORD('c', 'h', 'r', 4, "char", TOKEN_CHAR),
+    KEYWORD('s', 't', 'g', 6, "string", TOKEN_STRING),
+    KEYWORD('b', 'o', 'l', 4, "bool", TOKEN_BOOL),
+    KEYWORD('v', 'o', 'd', 4, "void", TOKEN_VOID),
+    KEYWORD('n', 'u', 'l', 4, "null", TOKEN_NULL),
+};
+#undef KEYWORD
 //Function to check the identifier type
-static TokenType identifierType(void)
+static TokenType identifierType(const Scanner* scanner)
 {
-    switch (scanner.start[0])
+    const int length = (int)(scanner->current - scanner->start);
+    if (length < KEYWORD_MIN_LENGTH || length > KEYWORD_MAX_LENGTH)
     {
-        //Check break and bool keyword
-    case 'b':
-        if (scanner.current > scanner.start - 1)
-        {
-            switch (scanner.start[1])
-            {
-            case 'o': return checkKeyword(2 , 2 , "ol" , TOKEN_BOOL);
-            case 'r': return checkKeyword(2 , 3 , "eak" , TOKEN_BREAK);
-            default: ;
-            }
-        }
-        break;
-        //Check char , const and continue keyword
-    case 'c':
-        if (scanner.current - scanner.start > 1)
-        {
-            switch (scanner.start[1])
-            {
-            case 'h': return checkKeyword(2 , 2 , "ar" , TOKEN_CHAR);
-            case 'o':
-                if (scanner.current - scanner.start > 2 && scanner.start[2] == 'n')
-                {
-                    if (scanner.current - scanner.start > 3)
-                    {
-                        switch (scanner.start[3])
-                        {
-                        case 's': return checkKeyword(4 , 1 , "t" , TOKEN_CONST);
-                        case 't': return checkKeyword(4 , 4 , "inue" , TOKEN_CONTINUE);
-                        default: ;
-                        }
-                    }
-                }
-                break;
-            default: ;
-            }
-        }
-        break;
-        //Check do
-    case 'd': return checkKeyword(1 , 1 , "o" , TOKEN_DO);
-        //Check else
-    case 'e': return checkKeyword(1 , 3 , "lse" , TOKEN_ELSE);
-        //Check false, fn, for, f32, and f64
-    case 'f':
-        if (scanner.current - scanner.start > 1)
-        {
-            switch (scanner.start[1])
-            {
-            case 'a': return checkKeyword(2 , 3 , "lse" , TOKEN_FALSE);
-            case 'n': return checkKeyword(2 , 0 , "" , TOKEN_FN);
-            case 'o': return checkKeyword(2 , 1 , "r" , TOKEN_FOR);
-            case '3': return checkKeyword(2 , 1 , "2" , TOKEN_F32);
-            case '6': return checkKeyword(2 , 1 , "4" , TOKEN_F64);
-            default: ;
-            }
-        }
-        break;
-        //Check if, in, i8, i16, i32, i64
-    case 'i':
-        if (scanner.current - scanner.start > 1)
-        {
-            switch (scanner.start[1])
-            {
-            case 'f': return checkKeyword(2 , 0 , "" , TOKEN_IF);
-            case 'n': return checkKeyword(2 , 0 , "" , TOKEN_IN);
-            case '8': return checkKeyword(2 , 0 , "" , TOKEN_I8);
-            case '1': return checkKeyword(2 , 1 , "6" , TOKEN_I16);
-            case '3': return checkKeyword(2 , 1 , "2" , TOKEN_I32);
-            case '6': return checkKeyword(2 , 1 , "4" , TOKEN_I64);
-            default: ;
-            }
-        }
-        break;
-        //Check loop
-    case 'l': return checkKeyword(1 , 3 , "oop" , TOKEN_LOOP);
-        //Check match and mut
-    case 'm':
-        if (scanner.current - scanner.start > 1)
-        {
-            switch (scanner.start[1])
-            {
-            case 'a': return checkKeyword(2 , 3 , "tch" , TOKEN_MATCH);
-            case 'u': return checkKeyword(2 , 1 , "t" , TOKEN_MUT);
-            default: ;
-            }
-        }
-        break;
-        //Check null
-    case 'n': return checkKeyword(1 , 3 , "ull" , TOKEN_NULL);
-        //Check return
-    case 'r': return checkKeyword(1 , 5 , "eturn" , TOKEN_RETURN);
-        //Check string
-    case 's': return checkKeyword(1 , 5 , "tring" , TOKEN_STRING);
-        //Check true
-    case 't': return checkKeyword(1 , 3 , "rue" , TOKEN_TRUE);
-        //Check u8, u16, u32, u64
-    case 'u':
-        if (scanner.current - scanner.start > 1)
-        {
-            switch (scanner.start[1])
-            {
-            case '8': return checkKeyword(2 , 0 , "" , TOKEN_U8);
-            case '1': return checkKeyword(2 , 1 , "6" , TOKEN_U16);
-            case '3': return checkKeyword(2 , 1 , "2" , TOKEN_U32);
-            case '6': return checkKeyword(2 , 1 , "4" , TOKEN_U64);
-            default: ;
-            }
-        }
-        break;
-        //Check void
-    case 'v': return checkKeyword(1 , 3 , "oid" , TOKEN_VOID);
-        //Check while
-    case 'w': return checkKeyword(1 , 4 , "hile" , TOKEN_WHILE);
-
-    default: ;
+        return TOKEN_IDENTIFIER;
+    }
+    //One probe, one compare: the slot either holds this exact keyword or it is an identifier
+    const Keyword* keyword = &keywords[KEYWORD_HASH(scanner->start[0], scanner->start[1],
+                                                    scanner->start[length - 1], length)];
+    if (keyword->length == length && memcmp(scanner->start, keyword->text, (size_t)length) == 0)
+    {
+        return keyword->type;
     }
     return TOKEN_IDENTIFIER;
 }
 //Helper function to check if it is an identifier (checks keywords as well)
-static Token isIdentifier(void)
+static Token isIdentifier(Scanner* scanner)
 {
-    while (isAlpha(peek()) || isDigit(peek()))
+    while (isAlphaNumeric(scannerPeek(scanner)))
     {
-        advance();
+        scannerAdvance(scanner);
     }
-    return createToken(identifierType());
+    Token token = scannerCreateToken(scanner, identifierType(scanner));
+    //Keywords are already identified by their type, only names need a symbol
+    if (token.token == TOKEN_IDENTIFIER && scanner->interns != NULL)
+    {
+        token.symbol = internString(scanner->interns, token.start, token.length);
+    }
+    return token;
 }
-//Function to evaluate tokens
-Token scanToken(void)
+//Function to evaluate the next token of a scanner
+Token scannerScanToken(Scanner* scanner)
 {
-    skipWhitespace();
-    scanner.start = scanner.current;
+    scannerSkipWhitespace(scanner);
+    scanner->start = scanner->current;
     //If the pointer hits '\0' the program stops
-    if (isAtEnd()) return createToken(TOKEN_EOF);
+    if (scannerIsAtEnd(scanner)) return scannerCreateToken(scanner, TOKEN_EOF);
 
-    const char c = advance();
+    const char c = scannerAdvance(scanner);
     switch (c) {
         // Single-character delimiters
-    case '(': return createToken(TOKEN_LEFT_PAREN);
-    case ')': return createToken(TOKEN_RIGHT_PAREN);
-    case '{': return createToken(TOKEN_LEFT_BRACE);
-    case '}': return createToken(TOKEN_RIGHT_BRACE);
-    case '[': return createToken(TOKEN_LEFT_BRACKET);
-    case ']': return createToken(TOKEN_RIGHT_BRACKET);
-    case ',': return createToken(TOKEN_COMMA);
-    case ':': return createToken(TOKEN_COLON);
-    case ';': return createToken(TOKEN_SEMICOLON);
-    case '?': return createToken(TOKEN_QUESTION);
-    case '.': return createToken(match('.') ? TOKEN_DOT_DOT : TOKEN_DOT);
+    case '(': return scannerCreateToken(scanner, TOKEN_LEFT_PAREN);
+    case ')': return scannerCreateToken(scanner, TOKEN_RIGHT_PAREN);
+    case '{': return scannerCreateToken(scanner, TOKEN_LEFT_BRACE);
+    case '}': return scannerCreateToken(scanner, TOKEN_RIGHT_BRACE);
+    case '[': return scannerCreateToken(scanner, TOKEN_LEFT_BRACKET);
+    case ']': return scannerCreateToken(scanner, TOKEN_RIGHT_BRACKET);
+    case ',': return scannerCreateToken(scanner, TOKEN_COMMA);
+    case ':': return scannerCreateToken(scanner, TOKEN_COLON);
+    case ';': return scannerCreateToken(scanner, TOKEN_SEMICOLON);
+    case '?': return scannerCreateToken(scanner, TOKEN_QUESTION);
+    case '.': return scannerCreateToken(scanner, scannerMatch(scanner, '.') ? TOKEN_DOT_DOT : TOKEN_DOT);
         // Arithmetic & Assignment Operators
-    case '+': return createToken(match('=') ? TOKEN_PLUS_EQUAL : TOKEN_PLUS);
-    case '*': return createToken(match('=') ? TOKEN_STAR_EQUAL : TOKEN_STAR);
-    case '/': return createToken(match('=') ? TOKEN_SLASH_EQUAL : TOKEN_SLASH);
-    case '%': return createToken(match('=') ? TOKEN_PERCENT_EQUAL : TOKEN_PERCENT);
+    case '+': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_PLUS_EQUAL : TOKEN_PLUS);
+    case '*': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_STAR_EQUAL : TOKEN_STAR);
+    case '/': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_SLASH_EQUAL : TOKEN_SLASH);
+    case '%': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_PERCENT_EQUAL : TOKEN_PERCENT);
         // Minus, Arrow, and Minus-Equal
-    case '-': return createToken(match('>') ? TOKEN_ARROW : match('=') ? TOKEN_MINUS_EQUAL : TOKEN_MINUS);
+    case '-': return scannerCreateToken(scanner, scannerMatch(scanner, '>') ? TOKEN_ARROW : scannerMatch(scanner, '=') ? TOKEN_MINUS_EQUAL : TOKEN_MINUS);
         // Comparison & Assignment
-    case '=': return createToken(match('=') ? TOKEN_EQUAL_EQUAL : TOKEN_EQUAL);
-    case '!': return createToken(match('=') ? TOKEN_BANG_EQUAL : TOKEN_BANG);
+    case '=': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_EQUAL_EQUAL : TOKEN_EQUAL);
+    case '!': return scannerCreateToken(scanner, scannerMatch(scanner, '=') ? TOKEN_BANG_EQUAL : TOKEN_BANG);
         //Less than, Less than equal, Left shift
-    case '<': return createToken(match('<') ? TOKEN_LEFT_SHIFT : (match('=') ? TOKEN_LESS_EQUAL : TOKEN_LESS));
+    case '<': return scannerCreateToken(scanner, scannerMatch(scanner, '<') ? TOKEN_LEFT_SHIFT : (scannerMatch(scanner, '=') ? TOKEN_LESS_EQUAL : TOKEN_LESS));
         //Greater than, Greater equal, Right shift
-    case '>': return createToken(match('>') ? TOKEN_RIGHT_SHIFT : (match('=') ? TOKEN_GREATER_EQUAL : TOKEN_GREATER));
-    case '&': return createToken(match('&') ? TOKEN_AND : TOKEN_BIT_AND);
-    case '|': return createToken(match('|') ? TOKEN_OR : TOKEN_BIT_OR);
-    case '^': return createToken(TOKEN_BIT_XOR);
-    case '~': return createToken(TOKEN_BIT_NOT);
+    case '>': return scannerCreateToken(scanner, scannerMatch(scanner, '>') ? TOKEN_RIGHT_SHIFT : (scannerMatch(scanner, '=') ? TOKEN_GREATER_EQUAL : TOKEN_GREATER));
+    case '&': return scannerCreateToken(scanner, scannerMatch(scanner, '&') ? TOKEN_AND : TOKEN_BIT_AND);
+    case '|': return scannerCreateToken(scanner, scannerMatch(scanner, '|') ? TOKEN_OR : TOKEN_BIT_OR);
+    case '^': return scannerCreateToken(scanner, TOKEN_BIT_XOR);
+    case '~': return scannerCreateToken(scanner, TOKEN_BIT_NOT);
 
     case '\'':
-        return isCharLiteral();
+        return isCharLiteral(scanner);
     case '"':
-        return isStringLiteral();
+        return isStringLiteral(scanner);
     default:
-        if (isDigit(c)) return isNumberLiteral();
-        if (isAlpha(c)) return isIdentifier();
-        return errorToken("Unexpected character.");
+        if (isDigit(c)) return isNumberLiteral(scanner);
+        if (isAlpha(c)) return isIdentifier(scanner);
+        return scannerErrorToken(scanner, "Unexpected character.");
     }
 }
-//Function to manage the process
-void runFile(const char* path)
+//Type tags of a token buffer are stored in a single byte
+_Static_assert(TOKEN_DOT_DOT <= UINT8_MAX, "TokenType no longer fits in a token buffer kind");
+//Helper to make room for 'capacity' tokens
+static void reserveTokens(TokenBuffer* buffer, const int capacity)
 {
-    //Read the file into source
-    const char* source = readFile(path);
-    //Initialize the scanner with the source
-    initScanner(source);
-    free((void*)source);
+    buffer->kinds = growArray(buffer->kinds, capacity, sizeof(uint8_t));
+    buffer->offsets = growArray(buffer->offsets, capacity, sizeof(uint32_t));
+    buffer->lengths = growArray(buffer->lengths, capacity, sizeof(uint32_t));
+    if (buffer->interns != NULL)
+    {
+        buffer->symbols = growArray(buffer->symbols, capacity, sizeof(uint32_t));
+    }
+    buffer->capacity = capacity;
 }
-
-int main(const int argc , char *argv[])
+//Function to initialize an empty token buffer
+void initTokenBuffer(TokenBuffer* buffer)
+{
+    memset(buffer, 0, sizeof(TokenBuffer));
+}
+//Function to release a token buffer
+void freeTokenBuffer(TokenBuffer* buffer)
+{
+    free(buffer->kinds);
+    free(buffer->offsets);
+    free(buffer->lengths);
+    free(buffer->symbols);
+    free(buffer->errors);
+    free(buffer->literals);
+    free(buffer->escapedStrings);
+    free(buffer->lineStarts);
+    initTokenBuffer(buffer);
+}
+//Function to append the token a scanner just produced to a token buffer
+void recordToken(TokenBuffer* buffer, const Scanner* scanner, const Token* token)
 {
-    if (argc == 1)
+    if ((size_t)(scanner->current - buffer->source) > UINT32_MAX)
+    {
+        fprintf(stderr, "Source is too large for a token buffer\n");
+        exit(74);
+    }
+    if (buffer->count == buffer->capacity)
+    {
+        reserveTokens(buffer, GROW_CAPACITY(buffer->capacity));
+    }
+    const int index = buffer->count++;
+    buffer->kinds[index] = (uint8_t)token->token;
+    if (buffer->interns != NULL)
+    {
+        buffer->symbols[index] = token->symbol;
+    }
+    if (token->token == TOKEN_ERROR)
+    {
+        //Error tokens point at their message, the buffer keeps the offending span instead
+        buffer->offsets[index] = (uint32_t)(scanner->start - buffer->source);
+        buffer->lengths[index] = (uint32_t)(scanner->current - scanner->start);
+        if (buffer->errorCount == buffer->errorCapacity)
+        {
+            buffer->errorCapacity = GROW_CAPACITY(buffer->errorCapacity);
+            buffer->errors = growArray(buffer->errors, buffer->errorCapacity, sizeof(TokenError));
+        }
+        buffer->errors[buffer->errorCount].index = index;
+        buffer->errors[buffer->errorCount].message = token->start;
+        buffer->errorCount++;
+    }
+    else
+    {
+        buffer->offsets[index] = (uint32_t)(token->start - buffer->source);
+        buffer->lengths[index] = (uint32_t)token->length;
+    }
+    if (token->token == TOKEN_INT_LITERAL || token->token == TOKEN_FLOAT_LITERAL)
+    {
+        //Decode while the digits are still in cache, consumers never re-parse them
+        if (buffer->literalCount == buffer->literalCapacity)
+        {
+            buffer->literalCapacity = GROW_CAPACITY(buffer->literalCapacity);
+            buffer->literals = growArray(buffer->literals, buffer->literalCapacity, sizeof(TokenLiteral));
+        }
+        buffer->literals[buffer->literalCount].index = index;
+        buffer->literals[buffer->literalCount].value = tokenNumberValue(token);
+        buffer->literalCount++;
+    }
+    else if (token->token == TOKEN_STRING_LITERAL && scanner->escapes > 0)
     {
-        printf("No input file provided.\n");
-        printf("Usage: %s <file.lk>\n" , argv[0]);
-        printf("Program terminated.\n");
+        if (buffer->escapedCount == buffer->escapedCapacity)
+        {
+            buffer->escapedCapacity = GROW_CAPACITY(buffer->escapedCapacity);
+            buffer->escapedStrings = growArray(buffer->escapedStrings, buffer->escapedCapacity, sizeof(TokenString));
+        }
+        buffer->escapedStrings[buffer->escapedCount].index = index;
+        buffer->escapedStrings[buffer->escapedCount].decodedLength = token->length - 2 - scanner->escapes;
+        buffer->escapedCount++;
     }
-    else if (argc == 2)
+}
+//Function to lex a whole source into a token buffer ('lengthHint' only sizes the arrays, 0 if unknown)
+int tokenizeAll(TokenBuffer* buffer, const char* source, const size_t lengthHint)
+{
+    buffer->source = source;
+    buffer->count = 0;
+    buffer->errorCount = 0;
+    buffer->literalCount = 0;
+    buffer->escapedCount = 0;
+    buffer->lineCount = 0;
+    //Lyka code averages roughly one token every four bytes
+    if (lengthHint / 4 + 1 > (size_t)buffer->capacity)
     {
-        runFile(argv[1]);
+        if (lengthHint / 4 + 1 > INT32_MAX)
+        {
+            fprintf(stderr, "Source is too large for a token buffer\n");
+            exit(74);
+        }
+        reserveTokens(buffer, (int)(lengthHint / 4 + 1));
     }
-    else if (argc > 2)
+    //Interning may have been switched on after the arrays were sized
+    if (buffer->interns != NULL && buffer->capacity > 0)
     {
-        printf("Too many arguments.\n");
-        printf("Usage: %s <file.lk>\n" , argv[0]);
-        printf("Program terminated.\n");
+        buffer->symbols = growArray(buffer->symbols, buffer->capacity, sizeof(uint32_t));
     }
 
-    return 0;
+    Scanner scanner;
+    scannerInit(&scanner, source);
+    scanner.interns = buffer->interns;
+    while (true)
+    {
+        const Token token = scannerScanToken(&scanner);
+        recordToken(buffer, &scanner, &token);
+        if (token.token == TOKEN_EOF) break;
+    }
+    return buffer->count;
+}
+//Helper to record where every line of the buffer's source starts
+static void buildLineTable(TokenBuffer* buffer)
+{
+    const char* source = buffer->source;
+    const char* end = source + buffer->offsets[buffer->count - 1];
+    int capacity = GROW_CAPACITY(0);
+    buffer->lineStarts = growArray(buffer->lineStarts, capacity, sizeof(uint32_t));
+    buffer->lineStarts[0] = 0;
+    buffer->lineCount = 1;
+    for (const char* newline = memchr(source, '\n', (size_t)(end - source));
+         newline != NULL;
+         newline = memchr(newline + 1, '\n', (size_t)(end - newline - 1)))
+    {
+        if (buffer->lineCount == capacity)
+        {
+            capacity = GROW_CAPACITY(capacity);
+            buffer->lineStarts = growArray(buffer->lineStarts, capacity, sizeof(uint32_t));
+        }
+        buffer->lineStarts[buffer->lineCount++] = (uint32_t)(newline + 1 - source);
+    }
 }
+//Function to get the line a token starts on, the line table is built on first use
+int tokenLine(TokenBuffer* buffer, const int index)
+{
+    if (buffer->lineCount == 0)
+    {
+        buildLineTable(buffer);
+    }
+    //Find the last line starting at or before the token
+    const uint32_t offset = buffer->offsets[index];
+    int low = 0;
+    int high = buffer->lineCount - 1;
+    while (low < high)
+    {
+        const int middle = low + (high - low + 1) / 2;
+        if (buffer->lineStarts[middle] <= offset)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return low + 1;
+}
+//The scanner decides where a token ends by looking at most this many bytes past it ("1." then a digit)
+#define RELEX_LOOKAHEAD 2
+//Helper to replace the entries of tokens [first, next) of an index-sorted side list (errors,
+//literals or escaped strings) with 'added' (indexed from 0), shifting the indices of later entries by 'shift'
+static void spliceIndexedList(void** list, int* count, int* capacity, const size_t size,
+                              const void* added, const int addedCount, const int first, const int next, const int shift)
+{
+    //Every entry type starts with the index of its token
+    char* entries = *list;
+    int low = 0;
+    int end = *count;
+    while (low < end)
+    {
+        const int middle = low + (end - low) / 2;
+        if (*(const int*)(entries + (size_t)middle * size) < first) low = middle + 1;
+        else end = middle;
+    }
+    int high = low;
+    while (high < *count && *(const int*)(entries + (size_t)high * size) < next) high++;
+    const int newCount = *count - (high - low) + addedCount;
+    if (newCount > *capacity)
+    {
+        *capacity = newCount > GROW_CAPACITY(*capacity) ? newCount : GROW_CAPACITY(*capacity);
+        entries = growArray(entries, *capacity, size);
+        *list = entries;
+    }
+    if (addedCount != high - low)
+    {
+        memmove(entries + (size_t)(low + addedCount) * size, entries + (size_t)high * size, (size_t)(*count - high) * size);
+    }
+    if (shift != 0)
+    {
+        for (int i = low + addedCount; i < newCount; i++) *(int*)(entries + (size_t)i * size) += shift;
+    }
+    for (int i = 0; i < addedCount; i++)
+    {
+        memcpy(entries + (size_t)(low + i) * size, (const char*)added + (size_t)i * size, size);
+        *(int*)(entries + (size_t)(low + i) * size) += first;
+    }
+    *count = newCount;
+}
+//Helper to update a built line table for an edit, only the newlines of the inserted text are scanned
+static void spliceLineTable(TokenBuffer* buffer, const uint32_t editStart, const uint32_t removedLength,
+                            const uint32_t insertedLength)
+{
+    //Lines starting inside the removed text (just after one of its newlines) are gone
+    int low = 0;
+    int end = buffer->lineCount;
+    while (low < end)
+    {
+        const int middle = low + (end - low) / 2;
+        if (buffer->lineStarts[middle] <= editStart) low = middle + 1;
+        else end = middle;
+    }
+    int high = low;
+    while (high < buffer->lineCount && buffer->lineStarts[high] <= editStart + removedLength) high++;
+    int added = 0;
+    for (const char* c = buffer->source + editStart; c < buffer->source + editStart + insertedLength; c++) added += *c == '\n';
+    const int newCount = buffer->lineCount - (high - low) + added;
+    //The table is only ever grown to its exact size, so track it by lineCount
+    if (newCount > buffer->lineCount) buffer->lineStarts = growArray(buffer->lineStarts, newCount, sizeof(uint32_t));
+    memmove(buffer->lineStarts + low + added, buffer->lineStarts + high, (size_t)(buffer->lineCount - high) * sizeof(uint32_t));
+    const uint32_t delta = insertedLength - removedLength;
+    for (int i = low + added; i < newCount; i++) buffer->lineStarts[i] += delta;
+    int line = low;
+    for (const char* c = buffer->source + editStart; c < buffer->source + editStart + insertedLength; c++)
+    {
+        if (*c == '\n') buffer->lineStarts[line++] = (uint32_t)(c + 1 - buffer->source);
+    }
+    buffer->lineCount = newCount;
+}
+//Function to update a token buffer after an edit, only the tokens around the edit are re-lexed
+TokenSplice relexTokens(TokenBuffer* buffer, const char* source, const uint32_t editStart,
+                        const uint32_t removedLength, const uint32_t insertedLength)
+{
+    TokenSplice splice;
+    const uint32_t oldEnd = buffer->count > 0 ? buffer->offsets[buffer->count - 1] : 0;
+    //Without a complete old stream (or with an edit outside of it) there is nothing to keep
+    if (buffer->count == 0 || buffer->kinds[buffer->count - 1] != TOKEN_EOF ||
+        editStart > oldEnd || removedLength > oldEnd - editStart ||
+        (uint64_t)oldEnd - removedLength + insertedLength > UINT32_MAX)
+    {
+        splice.first = 0;
+        splice.removed = buffer->count;
+        splice.inserted = tokenizeAll(buffer, source, 0);
+        return splice;
+    }
+
+    //Lyka has no block comments or lexer modes, so the start of any token is a safe resync point:
+    //scanning from there only depends on the bytes that follow. The last token that ends (with its
+    //lookahead) before the edit stays, re-lexing starts right after it
+    int first = 0;
+    int high = buffer->count - 1;
+    while (first < high)
+    {
+        const int middle = first + (high - first) / 2;
+        if (buffer->offsets[middle] + buffer->lengths[middle] + RELEX_LOOKAHEAD <= editStart) first = middle + 1;
+        else high = middle;
+    }
+    const uint32_t resume = first > 0 ? buffer->offsets[first - 1] + buffer->lengths[first - 1] : 0;
+    const uint32_t newEditEnd = editStart + insertedLength;
+    const int64_t delta = (int64_t)insertedLength - (int64_t)removedLength;
+
+    //Scan into a window until a new token starts where an old token started in the unchanged text,
+    //from there on both streams are the same, only shifted by 'delta'
+    TokenBuffer window;
+    initTokenBuffer(&window);
+    window.source = source;
+    window.interns = buffer->interns;
+    Scanner scanner;
+    scannerInit(&scanner, source + resume);
+    scanner.interns = buffer->interns;
+    int next = first;
+    while (true)
+    {
+        const Token token = scannerScanToken(&scanner);
+        const uint32_t start = (uint32_t)(scanner.start - source);
+        if (start >= newEditEnd)
+        {
+            const int64_t oldStart = (int64_t)start - delta;
+            while (next < buffer->count && buffer->offsets[next] < oldStart) next++;
+            if (next < buffer->count && buffer->offsets[next] == oldStart) break;
+        }
+        recordToken(&window, &scanner, &token);
+        if (token.token == TOKEN_EOF)
+        {
+            next = buffer->count;
+            break;
+        }
+    }
+
+    //Splice the window over tokens [first, next) and shift every token after it
+    const int inserted = window.count;
+    const int removed = next - first;
+    const int newCount = buffer->count - removed + inserted;
+    if (newCount > buffer->capacity)
+    {
+        reserveTokens(buffer, newCount > GROW_CAPACITY(buffer->capacity) ? newCount : GROW_CAPACITY(buffer->capacity));
+    }
+    //Typing inside a token keeps the token count, then the tail stays where it is
+    if (inserted != removed)
+    {
+        const size_t tail = (size_t)(buffer->count - next);
+        memmove(buffer->kinds + first + inserted, buffer->kinds + next, tail * sizeof(uint8_t));
+        memmove(buffer->offsets + first + inserted, buffer->offsets + next, tail * sizeof(uint32_t));
+        memmove(buffer->lengths + first + inserted, buffer->lengths + next, tail * sizeof(uint32_t));
+        if (buffer->interns != NULL)
+        {
+            memmove(buffer->symbols + first + inserted, buffer->symbols + next, tail * sizeof(uint32_t));
+        }
+    }
+    //An edit that only deletes whole tokens leaves the window empty, and its arrays NULL
+    if (inserted > 0)
+    {
+        memcpy(buffer->kinds + first, window.kinds, (size_t)inserted * sizeof(uint8_t));
+        memcpy(buffer->offsets + first, window.offsets, (size_t)inserted * sizeof(uint32_t));
+        memcpy(buffer->lengths + first, window.lengths, (size_t)inserted * sizeof(uint32_t));
+        if (buffer->interns != NULL)
+        {
+            memcpy(buffer->symbols + first, window.symbols, (size_t)inserted * sizeof(uint32_t));
+        }
+    }
+    //Offsets are unsigned, adding the wrapped delta moves them either way
+    const uint32_t shift = (uint32_t)delta;
+    uint32_t* offsets = buffer->offsets;
+    if (shift != 0)
+    {
+        for (int i = first + inserted; i < newCount; i++) offsets[i] += shift;
+    }
+    spliceIndexedList((void**)&buffer->errors, &buffer->errorCount, &buffer->errorCapacity, sizeof(TokenError),
+                      window.errors, window.errorCount, first, next, inserted - removed);
+    spliceIndexedList((void**)&buffer->literals, &buffer->literalCount, &buffer->literalCapacity, sizeof(TokenLiteral),
+                      window.literals, window.literalCount, first, next, inserted - removed);
+    spliceIndexedList((void**)&buffer->escapedStrings, &buffer->escapedCount, &buffer->escapedCapacity,
+                      sizeof(TokenString), window.escapedStrings, window.escapedCount, first, next, inserted - removed);
+    buffer->count = newCount;
+    buffer->source = source;
+    if (buffer->lineCount > 0) spliceLineTable(buffer, editStart, removedLength, insertedLength);
+    freeTokenBuffer(&window);
 
+    splice.first = first;
+    splice.removed = removed;
+    splice.inserted = inserted;
+    return splice;
+}
+//Function to get the decoded value of a number token of a token buffer
+LiteralValue tokenLiteral(const TokenBuffer* buffer, const int index)
+{
+    //Values are recorded in token order, so their list can be searched
+    int low = 0;
+    int high = buffer->literalCount - 1;
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+        if (buffer->literals[middle].index < index)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (buffer->literalCount == 0 || buffer->literals[low].index != index)
+    {
+        LiteralValue none;
+        none.isFloat = false;
+        none.overflow = false;
+        none.as.integer = 0;
+        return none;
+    }
+    return buffer->literals[low].value;
+}
+//Helper to find the entry of a string token in the escaped strings of a token buffer, NULL without escapes
+static const TokenString* findEscapedString(const TokenBuffer* buffer, const int index)
+{
+    //Strings are recorded in token order, so their list can be searched
+    int low = 0;
+    int high = buffer->escapedCount - 1;
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+        if (buffer->escapedStrings[middle].index < index)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (buffer->escapedCount == 0 || buffer->escapedStrings[low].index != index) return NULL;
+    return &buffer->escapedStrings[low];
+}
+//Function to tell whether a string token of a token buffer holds escape sequences
+bool tokenHasEscapes(const TokenBuffer* buffer, const int index)
+{
+    return findEscapedString(buffer, index) != NULL;
+}
+//Function to get the length of a string token's contents once its escapes are decoded
+int tokenDecodedLength(const TokenBuffer* buffer, const int index)
+{
+    const TokenString* string = findEscapedString(buffer, index);
+    return string != NULL ? string->decodedLength : (int)buffer->lengths[index] - 2;
+}
+//Function to rebuild a Token from a token buffer entry
+Token tokenAt(TokenBuffer* buffer, const int index)
+{
+    Token token;
+    token.token = (TokenType)buffer->kinds[index];
+    token.symbol = buffer->interns != NULL ? buffer->symbols[index] : 0;
+    token.start = buffer->source + buffer->offsets[index];
+    token.length = (int)buffer->lengths[index];
+    token.line = tokenLine(buffer, index);
+    if (token.token == TOKEN_ERROR)
+    {
+        //Errors are recorded in token order, so their list can be searched
+        int low = 0;
+        int high = buffer->errorCount - 1;
+        while (low < high)
+        {
+            const int middle = low + (high - low) / 2;
+            if (buffer->errors[middle].index < index)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        token.start = buffer->errors[low].message;
+        token.length = (int)strlen(token.start);
+    }
+    return token;
+}
+//Function to initialize our scanner
+void initScanner(const char* source)
+{
+    scannerInit(&globalScanner, source);
+}
+//Function that checks if we read the complete file or not
+bool isAtEnd(void)
+{
+    return scannerIsAtEnd(&globalScanner);
+}
+//Function that moves the pointer 'current' forward
+char advance(void)
+{
+    return scannerAdvance(&globalScanner);
+}
+//Function to check the next character
+char peek(void)
+{
+    return scannerPeek(&globalScanner);
+}
+//Function to check the second next character
+char peekNext(void)
+{
+    return scannerPeekNext(&globalScanner);
+}
+//Function to skip whitespace characters
+void skipWhitespace(void)
+{
+    scannerSkipWhitespace(&globalScanner);
+}
+//Function to create a token
+Token createToken(const TokenType token_type)
+{
+    return scannerCreateToken(&globalScanner, token_type);
+}
+//Function for error reporting
+Token errorToken(const char* message)
+{
+    return scannerErrorToken(&globalScanner, message);
+}
+//Helper function to evaluate conditional advances - '!=' , '=='
+bool match(const char expected)
+{
+    return scannerMatch(&globalScanner, expected);
+}
+//Helper to check keyword
+TokenType checkKeyword(const int start ,const int length , const char* rest ,const TokenType type)
+{
+    return scannerCheckKeyword(&globalScanner, start, length, rest, type);
+}
+//Function to evaluate tokens
+Token scanToken(void)
+{
+    return scannerScanToken(&globalScanner);
+}
+//Helper to load and lex a source file, 'stats' (may be NULL) is charged with the time of every phase
+static void lexFile(const char* path, Stats* stats)
+{
+    double start = statsClock();
+    //Load the file into source, mapped when possible so nothing is copied
+    Source source = loadSource(path);
+    if (stats != NULL) start = addPhaseTime(stats, PHASE_READ, start);
+    //Tokenize the whole source up front (large ones on every core), names are interned so later phases compare ids
+    InternTable interns;
+    initInternTable(&interns);
+    TokenBuffer tokens;
+    initTokenBuffer(&tokens);
+    tokens.interns = &interns;
+    tokenizeParallel(&tokens, source.data, source.length, 0);
+    if (stats != NULL)
+    {
+        addPhaseTime(stats, PHASE_LEX, start);
+        stats->moduleCount++;
+        stats->sourceBytes += source.length;
+        stats->tokenCount += (size_t)tokens.count - 1; //EOF is not counted
+        stats->arenaBytes += interns.strings.bytesAllocated;
+        stats->arenaPeakBytes += interns.strings.peakBytes;
+    }
+    freeTokenBuffer(&tokens);
+    freeInternTable(&interns);
+    freeSource(&source);
+}
+//Function to manage the process, 'stats' (may be NULL) is charged with the time of every phase
+void runFile(const char* path, Stats* stats)
+{
+    if (!isPrecompiledPath(path))
+    {
+        lexFile(path, stats);
+        return;
+    }
+    //A precompiled module is only mapped and checked against its source, nothing is lexed
+    const double start = statsClock();
+    PrecompiledModule module;
+    const PrecompiledStatus status = openPrecompiled(&module, path);
+    if (status == PRECOMPILED_OK)
+    {
+        if (stats != NULL)
+        {
+            addPhaseTime(stats, PHASE_READ, start);
+            stats->moduleCount++;
+            stats->sourceBytes += module.source.length;
+            stats->tokenCount += (size_t)module.tokens.count - 1; //EOF is not counted
+        }
+        closePrecompiled(&module);
+        return;
+    }
+    fprintf(stderr, "\"%s\" is %s", path, precompiledStatusMessage(status));
+    //Once the header was read the source is known, so a stale or foreign file costs one lex
+    char* sourcePath = module.sourcePath;
+    module.sourcePath = NULL;
+    closePrecompiled(&module);
+    if (sourcePath == NULL)
+    {
+        fprintf(stderr, ".\n");
+        //Like any other script that cannot be loaded, a corrupt or foreign file is bad input like '--serve' reports it
+        exit(status == PRECOMPILED_UNREADABLE ? 74 : 65);
+    }
+    fprintf(stderr, ", lexing \"%s\" instead.\n", sourcePath);
+    lexFile(sourcePath, stats);
+    free(sourcePath);
+}
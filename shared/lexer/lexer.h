@@ -4,9 +4,91 @@
 #ifndef LEXER_H
 #define LEXER_H
 
+#include "stats.h"
 #include "token.h"
 #include <stdbool.h>
+#include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//struct to iterate through the source code - one instance per file being lexed
+typedef struct
+{
+    const char* start;
+    const char* current;
+    int line;
+    //Optional table that identifiers and string literals are interned into, NULL to skip interning
+    struct InternTable* interns;
+    //Escape sequences in the last string literal scanned, read by recordToken
+    int escapes;
+} Scanner;
+
+//Instance based API - every function only touches the scanner it is given, so
+//separate scanners can be driven from separate threads
+//Function to initialize a scanner
+void scannerInit(Scanner* scanner, const char* source);
+//Function that checks if the scanner reached the end of its source
+bool scannerIsAtEnd(const Scanner* scanner);
+//Function that moves the scanner's 'current' pointer forward
+char scannerAdvance(Scanner* scanner);
+//Function to check the next character
+char scannerPeek(const Scanner* scanner);
+//Function to check the second next character
+char scannerPeekNext(const Scanner* scanner);
+//Function to skip whitespace characters
+void scannerSkipWhitespace(Scanner* scanner);
+//Function to create a token from the scanner's current lexeme
+Token scannerCreateToken(const Scanner* scanner, TokenType token_type);
+//Function for error reporting
+Token scannerErrorToken(const Scanner* scanner, const char* message);
+//Helper function to evaluate conditional advances - '!=' , '=='
+bool scannerMatch(Scanner* scanner, char expected);
+//Helper to check keyword
+TokenType scannerCheckKeyword(const Scanner* scanner, int start, int length, const char* rest, TokenType type);
+//Function to evaluate the next token of a scanner
+Token scannerScanToken(Scanner* scanner);
+
+//Batch API - the whole token stream is kept as parallel arrays in a TokenBuffer
+//Function to initialize an empty token buffer
+void initTokenBuffer(TokenBuffer* buffer);
+//Function to release a token buffer
+void freeTokenBuffer(TokenBuffer* buffer);
+//Function to lex a whole source into a token buffer ('lengthHint' only sizes the arrays, 0 if unknown).
+//Set buffer->interns beforehand to also fill buffer->symbols
+int tokenizeAll(TokenBuffer* buffer, const char* source, size_t lengthHint);
+//Function to append the token a scanner just produced to a token buffer, its offsets are taken
+//relative to buffer->source
+void recordToken(TokenBuffer* buffer, const Scanner* scanner, const Token* token);
+//Function to get the line a token starts on, the line table is built on first use
+int tokenLine(TokenBuffer* buffer, int index);
+//Function to get the decoded value of a number token of a token buffer (zero for other tokens)
+LiteralValue tokenLiteral(const TokenBuffer* buffer, int index);
+//Function to tell whether a string token of a token buffer holds escape sequences
+bool tokenHasEscapes(const TokenBuffer* buffer, int index);
+//Function to get the length of a string token's contents once its escapes are decoded.
+//Without escapes the contents are the lexeme minus its quotes and can be used from the source as they are
+int tokenDecodedLength(const TokenBuffer* buffer, int index);
+//Function to rebuild a Token from a token buffer entry
+Token tokenAt(TokenBuffer* buffer, int index);
+
+//Incremental API - for editors, an edit re-lexes only the tokens around it and splices them in
+//Struct to describe a re-lex: tokens [first, first + removed) were replaced by 'inserted' new ones,
+//later tokens kept their kind and length and moved by the size change of the edit
+typedef struct
+{
+    int first;
+    int removed;
+    int inserted;
+} TokenSplice;
+//Function to update a buffer filled by tokenizeAll after an edit replaced 'removedLength' bytes at
+//'editStart' with 'insertedLength' bytes. 'source' is the whole edited text ('\0' terminated) and
+//replaces buffer->source. An edit outside the old text re-lexes everything
+TokenSplice relexTokens(TokenBuffer* buffer, const char* source, uint32_t editStart, uint32_t removedLength,
+                        uint32_t insertedLength);
+
+//Global scanner API - thin wrappers over a single default scanner instance
 //Function to initialize our scanner
 void initScanner(const char* source);
 //Function that checks if we read the complete file or not
@@ -35,7 +117,11 @@ bool isAlpha(char c);
 TokenType checkKeyword(int start ,int length , const char* rest ,TokenType type);
 //Function to evaluate tokens
 Token scanToken(void);
-//Function to manage the process
-void runFile(const char* path);
+//Function to manage the process, 'stats' (may be NULL) is charged with the time of every phase
+void runFile(const char* path, Stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
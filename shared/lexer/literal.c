@@ -0,0 +1,158 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "literal.h"
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Any 19 decimal digits fit in a uint64_t, so they need no overflow check
+#define SAFE_DIGITS 19
+//Doubles represent every integer up to 2^53 and every power of ten up to 1e22 exactly
+#define EXACT_MANTISSA (UINT64_C(1) << 53)
+#define EXACT_POWER 22
+
+//Powers of ten that are exact doubles
+static const double exactPowers[EXACT_POWER + 1] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//Helper to decode a run of decimal digits, returns false once the value no longer fits in 64 bits
+static bool decodeDigits(const char* start, const int length, uint64_t* value)
+{
+    uint64_t result = 0;
+    int i = 0;
+    //Fast path, no overflow is possible in the first 19 digits
+    for (const int safe = length < SAFE_DIGITS ? length : SAFE_DIGITS; i < safe; i++)
+    {
+        result = result * 10 + (uint64_t)(start[i] - '0');
+    }
+    for (; i < length; i++)
+    {
+        const uint64_t digit = (uint64_t)(start[i] - '0');
+        if (result > (UINT64_MAX - digit) / 10)
+        {
+            *value = UINT64_MAX;
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    *value = result;
+    return true;
+}
+
+//Helper to decode a float literal ('digits.digits')
+static double decodeFloat(const char* start, const int length)
+{
+    const char* dot = memchr(start, '.', (size_t)length);
+    const int integerDigits = dot != NULL ? (int)(dot - start) : length;
+    const int fractionDigits = dot != NULL ? length - integerDigits - 1 : 0;
+    //Exact fast path: both the digits and the power of ten are exact doubles, so one division rounds correctly
+    if (integerDigits + fractionDigits <= SAFE_DIGITS && fractionDigits <= EXACT_POWER)
+    {
+        uint64_t integerPart;
+        uint64_t fractionPart = 0;
+        decodeDigits(start, integerDigits, &integerPart);
+        if (fractionDigits > 0)
+        {
+            decodeDigits(dot + 1, fractionDigits, &fractionPart);
+        }
+        uint64_t mantissa = integerPart;
+        for (int i = 0; i < fractionDigits; i++) mantissa *= 10;
+        mantissa += fractionPart;
+        if (mantissa <= EXACT_MANTISSA)
+        {
+            return (double)mantissa / exactPowers[fractionDigits];
+        }
+    }
+    //Slow path, the lexeme is not '\0' terminated so strtod gets a bounded copy
+    char small[64];
+    char* copy = length < (int)sizeof(small) ? small : malloc((size_t)length + 1);
+    if (copy == NULL) return strtod("nan", NULL);
+    memcpy(copy, start, (size_t)length);
+    copy[length] = '\0';
+    const double result = strtod(copy, NULL);
+    if (copy != small) free(copy);
+    return result;
+}
+
+//Function to decode the lexeme of a TOKEN_INT_LITERAL or TOKEN_FLOAT_LITERAL
+LiteralValue decodeNumberLiteral(const char* start, const int length, const bool isFloat)
+{
+    LiteralValue value;
+    value.isFloat = isFloat;
+    value.overflow = false;
+    if (isFloat)
+    {
+        value.as.real = decodeFloat(start, length);
+        value.overflow = isinf(value.as.real);
+    }
+    else
+    {
+        value.overflow = !decodeDigits(start, length, &value.as.integer);
+    }
+    return value;
+}
+
+//Function to decode the value of a number token
+LiteralValue tokenNumberValue(const Token* token)
+{
+    return decodeNumberLiteral(token->start, token->length, token->token == TOKEN_FLOAT_LITERAL);
+}
+
+//Function to check a decoded literal against the type it initializes ('negated' for a leading unary minus)
+bool literalFitsType(const LiteralValue* value, const TypeKind type, const bool negated)
+{
+    if (value->overflow) return false;
+    if (value->isFloat)
+    {
+        //A float literal never silently becomes an integer
+        if (type == TYPE_F64) return true;
+        if (type == TYPE_F32) return value->as.real <= FLT_MAX;
+        return false;
+    }
+    if (isFloatType(type)) return true;
+    const int bits = typeBits(type);
+    if (isUnsignedType(type))
+    {
+        if (negated) return value->as.integer == 0;
+        return bits == 64 || value->as.integer <= (UINT64_C(1) << bits) - 1;
+    }
+    if (isSignedType(type))
+    {
+        //Two's complement has one more negative value than positive ones
+        const uint64_t limit = UINT64_C(1) << (bits - 1);
+        return negated ? value->as.integer <= limit : value->as.integer < limit;
+    }
+    return false;
+}
+
+//Function to decode the contents of a string literal (quotes stripped, escapes already validated by the lexer)
+int decodeStringLiteral(const char* chars, const int length, char* out)
+{
+    const char* end = chars + length;
+    char* written = out;
+    while (chars < end)
+    {
+        //Copy the plain run up to the next escape in one go
+        const char* escape = memchr(chars, '\\', (size_t)(end - chars));
+        const size_t run = (size_t)((escape != NULL ? escape : end) - chars);
+        memcpy(written, chars, run);
+        written += run;
+        if (escape == NULL || escape + 1 >= end) break;
+        switch (escape[1])
+        {
+        case 'n': *written++ = '\n'; break;
+        case 't': *written++ = '\t'; break;
+        case 'r': *written++ = '\r'; break;
+        case '0': *written++ = '\0'; break;
+        default: *written++ = escape[1]; break; //'\'', '"', '\\', '{' and '}' stand for themselves
+        }
+        chars = escape + 2;
+    }
+    return (int)(written - out);
+}
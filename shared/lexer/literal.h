@@ -0,0 +1,29 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef LITERAL_H
+#define LITERAL_H
+
+#include "token.h"
+#include "types.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Function to decode the lexeme of a TOKEN_INT_LITERAL or TOKEN_FLOAT_LITERAL
+LiteralValue decodeNumberLiteral(const char* start, int length, bool isFloat);
+//Function to decode the value of a number token
+LiteralValue tokenNumberValue(const Token* token);
+//Function to check a decoded literal against the type it initializes ('negated' for a leading unary minus)
+bool literalFitsType(const LiteralValue* value, TypeKind type, bool negated);
+//Function to decode the contents of a string literal (quotes stripped, escapes already validated by the lexer)
+//into 'out', which must hold its decoded length. Returns the number of bytes written
+int decodeStringLiteral(const char* chars, int length, char* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LITERAL_H
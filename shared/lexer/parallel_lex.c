@@ -0,0 +1,416 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "parallel_lex.h"
+#include "common.h"
+#include "intern.h"
+#include "lexer.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+//Struct to hold one chunk of a source and the tokens lexed from it
+typedef struct
+{
+    const char* source;
+    uint32_t begin;           //Chunk covers [begin, end) of the source
+    uint32_t end;
+    bool last;
+    TokenBuffer tokens;       //Speculative tokens starting in the chunk, offsets relative to 'source'
+    InternTable interns;      //Private table, remapped into the shared one after validation
+    bool interning;
+    uint32_t nextStart;       //Start of the token after the chunk's last one
+    uint32_t* lineStarts;     //Starts of the lines beginning in (begin, end]
+    int lineCount;
+    //Filled by validation
+    TokenBuffer fixup;        //Tokens re-lexed serially in front of the kept ones
+    InternTable fixupInterns; //Private table of the fix-up tokens
+    int keepFrom;             //First speculative token that is kept
+    int outIndex;             //Where the chunk's tokens go in the merged stream
+    SymbolId* remap;          //Private symbol id to shared symbol id
+    SymbolId* firstSeen;      //Private ids of the kept tokens, in the order they first appear
+    int firstSeenCount;
+    TokenBuffer* out;
+} LexChunk;
+
+//Function to get the number of threads used when 'jobs' is 0 (the online cores)
+int lexerThreadCount(void)
+{
+#ifndef _WIN32
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+#else
+    return 1;
+#endif
+}
+
+//Helper to lex one chunk speculatively, as if it started on a token boundary
+static void lexChunk(LexChunk* chunk)
+{
+    initTokenBuffer(&chunk->tokens);
+    chunk->tokens.source = chunk->source;
+    if (chunk->interning)
+    {
+        initInternTable(&chunk->interns);
+        chunk->tokens.interns = &chunk->interns;
+    }
+    Scanner scanner;
+    scannerInit(&scanner, chunk->source + chunk->begin);
+    scanner.interns = chunk->tokens.interns;
+    while (true)
+    {
+        const Token token = scannerScanToken(&scanner);
+        const uint32_t start = (uint32_t)(scanner.start - chunk->source);
+        //A token starting past the cut belongs to the next chunk, only the last chunk ends with EOF
+        if (!chunk->last && start >= chunk->end)
+        {
+            chunk->nextStart = start;
+            break;
+        }
+        recordToken(&chunk->tokens, &scanner, &token);
+        if (token.token == TOKEN_EOF)
+        {
+            chunk->nextStart = start;
+            break;
+        }
+    }
+
+    //Lines do not depend on where tokens start, so every chunk numbers its own
+    int capacity = 0;
+    chunk->lineStarts = NULL;
+    chunk->lineCount = 0;
+    const char* end = chunk->source + chunk->end;
+    for (const char* newline = memchr(chunk->source + chunk->begin, '\n', chunk->end - chunk->begin);
+         newline != NULL;
+         newline = memchr(newline + 1, '\n', (size_t)(end - newline - 1)))
+    {
+        if (chunk->lineCount == capacity)
+        {
+            capacity = GROW_CAPACITY(capacity);
+            chunk->lineStarts = growArray(chunk->lineStarts, capacity, sizeof(uint32_t));
+        }
+        chunk->lineStarts[chunk->lineCount++] = (uint32_t)(newline + 1 - chunk->source);
+    }
+}
+
+//Helper to copy the kept tokens of a chunk into the merged stream
+static void copyChunk(LexChunk* chunk)
+{
+    TokenBuffer* out = chunk->out;
+    const TokenBuffer* fixup = &chunk->fixup;
+    const TokenBuffer* tokens = &chunk->tokens;
+    int index = chunk->outIndex;
+    if (fixup->count > 0)
+    {
+        memcpy(out->kinds + index, fixup->kinds, (size_t)fixup->count * sizeof(uint8_t));
+        memcpy(out->offsets + index, fixup->offsets, (size_t)fixup->count * sizeof(uint32_t));
+        memcpy(out->lengths + index, fixup->lengths, (size_t)fixup->count * sizeof(uint32_t));
+        //Fix-up symbols were given their shared ids in place
+        if (out->interns != NULL) memcpy(out->symbols + index, fixup->symbols, (size_t)fixup->count * sizeof(uint32_t));
+        index += fixup->count;
+    }
+
+    const int kept = tokens->count - chunk->keepFrom;
+    if (kept == 0) return;
+    memcpy(out->kinds + index, tokens->kinds + chunk->keepFrom, (size_t)kept * sizeof(uint8_t));
+    memcpy(out->offsets + index, tokens->offsets + chunk->keepFrom, (size_t)kept * sizeof(uint32_t));
+    memcpy(out->lengths + index, tokens->lengths + chunk->keepFrom, (size_t)kept * sizeof(uint32_t));
+    if (out->interns != NULL)
+    {
+        for (int i = 0; i < kept; i++) out->symbols[index + i] = chunk->remap[tokens->symbols[chunk->keepFrom + i]];
+    }
+}
+
+#ifndef _WIN32
+//Struct to hold the task a thread runs on its chunk
+typedef struct
+{
+    void (*task)(LexChunk* chunk);
+    LexChunk* chunk;
+} ChunkJob;
+
+//Helper that runs one chunk task on a thread
+static void* runChunkJob(void* argument)
+{
+    const ChunkJob* job = argument;
+    job->task(job->chunk);
+    return NULL;
+}
+#endif
+
+//Helper to run a task on every chunk, one thread each (the calling thread takes the first chunk)
+static void runChunks(LexChunk* chunks, const int count, void (*task)(LexChunk* chunk))
+{
+#ifndef _WIN32
+    pthread_t* threads = growArray(NULL, count, sizeof(pthread_t));
+    ChunkJob* jobs = growArray(NULL, count, sizeof(ChunkJob));
+    bool* started = growArray(NULL, count, sizeof(bool));
+    for (int i = 1; i < count; i++)
+    {
+        jobs[i].task = task;
+        jobs[i].chunk = &chunks[i];
+        started[i] = pthread_create(&threads[i], NULL, runChunkJob, &jobs[i]) == 0;
+    }
+    task(&chunks[0]);
+    for (int i = 1; i < count; i++)
+    {
+        //A thread that could not be started is made up for here
+        if (started[i]) pthread_join(threads[i], NULL);
+        else task(&chunks[i]);
+    }
+    free(started);
+    free(jobs);
+    free(threads);
+#else
+    for (int i = 0; i < count; i++) task(&chunks[i]);
+#endif
+}
+
+//Helper to find the first speculative token of a chunk starting at or after 'offset'
+static int findTokenStart(const TokenBuffer* tokens, const uint32_t offset)
+{
+    int low = 0;
+    int high = tokens->count;
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+        if (tokens->offsets[middle] < offset) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+//Helper to validate a chunk against the true stream, which continues with a token at 'expected'.
+//Returns the start of the token that follows the chunk in the true stream
+static uint32_t validateChunk(LexChunk* chunk, const uint32_t expected)
+{
+    initTokenBuffer(&chunk->fixup);
+    chunk->fixup.source = chunk->source;
+    if (chunk->interning)
+    {
+        initInternTable(&chunk->fixupInterns);
+        chunk->fixup.interns = &chunk->fixupInterns;
+    }
+    int next = findTokenStart(&chunk->tokens, expected);
+    //The common case: the cut fell between tokens, so both streams agree from the first token on
+    if (next < chunk->tokens.count && chunk->tokens.offsets[next] == expected)
+    {
+        chunk->keepFrom = next;
+        return chunk->nextStart;
+    }
+    //The guess was wrong (the cut is inside a string or a string ran past it), re-lex until the streams meet
+    Scanner scanner;
+    scannerInit(&scanner, chunk->source + expected);
+    scanner.interns = chunk->fixup.interns;
+    while (true)
+    {
+        const Token token = scannerScanToken(&scanner);
+        const uint32_t start = (uint32_t)(scanner.start - chunk->source);
+        if (!chunk->last && start >= chunk->end)
+        {
+            chunk->keepFrom = chunk->tokens.count;
+            return start;
+        }
+        while (next < chunk->tokens.count && chunk->tokens.offsets[next] < start) next++;
+        if (next < chunk->tokens.count && chunk->tokens.offsets[next] == start)
+        {
+            chunk->keepFrom = next;
+            return chunk->nextStart;
+        }
+        recordToken(&chunk->fixup, &scanner, &token);
+        if (token.token == TOKEN_EOF)
+        {
+            chunk->keepFrom = chunk->tokens.count;
+            return start;
+        }
+    }
+}
+
+//Helper to list the private symbols of a chunk's kept tokens in the order they first appear
+static void orderSymbols(LexChunk* chunk)
+{
+    if (!chunk->interning) return;
+    //Until the shared ids are known, a non-zero entry only marks a symbol as seen
+    chunk->remap = calloc((size_t)chunk->interns.count, sizeof(SymbolId));
+    chunk->firstSeen = growArray(NULL, chunk->interns.count, sizeof(SymbolId));
+    if (chunk->remap == NULL)
+    {
+        fprintf(stderr, "Not enough memory to merge the symbols of a chunk\n");
+        exit(74);
+    }
+    chunk->firstSeenCount = 0;
+    for (int i = chunk->keepFrom; i < chunk->tokens.count; i++)
+    {
+        const SymbolId id = chunk->tokens.symbols[i];
+        if (id == SYMBOL_NONE || chunk->remap[id] != SYMBOL_NONE) continue;
+        chunk->remap[id] = 1;
+        chunk->firstSeen[chunk->firstSeenCount++] = id;
+    }
+}
+
+//Helper to give the symbols of a chunk their shared ids, in the order tokenizeAll would intern them.
+//Symbols only met by discarded speculative tokens never reach the shared table
+static void assignSymbols(LexChunk* chunk, InternTable* interns)
+{
+    //The fix-up tokens come first in the stream, and there are few of them
+    for (int i = 0; i < chunk->fixup.count; i++)
+    {
+        const SymbolId id = chunk->fixup.symbols[i];
+        if (id == SYMBOL_NONE) continue;
+        const Symbol* symbol = symbolAt(&chunk->fixupInterns, id);
+        chunk->fixup.symbols[i] = internString(interns, symbol->chars, symbol->length);
+    }
+    for (int i = 0; i < chunk->firstSeenCount; i++)
+    {
+        const Symbol* symbol = symbolAt(&chunk->interns, chunk->firstSeen[i]);
+        chunk->remap[chunk->firstSeen[i]] = internString(interns, symbol->chars, symbol->length);
+    }
+}
+
+//Helper to append the entries of a side list (errors, literals or escaped strings) of a chunk to the merged list.
+//Entries of tokens before 'keepFrom' are dropped, the rest move to the chunk's place in the stream
+static void appendIndexedList(void** list, int* count, int* capacity, const size_t size,
+                              const void* entries, const int entryCount, const int keepFrom, const int shift)
+{
+    for (int i = 0; i < entryCount; i++)
+    {
+        const char* entry = (const char*)entries + (size_t)i * size;
+        //Every entry type starts with the index of its token
+        const int index = *(const int*)entry;
+        if (index < keepFrom) continue;
+        if (*count == *capacity)
+        {
+            *capacity = GROW_CAPACITY(*capacity);
+            *list = growArray(*list, *capacity, size);
+        }
+        char* added = (char*)*list + (size_t)*count * size;
+        memcpy(added, entry, size);
+        *(int*)added = index + shift;
+        (*count)++;
+    }
+}
+
+//Function to lex a whole source on up to 'jobs' threads (0 for every core), the result matches tokenizeAll
+int tokenizeParallel(TokenBuffer* buffer, const char* source, size_t length, int jobs)
+{
+    //The scanner stops at the first '\0', so nothing after it is part of the source
+    const char* sentinel = memchr(source, '\0', length);
+    if (sentinel != NULL) length = (size_t)(sentinel - source);
+    if (jobs <= 0) jobs = lexerThreadCount();
+    if ((size_t)jobs > length / PARALLEL_LEX_MIN_CHUNK) jobs = (int)(length / PARALLEL_LEX_MIN_CHUNK);
+    if (jobs <= 1 || length > UINT32_MAX) return tokenizeAll(buffer, source, length);
+
+    //Cut just after a newline near every 1/jobs of the source, cuts without a newline are merged away
+    LexChunk* chunks = growArray(NULL, jobs, sizeof(LexChunk));
+    int chunkCount = 0;
+    uint32_t begin = 0;
+    for (int i = 1; i <= jobs && begin < length; i++)
+    {
+        uint32_t end = (uint32_t)length;
+        if (i < jobs)
+        {
+            const size_t target = length / (size_t)jobs * (size_t)i;
+            const char* newline = target > begin ? memchr(source + target, '\n', length - target) : NULL;
+            if (newline == NULL) continue;
+            end = (uint32_t)(newline + 1 - source);
+        }
+        LexChunk* chunk = &chunks[chunkCount++];
+        memset(chunk, 0, sizeof(LexChunk));
+        chunk->source = source;
+        chunk->begin = begin;
+        chunk->end = end;
+        chunk->interning = buffer->interns != NULL;
+        chunk->out = buffer;
+        begin = end;
+    }
+    chunks[chunkCount - 1].last = true;
+    runChunks(chunks, chunkCount, lexChunk);
+
+    //Validate the boundaries in order, the first chunk always starts on a token
+    uint32_t expected = chunks[0].nextStart;
+    initTokenBuffer(&chunks[0].fixup);
+    if (chunks[0].interning) initInternTable(&chunks[0].fixupInterns);
+    chunks[0].keepFrom = 0;
+    for (int i = 1; i < chunkCount; i++)
+    {
+        expected = validateChunk(&chunks[i], expected);
+    }
+
+    //Shared ids are handed out in stream order, so they match tokenizeAll whatever the chunking
+    runChunks(chunks, chunkCount, orderSymbols);
+    int total = 0;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        LexChunk* chunk = &chunks[i];
+        chunk->outIndex = total;
+        total += chunk->fixup.count + chunk->tokens.count - chunk->keepFrom;
+        if (chunk->interning) assignSymbols(chunk, buffer->interns);
+    }
+    buffer->source = source;
+    buffer->kinds = growArray(buffer->kinds, total, sizeof(uint8_t));
+    buffer->offsets = growArray(buffer->offsets, total, sizeof(uint32_t));
+    buffer->lengths = growArray(buffer->lengths, total, sizeof(uint32_t));
+    if (buffer->interns != NULL) buffer->symbols = growArray(buffer->symbols, total, sizeof(uint32_t));
+    buffer->count = total;
+    buffer->capacity = total;
+    runChunks(chunks, chunkCount, copyChunk);
+
+    //Side lists and line starts are small next to the tokens, they are merged here
+    buffer->errorCount = 0;
+    buffer->literalCount = 0;
+    buffer->escapedCount = 0;
+    int lineCount = 1;
+    for (int i = 0; i < chunkCount; i++) lineCount += chunks[i].lineCount;
+    buffer->lineStarts = growArray(buffer->lineStarts, lineCount, sizeof(uint32_t));
+    buffer->lineStarts[0] = 0;
+    buffer->lineCount = 1;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        LexChunk* chunk = &chunks[i];
+        const int kept = chunk->outIndex + chunk->fixup.count;
+        appendIndexedList((void**)&buffer->errors, &buffer->errorCount, &buffer->errorCapacity, sizeof(TokenError),
+                          chunk->fixup.errors, chunk->fixup.errorCount, 0, chunk->outIndex);
+        appendIndexedList((void**)&buffer->errors, &buffer->errorCount, &buffer->errorCapacity, sizeof(TokenError),
+                          chunk->tokens.errors, chunk->tokens.errorCount, chunk->keepFrom, kept - chunk->keepFrom);
+        appendIndexedList((void**)&buffer->literals, &buffer->literalCount, &buffer->literalCapacity,
+                          sizeof(TokenLiteral), chunk->fixup.literals, chunk->fixup.literalCount, 0, chunk->outIndex);
+        appendIndexedList((void**)&buffer->literals, &buffer->literalCount, &buffer->literalCapacity,
+                          sizeof(TokenLiteral), chunk->tokens.literals, chunk->tokens.literalCount, chunk->keepFrom,
+                          kept - chunk->keepFrom);
+        appendIndexedList((void**)&buffer->escapedStrings, &buffer->escapedCount, &buffer->escapedCapacity,
+                          sizeof(TokenString), chunk->fixup.escapedStrings, chunk->fixup.escapedCount, 0, chunk->outIndex);
+        appendIndexedList((void**)&buffer->escapedStrings, &buffer->escapedCount, &buffer->escapedCapacity,
+                          sizeof(TokenString), chunk->tokens.escapedStrings, chunk->tokens.escapedCount, chunk->keepFrom,
+                          kept - chunk->keepFrom);
+        //Prefix sum: the lines of a chunk follow every line of the chunks before it
+        if (chunk->lineCount > 0)
+        {
+            memcpy(buffer->lineStarts + buffer->lineCount, chunk->lineStarts, (size_t)chunk->lineCount * sizeof(uint32_t));
+        }
+        buffer->lineCount += chunk->lineCount;
+
+        free(chunk->lineStarts);
+        free(chunk->remap);
+        free(chunk->firstSeen);
+        freeTokenBuffer(&chunk->fixup);
+        freeTokenBuffer(&chunk->tokens);
+        if (chunk->interning)
+        {
+            freeInternTable(&chunk->interns);
+            freeInternTable(&chunk->fixupInterns);
+        }
+    }
+    free(chunks);
+    return buffer->count;
+}
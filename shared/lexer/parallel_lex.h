@@ -0,0 +1,42 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef PARALLEL_LEX_H
+#define PARALLEL_LEX_H
+
+#include "token.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Chunked lexing of one large source on several threads. The source is cut
+//just after newlines, and every chunk is lexed speculatively as if it started
+//on a token boundary. That guess is wrong when a multiline string crosses the
+//cut, so chunks are then validated in order. The true stream of chunk k ends
+//at a token starting at or past the cut, and chunk k + 1 is kept from the
+//first of its tokens that starts at that same offset. If no token starts
+//there, the text is re-lexed serially until the two streams meet again.
+//Lyka has no block comments and '//' comments end at a newline, so they never
+//cross a cut. Each chunk also records its line starts, which are
+//concatenated at their prefix-summed positions into the buffer's line table.
+//Chunks intern into private tables, and the shared ids are handed out once
+//the kept tokens are known, in the order the tokens appear. The result is the
+//same buffer tokenizeAll would produce, symbol ids included, whatever the
+//number of threads.
+
+//Smallest chunk worth a thread of its own, smaller sources are lexed serially
+#define PARALLEL_LEX_MIN_CHUNK (1024 * 1024)
+
+//Function to get the number of threads used when 'jobs' is 0 (the online cores)
+int lexerThreadCount(void);
+//Function to lex a whole source on up to 'jobs' threads (0 for every core), the result matches tokenizeAll.
+//Set buffer->interns beforehand to also fill buffer->symbols
+int tokenizeParallel(TokenBuffer* buffer, const char* source, size_t length, int jobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PARALLEL_LEX_H
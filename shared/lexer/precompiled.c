@@ -0,0 +1,542 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "precompiled.h"
+#include "lexer.h"
+#include "parallel_lex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif
+
+//Sections of a .lkc, in file order
+typedef enum
+{
+    SECTION_SOURCE_NAME,   //File name of the source, '\0' terminated
+    SECTION_KINDS,         //uint8_t per token
+    SECTION_OFFSETS,       //uint32_t per token
+    SECTION_LENGTHS,       //uint32_t per token
+    SECTION_SYMBOLS,       //uint32_t per token
+    SECTION_LITERALS,      //TokenLiteral per number token
+    SECTION_ESCAPED,       //TokenString per string token with escapes
+    SECTION_LINES,         //uint32_t per line start
+    SECTION_SYMBOL_TABLE,  //PrecompiledSymbol per interned string, slot 0 included
+    SECTION_SLOTS,         //SymbolId per slot of the intern hash set
+    SECTION_STRINGS,       //Text of the interned strings, each '\0' terminated
+    SECTION_COUNT
+} PrecompiledSection;
+
+//Struct to hold the header at the start of a .lkc
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;    //PRECOMPILED_BYTE_ORDER as written by the host
+    uint32_t literalSize;  //sizeof(TokenLiteral), which depends on the ABI
+    uint64_t sourceHash;
+    uint64_t sourceLength;
+    uint32_t tokenCount;
+    uint32_t literalCount;
+    uint32_t escapedCount;
+    uint32_t lineCount;
+    uint32_t symbolCount;
+    uint32_t slotCapacity;
+    uint64_t offsets[SECTION_COUNT];
+    uint64_t sizes[SECTION_COUNT];
+} PrecompiledHeader;
+
+//Struct to hold one interned string inside a .lkc
+typedef struct
+{
+    uint64_t offset;   //Into SECTION_STRINGS
+    uint32_t length;
+    uint32_t hash;
+} PrecompiledSymbol;
+
+static const char precompiledMagic[4] = {'L', 'Y', 'K', 'C'};
+#define PRECOMPILED_BYTE_ORDER 0x01020304u
+//Alignment of every section, enough for the widest field they hold
+#define PRECOMPILED_ALIGNMENT 8
+
+//Primes of xxHash64
+#define XXH_PRIME1 11400714785074694791ull
+#define XXH_PRIME2 14029467366897019727ull
+#define XXH_PRIME3 1609587929392839161ull
+#define XXH_PRIME4 9650029242287828579ull
+#define XXH_PRIME5 2870177450012600261ull
+
+//Helper to rotate a 64-bit word left
+static uint64_t rotateLeft(const uint64_t value, const int bits)
+{
+    return value << bits | value >> (64 - bits);
+}
+
+//Helpers to read unaligned little-endian words
+static uint64_t read64(const char* bytes)
+{
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+static uint32_t read32(const char* bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+//Helpers to mix one lane into an xxHash64 accumulator
+static uint64_t hashRound(uint64_t accumulator, const uint64_t lane)
+{
+    accumulator += lane * XXH_PRIME2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * XXH_PRIME1;
+}
+static uint64_t hashMerge(uint64_t accumulator, const uint64_t lane)
+{
+    accumulator ^= hashRound(0, lane);
+    return accumulator * XXH_PRIME1 + XXH_PRIME4;
+}
+
+//Function to get the xxHash64 of a source, as recorded in precompiled modules
+uint64_t hashSource(const char* data, const size_t length)
+{
+    const char* end = data + length;
+    uint64_t hash;
+    if (length >= 32)
+    {
+        uint64_t lanes[4] = {XXH_PRIME1 + XXH_PRIME2, XXH_PRIME2, 0, 0 - XXH_PRIME1};
+        const char* limit = end - 32;
+        do
+        {
+            for (int i = 0; i < 4; i++) lanes[i] = hashRound(lanes[i], read64(data + i * 8));
+            data += 32;
+        }
+        while (data <= limit);
+        hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+        for (int i = 0; i < 4; i++) hash = hashMerge(hash, lanes[i]);
+    }
+    else hash = XXH_PRIME5;
+    hash += (uint64_t)length;
+    for (; data + 8 <= end; data += 8)
+    {
+        hash ^= hashRound(0, read64(data));
+        hash = rotateLeft(hash, 27) * XXH_PRIME1 + XXH_PRIME4;
+    }
+    if (data + 4 <= end)
+    {
+        hash ^= (uint64_t)read32(data) * XXH_PRIME1;
+        hash = rotateLeft(hash, 23) * XXH_PRIME2 + XXH_PRIME3;
+        data += 4;
+    }
+    for (; data < end; data++)
+    {
+        hash ^= (uint64_t)(uint8_t)*data * XXH_PRIME5;
+        hash = rotateLeft(hash, 11) * XXH_PRIME1;
+    }
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//Function to tell whether a path names a precompiled module
+bool isPrecompiledPath(const char* path)
+{
+    const size_t length = strlen(path);
+    const size_t extension = sizeof(PRECOMPILED_EXTENSION) - 1;
+    return length > extension && strcmp(path + length - extension, PRECOMPILED_EXTENSION) == 0;
+}
+
+//Helper to get the length of the directory part of a path, separator included
+static size_t directoryLength(const char* path)
+{
+    size_t length = 0;
+    for (size_t i = 0; path[i] != '\0'; i++)
+    {
+        if (path[i] == '/' || path[i] == '\\') length = i + 1;
+    }
+    return length;
+}
+
+//Helper to copy 'length' bytes of 'prefix' followed by 'suffix' into a new string
+static char* joinPath(const char* prefix, const size_t length, const char* suffix)
+{
+    const size_t suffixLength = strlen(suffix);
+    char* path = malloc(length + suffixLength + 1);
+    if (path == NULL)
+    {
+        fprintf(stderr, "Not enough memory for a path\n");
+        exit(74);
+    }
+    memcpy(path, prefix, length);
+    memcpy(path + length, suffix, suffixLength + 1);
+    return path;
+}
+
+//Helper to name the file a .lkc is written to before it is renamed, unique per process and per call
+static char* temporaryPath(const char* path)
+{
+    static unsigned sequence = 0;
+    char suffix[48];
+    snprintf(suffix, sizeof(suffix), ".tmp.%ld.%u", (long)getpid(), sequence++);
+    return joinPath(path, strlen(path), suffix);
+}
+
+//Helper to write bytes to a .lkc being written, followed by zeros up to the next section
+static void writeSection(FILE* file, const char* path, const void* bytes, const size_t size)
+{
+    static const char padding[PRECOMPILED_ALIGNMENT] = {0};
+    const size_t padded = (size + PRECOMPILED_ALIGNMENT - 1) & ~(size_t)(PRECOMPILED_ALIGNMENT - 1);
+    if ((size > 0 && fwrite(bytes, 1, size, file) != size) ||
+        (padded > size && fwrite(padding, 1, padded - size, file) != padded - size))
+    {
+        fprintf(stderr, "Could not write file \"%s\"\n", path);
+        exit(74);
+    }
+}
+
+//Function to write the tokens of a source loaded from 'sourcePath' to a .lkc at 'path'
+void writePrecompiled(const char* path, const char* sourcePath, const Source* source, TokenBuffer* tokens)
+{
+    //The line table is built lazily, a loaded file must never need to build it
+    if (tokens->lineCount == 0) tokenLine(tokens, 0);
+    const InternTable* interns = tokens->interns;
+    const int symbolCount = interns != NULL ? interns->count : 0;
+
+    //Interned strings are laid out back to back, each keeps its terminator
+    size_t stringBytes = 0;
+    for (int id = 0; id < symbolCount; id++) stringBytes += (size_t)interns->symbols[id].length + 1;
+    PrecompiledSymbol* symbols = malloc(((size_t)symbolCount + 1) * sizeof(PrecompiledSymbol));
+    char* strings = malloc(stringBytes + 1);
+    if (symbols == NULL || strings == NULL)
+    {
+        fprintf(stderr, "Not enough memory to write \"%s\"\n", path);
+        exit(74);
+    }
+    size_t used = 0;
+    for (int id = 0; id < symbolCount; id++)
+    {
+        const Symbol* symbol = &interns->symbols[id];
+        symbols[id].offset = used;
+        symbols[id].length = (uint32_t)symbol->length;
+        symbols[id].hash = symbol->hash;
+        memcpy(strings + used, symbol->chars, (size_t)symbol->length);
+        used += (size_t)symbol->length;
+        strings[used++] = '\0';
+    }
+
+    const char* sourceName = sourcePath + directoryLength(sourcePath);
+    const size_t tokenCount = (size_t)tokens->count;
+    const void* sections[SECTION_COUNT] =
+    {
+        sourceName, tokens->kinds, tokens->offsets, tokens->lengths, tokens->symbols, tokens->literals,
+        tokens->escapedStrings, tokens->lineStarts, symbols, interns != NULL ? interns->slots : NULL, strings
+    };
+    PrecompiledHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, precompiledMagic, sizeof(header.magic));
+    header.version = PRECOMPILED_VERSION;
+    header.byteOrder = PRECOMPILED_BYTE_ORDER;
+    header.literalSize = (uint32_t)sizeof(TokenLiteral);
+    header.sourceHash = hashSource(source->data, source->length);
+    header.sourceLength = source->length;
+    header.tokenCount = (uint32_t)tokenCount;
+    header.literalCount = (uint32_t)tokens->literalCount;
+    header.escapedCount = (uint32_t)tokens->escapedCount;
+    header.lineCount = (uint32_t)tokens->lineCount;
+    header.symbolCount = (uint32_t)symbolCount;
+    header.slotCapacity = interns != NULL ? (uint32_t)interns->slotCapacity : 0;
+    header.sizes[SECTION_SOURCE_NAME] = strlen(sourceName) + 1;
+    header.sizes[SECTION_KINDS] = tokenCount * sizeof(uint8_t);
+    header.sizes[SECTION_OFFSETS] = tokenCount * sizeof(uint32_t);
+    header.sizes[SECTION_LENGTHS] = tokenCount * sizeof(uint32_t);
+    header.sizes[SECTION_SYMBOLS] = tokens->symbols != NULL ? tokenCount * sizeof(uint32_t) : 0;
+    header.sizes[SECTION_LITERALS] = (size_t)tokens->literalCount * sizeof(TokenLiteral);
+    header.sizes[SECTION_ESCAPED] = (size_t)tokens->escapedCount * sizeof(TokenString);
+    header.sizes[SECTION_LINES] = (size_t)tokens->lineCount * sizeof(uint32_t);
+    header.sizes[SECTION_SYMBOL_TABLE] = (size_t)symbolCount * sizeof(PrecompiledSymbol);
+    header.sizes[SECTION_SLOTS] = (size_t)header.slotCapacity * sizeof(SymbolId);
+    header.sizes[SECTION_STRINGS] = stringBytes;
+    uint64_t position = sizeof(PrecompiledHeader);
+    for (int i = 0; i < SECTION_COUNT; i++)
+    {
+        header.offsets[i] = position;
+        position += (header.sizes[i] + PRECOMPILED_ALIGNMENT - 1) & ~(uint64_t)(PRECOMPILED_ALIGNMENT - 1);
+    }
+
+    //Written aside and renamed, so a reader sees either the old file or the whole new one.
+    //Concurrent writers each get their own temporary, the last rename wins
+    char* temporary = temporaryPath(path);
+    FILE* file = fopen(temporary, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Could not write file \"%s\"\n", path);
+        exit(74);
+    }
+    writeSection(file, path, &header, sizeof(header));
+    for (int i = 0; i < SECTION_COUNT; i++) writeSection(file, path, sections[i], header.sizes[i]);
+    if (fclose(file) != 0)
+    {
+        fprintf(stderr, "Could not write file \"%s\"\n", path);
+        exit(74);
+    }
+#ifdef _WIN32
+    remove(path);
+#endif
+    if (rename(temporary, path) != 0)
+    {
+        remove(temporary);
+        fprintf(stderr, "Could not write file \"%s\"\n", path);
+        exit(74);
+    }
+    free(temporary);
+    free(symbols);
+    free(strings);
+}
+
+//Function to lex 'sourcePath' and write it next to itself as a .lkc, false (after reporting them) on lex errors
+bool precompileFile(const char* sourcePath)
+{
+    if (strcmp(sourcePath, "-") == 0)
+    {
+        fprintf(stderr, "Standard input cannot be precompiled\n");
+        return false;
+    }
+    Source source = loadSource(sourcePath);
+    InternTable interns;
+    initInternTable(&interns);
+    TokenBuffer tokens;
+    initTokenBuffer(&tokens);
+    tokens.interns = &interns;
+    tokenizeParallel(&tokens, source.data, source.length, 0);
+    const bool valid = tokens.errorCount == 0;
+    for (int i = 0; i < tokens.errorCount; i++)
+    {
+        fprintf(stderr, "%s:%d: error: %s\n", sourcePath, tokenLine(&tokens, tokens.errors[i].index),
+                tokens.errors[i].message);
+    }
+    if (valid)
+    {
+        //'main.lk' becomes 'main.lkc', any other name gets the extension appended
+        const size_t length = strlen(sourcePath);
+        const bool lyka = length > 3 && strcmp(sourcePath + length - 3, ".lk") == 0;
+        char* path = joinPath(sourcePath, lyka ? length - 3 : length, PRECOMPILED_EXTENSION);
+        writePrecompiled(path, sourcePath, &source, &tokens);
+        free(path);
+    }
+    freeTokenBuffer(&tokens);
+    freeInternTable(&interns);
+    freeSource(&source);
+    return valid;
+}
+
+//Helper to check that a section lies inside the file, is aligned and holds exactly 'size' bytes
+static bool validSection(const PrecompiledHeader* header, const size_t fileSize, const int section,
+                         const uint64_t size)
+{
+    const uint64_t offset = header->offsets[section];
+    return header->sizes[section] == size && offset % PRECOMPILED_ALIGNMENT == 0 && offset <= fileSize &&
+           size <= fileSize - offset;
+}
+
+//Helper to check the layout of a header against the size of its file
+static bool validHeader(const PrecompiledHeader* header, const size_t fileSize)
+{
+    const uint64_t tokens = header->tokenCount;
+    //Slot 0 of the intern table always exists, and the hash set is a power of two when not empty
+    //A source without names or strings never grew the hash set
+    const bool internsValid = header->symbolCount >= 1 &&
+                              (header->slotCapacity & (header->slotCapacity - 1)) == 0 &&
+                              (header->slotCapacity == 0 ? header->symbolCount == 1
+                                                         : header->slotCapacity >= header->symbolCount);
+    return header->byteOrder == PRECOMPILED_BYTE_ORDER && header->literalSize == sizeof(TokenLiteral) &&
+           tokens >= 1 && internsValid && header->sizes[SECTION_SOURCE_NAME] >= 2 &&
+           validSection(header, fileSize, SECTION_SOURCE_NAME, header->sizes[SECTION_SOURCE_NAME]) &&
+           validSection(header, fileSize, SECTION_KINDS, tokens * sizeof(uint8_t)) &&
+           validSection(header, fileSize, SECTION_OFFSETS, tokens * sizeof(uint32_t)) &&
+           validSection(header, fileSize, SECTION_LENGTHS, tokens * sizeof(uint32_t)) &&
+           validSection(header, fileSize, SECTION_SYMBOLS, tokens * sizeof(uint32_t)) &&
+           validSection(header, fileSize, SECTION_LITERALS, (uint64_t)header->literalCount * sizeof(TokenLiteral)) &&
+           validSection(header, fileSize, SECTION_ESCAPED, (uint64_t)header->escapedCount * sizeof(TokenString)) &&
+           validSection(header, fileSize, SECTION_LINES, (uint64_t)header->lineCount * sizeof(uint32_t)) &&
+           validSection(header, fileSize, SECTION_SYMBOL_TABLE,
+                        (uint64_t)header->symbolCount * sizeof(PrecompiledSymbol)) &&
+           validSection(header, fileSize, SECTION_SLOTS, (uint64_t)header->slotCapacity * sizeof(SymbolId)) &&
+           validSection(header, fileSize, SECTION_STRINGS, header->sizes[SECTION_STRINGS]) &&
+           header->lineCount >= 1;
+}
+
+//Helper to rebuild the intern table of a mapped file, the strings stay in the mapping
+static bool loadInterns(InternTable* table, const PrecompiledHeader* header, const char* base)
+{
+    const PrecompiledSymbol* symbols = (const PrecompiledSymbol*)(base + header->offsets[SECTION_SYMBOL_TABLE]);
+    const char* strings = base + header->offsets[SECTION_STRINGS];
+    const uint64_t stringBytes = header->sizes[SECTION_STRINGS];
+    initArena(&table->strings);
+    table->count = (int)header->symbolCount;
+    table->capacity = table->count;
+    table->symbols = growArray(NULL, table->capacity, sizeof(Symbol));
+    table->slotCapacity = (int)header->slotCapacity;
+    table->slots = NULL;
+    if (table->slotCapacity > 0)
+    {
+        table->slots = growArray(NULL, table->slotCapacity, sizeof(SymbolId));
+        memcpy(table->slots, base + header->offsets[SECTION_SLOTS], (size_t)table->slotCapacity * sizeof(SymbolId));
+    }
+    for (int id = 0; id < table->count; id++)
+    {
+        const PrecompiledSymbol* symbol = &symbols[id];
+        if (symbol->offset >= stringBytes || symbol->length >= stringBytes - symbol->offset ||
+            strings[symbol->offset + symbol->length] != '\0')
+        {
+            return false;
+        }
+        table->symbols[id].chars = strings + symbol->offset;
+        table->symbols[id].length = (int)symbol->length;
+        table->symbols[id].hash = symbol->hash;
+    }
+    for (int slot = 0; slot < table->slotCapacity; slot++)
+    {
+        if (table->slots[slot] >= (SymbolId)table->count) return false;
+    }
+    return true;
+}
+
+//Helper to check that the entries of a side list (literals or escaped strings) name tokens in rising order
+static bool validIndices(const void* entries, const size_t size, const int count, const int tokenCount)
+{
+    int previous = -1;
+    for (int i = 0; i < count; i++)
+    {
+        //Every entry type starts with the index of its token
+        int index;
+        memcpy(&index, (const char*)entries + (size_t)i * size, sizeof(int));
+        if (index <= previous || index >= tokenCount) return false;
+        previous = index;
+    }
+    return true;
+}
+
+//Helper to check every index and offset the body of a file holds, so later stages can trust them.
+//One pass over the tokens, which costs less than the hash of the source already taken
+static bool validBody(const TokenBuffer* tokens, const size_t sourceLength, const int symbolCount)
+{
+    uint32_t previous = 0;
+    for (int i = 0; i < tokens->count; i++)
+    {
+        //Files are only written for sources without lex errors, and TOKEN_DOT_DOT is the last kind
+        const uint8_t kind = tokens->kinds[i];
+        const uint32_t offset = tokens->offsets[i];
+        if (kind > TOKEN_DOT_DOT || kind == TOKEN_ERROR || offset < previous ||
+            (uint64_t)offset + tokens->lengths[i] > sourceLength || tokens->symbols[i] >= (uint32_t)symbolCount)
+        {
+            return false;
+        }
+        previous = offset;
+    }
+    if (!validIndices(tokens->literals, sizeof(TokenLiteral), tokens->literalCount, tokens->count) ||
+        !validIndices(tokens->escapedStrings, sizeof(TokenString), tokens->escapedCount, tokens->count))
+    {
+        return false;
+    }
+    //Line starts rise from 0 and stay inside the source
+    if (tokens->lineStarts[0] != 0) return false;
+    for (int i = 1; i < tokens->lineCount; i++)
+    {
+        if (tokens->lineStarts[i] <= tokens->lineStarts[i - 1] || tokens->lineStarts[i] > sourceLength) return false;
+    }
+    return true;
+}
+
+//Function to map a .lkc and check it against its source
+PrecompiledStatus openPrecompiled(PrecompiledModule* module, const char* path)
+{
+    memset(module, 0, sizeof(PrecompiledModule));
+    const char* error;
+    if (!tryLoadSource(path, &module->file, &error)) return PRECOMPILED_UNREADABLE;
+    const char* base = module->file.data;
+    const size_t fileSize = module->file.length;
+    PrecompiledHeader header;
+    if (fileSize < sizeof(header)) return PRECOMPILED_INVALID;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, precompiledMagic, sizeof(header.magic)) != 0) return PRECOMPILED_INVALID;
+    if (header.version != PRECOMPILED_VERSION) return PRECOMPILED_VERSION_MISMATCH;
+    if (!validHeader(&header, fileSize)) return PRECOMPILED_INVALID;
+    const char* sourceName = base + header.offsets[SECTION_SOURCE_NAME];
+    if (sourceName[header.sizes[SECTION_SOURCE_NAME] - 1] != '\0') return PRECOMPILED_INVALID;
+
+    //The source sits next to the .lkc, wherever the pair was moved to
+    module->sourcePath = joinPath(path, directoryLength(path), sourceName);
+    //A source that cannot be read any more is as stale as an edited one
+    if (!tryLoadSource(module->sourcePath, &module->source, &error)) return PRECOMPILED_STALE;
+    if (module->source.length != header.sourceLength ||
+        hashSource(module->source.data, module->source.length) != header.sourceHash)
+    {
+        return PRECOMPILED_STALE;
+    }
+
+    if (!loadInterns(&module->interns, &header, base)) return PRECOMPILED_INVALID;
+    TokenBuffer* tokens = &module->tokens;
+    initTokenBuffer(tokens);
+    tokens->source = module->source.data;
+    tokens->kinds = (uint8_t*)(base + header.offsets[SECTION_KINDS]);
+    tokens->offsets = (uint32_t*)(base + header.offsets[SECTION_OFFSETS]);
+    tokens->lengths = (uint32_t*)(base + header.offsets[SECTION_LENGTHS]);
+    tokens->symbols = (uint32_t*)(base + header.offsets[SECTION_SYMBOLS]);
+    tokens->interns = &module->interns;
+    tokens->count = (int)header.tokenCount;
+    tokens->capacity = tokens->count;
+    tokens->literals = (TokenLiteral*)(base + header.offsets[SECTION_LITERALS]);
+    tokens->literalCount = (int)header.literalCount;
+    tokens->literalCapacity = tokens->literalCount;
+    tokens->escapedStrings = (TokenString*)(base + header.offsets[SECTION_ESCAPED]);
+    tokens->escapedCount = (int)header.escapedCount;
+    tokens->escapedCapacity = tokens->escapedCount;
+    tokens->lineStarts = (uint32_t*)(base + header.offsets[SECTION_LINES]);
+    tokens->lineCount = (int)header.lineCount;
+    //The stream always ends in EOF at the end of the source
+    if (tokens->kinds[tokens->count - 1] != TOKEN_EOF ||
+        tokens->offsets[tokens->count - 1] != (uint32_t)module->source.length ||
+        !validBody(tokens, module->source.length, module->interns.count))
+    {
+        return PRECOMPILED_INVALID;
+    }
+    return PRECOMPILED_OK;
+}
+
+//Function to release an opened precompiled module, also after a failed open
+void closePrecompiled(PrecompiledModule* module)
+{
+    if (module->interns.symbols != NULL) freeInternTable(&module->interns);
+    freeSource(&module->source);
+    freeSource(&module->file);
+    free(module->sourcePath);
+    memset(module, 0, sizeof(PrecompiledModule));
+}
+
+//Function to describe a status in an error message
+const char* precompiledStatusMessage(const PrecompiledStatus status)
+{
+    switch (status)
+    {
+    case PRECOMPILED_OK: return "up to date";
+    case PRECOMPILED_INVALID: return "not a valid precompiled module";
+    case PRECOMPILED_VERSION_MISMATCH: return "from another version of Lyka";
+    case PRECOMPILED_STALE: return "out of date, its source changed";
+    case PRECOMPILED_UNREADABLE: return "not readable";
+    }
+    return "unknown status";
+}
@@ -0,0 +1,75 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef PRECOMPILED_H
+#define PRECOMPILED_H
+
+#include "intern.h"
+#include "source.h"
+#include "token.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Precompiled modules ('.lkc', written by 'lyka --compile'). The file holds the
+//token stream of a module exactly as it sits in a TokenBuffer: the kind,
+//offset, length and symbol arrays, the decoded number literals (the constant
+//pool), the decoded lengths of escaped strings, the line table, and the
+//interned strings with their hash set. Every section starts 8-byte aligned,
+//so a loaded file is mapped and the buffer points straight into it; only the
+//symbol table is rebuilt, since it holds pointers. Lexemes still point into the source, which is expected next to
+//the .lkc under the name recorded in its header. That source is loaded with
+//loadSource() and its xxHash64 must match the one recorded, otherwise the
+//file is stale. A file from another version, byte order or ABI is rejected.
+
+//Bump whenever the layout of the file or the meaning of a token kind changes
+#define PRECOMPILED_VERSION 2
+//Extension of precompiled modules
+#define PRECOMPILED_EXTENSION ".lkc"
+
+//Enum to hold the outcome of opening a precompiled module
+typedef enum
+{
+    PRECOMPILED_OK,
+    PRECOMPILED_INVALID,   //Not a .lkc file, or a truncated one
+    PRECOMPILED_VERSION_MISMATCH,
+    PRECOMPILED_STALE,     //The source changed since the file was written
+    PRECOMPILED_UNREADABLE //The file could not be opened or read
+} PrecompiledStatus;
+
+//Struct to hold an opened precompiled module. 'tokens' points into the mapped
+//file, so it is read-only and must be released with closePrecompiled(), never
+//with freeTokenBuffer(). 'interns' is a regular table and may be interned into
+typedef struct
+{
+    Source file;          //The mapped .lkc
+    Source source;        //The source it was compiled from
+    char* sourcePath;     //Path of that source, set as soon as the header could be read
+    TokenBuffer tokens;
+    InternTable interns;
+} PrecompiledModule;
+
+//Function to get the xxHash64 of a source, as recorded in precompiled modules
+uint64_t hashSource(const char* data, size_t length);
+//Function to tell whether a path names a precompiled module
+bool isPrecompiledPath(const char* path);
+//Function to write the tokens of a source loaded from 'sourcePath' (lexed with interns) to a .lkc at 'path'.
+//The file is written under a temporary name and renamed, so readers never see half of one
+void writePrecompiled(const char* path, const char* sourcePath, const Source* source, TokenBuffer* tokens);
+//Function to lex 'sourcePath' and write it next to itself as a .lkc, false (after reporting them) on lex errors
+bool precompileFile(const char* sourcePath);
+//Function to map a .lkc and check it against its source
+PrecompiledStatus openPrecompiled(PrecompiledModule* module, const char* path);
+//Function to release an opened precompiled module, also after a failed open
+void closePrecompiled(PrecompiledModule* module);
+//Function to describe a status in an error message
+const char* precompiledStatusMessage(PrecompiledStatus status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PRECOMPILED_H
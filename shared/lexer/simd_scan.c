@@ -0,0 +1,265 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "simd_scan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//Pick the widest block scanner the target was compiled for
+#if !defined(LYKA_NO_SIMD) && defined(__AVX2__)
+#define SCAN_AVX2
+#include <immintrin.h>
+#elif !defined(LYKA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SCAN_SSE2
+#include <emmintrin.h>
+#elif !defined(LYKA_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(SCAN_AVX2) || defined(SCAN_SSE2) || defined(SCAN_NEON)
+#define SCAN_VECTOR
+
+//Block loads read past the end of the buffer on purpose (see alignBlock), which AddressSanitizer
+//would report on every heap source. Only the load is exempt, the callers stay checked
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SCAN_NO_ASAN __declspec(no_sanitize_address)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SCAN_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define SCAN_NO_ASAN
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+//Helper to find the lowest set bit
+static inline int lowestBit(const uint64_t bits)
+{
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+}
+//Helper to count the set bits
+static inline int countBits(const uint64_t bits)
+{
+    return (int)__popcnt64(bits);
+}
+#else
+//Helper to find the lowest set bit
+static inline int lowestBit(const uint64_t bits)
+{
+    return __builtin_ctzll(bits);
+}
+//Helper to count the set bits
+static inline int countBits(const uint64_t bits)
+{
+    return __builtin_popcountll(bits);
+}
+#endif
+
+//Every block helper returns one group of SCAN_STRIDE bits per byte (bit 0 = lowest address)
+#if defined(SCAN_AVX2)
+#define SCAN_BLOCK 32
+#define SCAN_STRIDE 1
+#define SCAN_FULL UINT64_C(0xFFFFFFFF)
+typedef __m256i ScanBlock;
+//Helper to load an aligned block
+SCAN_NO_ASAN static inline ScanBlock loadBlock(const char* block)
+{
+    return _mm256_load_si256((const __m256i*)block);
+}
+//Helper to get the bits of the bytes equal to 'c'
+static inline ScanBlock equalTo(const ScanBlock bytes, const char c)
+{
+    return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+//Helper to combine two comparisons
+static inline ScanBlock either(const ScanBlock a, const ScanBlock b)
+{
+    return _mm256_or_si256(a, b);
+}
+//Helper to turn a comparison into a bit mask
+static inline uint64_t toBits(const ScanBlock cmp)
+{
+    return (uint32_t)_mm256_movemask_epi8(cmp);
+}
+#elif defined(SCAN_SSE2)
+#define SCAN_BLOCK 16
+#define SCAN_STRIDE 1
+#define SCAN_FULL UINT64_C(0xFFFF)
+typedef __m128i ScanBlock;
+//Helper to load an aligned block
+SCAN_NO_ASAN static inline ScanBlock loadBlock(const char* block)
+{
+    return _mm_load_si128((const __m128i*)block);
+}
+//Helper to get the bits of the bytes equal to 'c'
+static inline ScanBlock equalTo(const ScanBlock bytes, const char c)
+{
+    return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+}
+//Helper to combine two comparisons
+static inline ScanBlock either(const ScanBlock a, const ScanBlock b)
+{
+    return _mm_or_si128(a, b);
+}
+//Helper to turn a comparison into a bit mask
+static inline uint64_t toBits(const ScanBlock cmp)
+{
+    return (uint32_t)_mm_movemask_epi8(cmp);
+}
+#else
+#define SCAN_BLOCK 16
+//NEON has no movemask, narrowing by 4 leaves a nibble per byte instead
+#define SCAN_STRIDE 4
+#define SCAN_FULL UINT64_MAX
+typedef uint8x16_t ScanBlock;
+//Helper to load an aligned block
+SCAN_NO_ASAN static inline ScanBlock loadBlock(const char* block)
+{
+    return vld1q_u8((const uint8_t*)block);
+}
+//Helper to get the bits of the bytes equal to 'c'
+static inline ScanBlock equalTo(const ScanBlock bytes, const char c)
+{
+    return vceqq_u8(bytes, vdupq_n_u8((uint8_t)c));
+}
+//Helper to combine two comparisons
+static inline ScanBlock either(const ScanBlock a, const ScanBlock b)
+{
+    return vorrq_u8(a, b);
+}
+//Helper to turn a comparison into a bit mask
+static inline uint64_t toBits(const ScanBlock cmp)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+}
+#endif
+
+//Blocks are always read from an aligned address, so a load never crosses into the
+//next page and reading the bytes that follow the '\0' sentinel cannot fault.
+//Helper to align a pointer down to its block and get the mask of the bytes at or after it
+static inline const char* alignBlock(const char* current, uint64_t* live)
+{
+    const uintptr_t offset = (uintptr_t)current & (SCAN_BLOCK - 1);
+    *live = (SCAN_FULL << (offset * SCAN_STRIDE)) & SCAN_FULL;
+    return current - offset;
+}
+#endif //SCAN_VECTOR
+
+//Helper to check for the characters skipped between tokens
+static inline bool isBlank(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+//Function that skips a run of ' ', '\t', '\r' and '\n', adding the newlines it crossed to 'line'
+const char* skipBlankRun(const char* current, int* line)
+{
+    //Most runs between tokens are a single space, so settle those without touching a vector
+    if (!isBlank(current[0])) return current;
+    if (!isBlank(current[1]))
+    {
+        if (current[0] == '\n') (*line)++;
+        return current + 1;
+    }
+#ifdef SCAN_VECTOR
+    uint64_t live;
+    const char* block = alignBlock(current, &live);
+    while (true)
+    {
+        const ScanBlock bytes = loadBlock(block);
+        const ScanBlock newline = equalTo(bytes, '\n');
+        const ScanBlock blank = either(either(newline, equalTo(bytes, ' ')),
+                                       either(equalTo(bytes, '\t'), equalTo(bytes, '\r')));
+        const uint64_t newlines = toBits(newline) & live;
+        const uint64_t stops = ~toBits(blank) & live;
+        if (stops != 0)
+        {
+            //Only count the newlines in front of the first non-blank byte
+            const int index = lowestBit(stops) / SCAN_STRIDE;
+            const uint64_t before = (UINT64_C(1) << (index * SCAN_STRIDE)) - 1;
+            *line += countBits(newlines & before) / SCAN_STRIDE;
+            return block + index;
+        }
+        *line += countBits(newlines) / SCAN_STRIDE;
+        block += SCAN_BLOCK;
+        live = SCAN_FULL;
+    }
+#else
+    while (isBlank(*current))
+    {
+        if (*current == '\n') (*line)++;
+        current++;
+    }
+    return current;
+#endif
+}
+
+//Function that returns a pointer to the next '\n' or to the '\0' sentinel
+const char* findLineEnd(const char* current)
+{
+#ifdef SCAN_VECTOR
+    uint64_t live;
+    const char* block = alignBlock(current, &live);
+    while (true)
+    {
+        const ScanBlock bytes = loadBlock(block);
+        const uint64_t stops = toBits(either(equalTo(bytes, '\n'), equalTo(bytes, '\0'))) & live;
+        if (stops != 0)
+        {
+            return block + lowestBit(stops) / SCAN_STRIDE;
+        }
+        block += SCAN_BLOCK;
+        live = SCAN_FULL;
+    }
+#else
+    while (*current != '\n' && *current != '\0')
+    {
+        current++;
+    }
+    return current;
+#endif
+}
+
+//Function that returns a pointer to the next '"', '\\', '\n' or to the '\0' sentinel (the stops inside a string literal)
+const char* findStringStop(const char* current)
+{
+#ifdef SCAN_VECTOR
+    uint64_t live;
+    const char* block = alignBlock(current, &live);
+    while (true)
+    {
+        const ScanBlock bytes = loadBlock(block);
+        const ScanBlock stop = either(either(equalTo(bytes, '"'), equalTo(bytes, '\\')),
+                                      either(equalTo(bytes, '\n'), equalTo(bytes, '\0')));
+        const uint64_t stops = toBits(stop) & live;
+        if (stops != 0)
+        {
+            return block + lowestBit(stops) / SCAN_STRIDE;
+        }
+        block += SCAN_BLOCK;
+        live = SCAN_FULL;
+    }
+#else
+    while (*current != '"' && *current != '\\' && *current != '\n' && *current != '\0')
+    {
+        current++;
+    }
+    return current;
+#endif
+}
+
+//Function that names the block scanner compiled in ("avx2", "sse2", "neon" or "scalar")
+const char* simdScanMode(void)
+{
+#if defined(SCAN_AVX2)
+    return "avx2";
+#elif defined(SCAN_SSE2)
+    return "sse2";
+#elif defined(SCAN_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,24 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+//Block scanning helpers used by the lexer's hot loops. Each one works on a '\0'
+//terminated buffer and picks AVX2, SSE2 or NEON at compile time, falling back
+//to a plain byte loop (also forced by defining LYKA_NO_SIMD). The block
+//scanners read whole aligned blocks, so they read up to a block less one byte
+//in front of 'current' and behind the sentinel. An aligned load never crosses
+//a page, so this cannot fault, but those bytes may not belong to the buffer;
+//the loads are exempt from AddressSanitizer for that reason
+
+//Function that skips a run of ' ', '\t', '\r' and '\n', adding the newlines it crossed to 'line'
+const char* skipBlankRun(const char* current, int* line);
+//Function that returns a pointer to the next '\n' or to the '\0' sentinel
+const char* findLineEnd(const char* current);
+//Function that returns a pointer to the next '"', '\\', '\n' or to the '\0' sentinel (the stops inside a string literal)
+const char* findStringStop(const char* current);
+//Function that names the block scanner compiled in ("avx2", "sse2", "neon" or "scalar")
+const char* simdScanMode(void);
+
+#endif //SIMD_SCAN_H
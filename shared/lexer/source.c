@@ -0,0 +1,178 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#endif
+
+#include "source.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+//Size of the first chunk used when the input size is not known up front
+#define SOURCE_CHUNK_SIZE (64 * 1024)
+
+//Function that reads a stream chunk by chunk into a growing, '\0' terminated heap buffer, false on a read error
+static bool readChunks(FILE* file, const char* path, Source* source)
+{
+    size_t capacity = SOURCE_CHUNK_SIZE;
+    size_t length = 0;
+    char* buffer = malloc(capacity);
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Not enough memory to read \"%s\"\n", path);
+        exit(74);
+    }
+    while (true)
+    {
+        //Always keep one byte free for the sentinel
+        if (capacity - length < 2)
+        {
+            capacity *= 2;
+            char* grown = realloc(buffer, capacity);
+            if (grown == NULL)
+            {
+                free(buffer);
+                fprintf(stderr, "Not enough memory to read \"%s\"\n", path);
+                exit(74);
+            }
+            buffer = grown;
+        }
+        const size_t bytesRead = fread(buffer + length, 1, capacity - length - 1, file);
+        length += bytesRead;
+        if (bytesRead == 0)
+        {
+            if (ferror(file))
+            {
+                free(buffer);
+                return false;
+            }
+            break;
+        }
+    }
+    buffer[length] = '\0';
+
+    source->data = buffer;
+    source->length = length;
+    source->mapSize = 0;
+    return true;
+}
+
+#ifndef _WIN32
+//Function that maps a regular file read-only and places a zero page behind it as the sentinel
+static bool mapRegularFile(const int fd, const size_t size, Source* source)
+{
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    //Round up so there is always at least one zero byte past the end of the file
+    const size_t mapSize = (size + 1 + pageSize - 1) / pageSize * pageSize;
+    //Reserve the whole range as zeroed anonymous memory first
+    char* base = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return false;
+    //Then lay the file over the front of it, the tail of the last file page is zero filled by the kernel
+    if (mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(base, mapSize);
+        return false;
+    }
+    posix_madvise(base, size, POSIX_MADV_SEQUENTIAL);
+
+    source->data = base;
+    source->length = size;
+    source->mapSize = mapSize;
+    return true;
+}
+#endif
+
+//Function to load a file ("-" for stdin) without exiting, false with 'error' set when it cannot be read
+bool tryLoadSource(const char* path, Source* source, const char** error)
+{
+    *error = "Could not read file";
+    //Standard input is never seekable, so it always takes the chunked path
+    if (strcmp(path, "-") == 0)
+    {
+        return readChunks(stdin, "<stdin>", source);
+    }
+#ifndef _WIN32
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        *error = "Could not open file";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        *error = "Could not determine size of file";
+        return false;
+    }
+    //Only non-empty regular files can be mapped, pipes and devices fall through to chunked reads
+    if (S_ISREG(info.st_mode) && info.st_size > 0 && mapRegularFile(fd, (size_t)info.st_size, source))
+    {
+        close(fd);
+        return true;
+    }
+    FILE* file = fdopen(fd, "rb");
+    if (file == NULL)
+    {
+        close(fd);
+        *error = "Could not open file";
+        return false;
+    }
+#else
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        *error = "Could not open file";
+        return false;
+    }
+#endif
+    const bool loaded = readChunks(file, path, source);
+    fclose(file);
+    return loaded;
+}
+
+//Function to load a file ("-" for stdin) - regular files are mapped, everything else is read in chunks
+Source loadSource(const char* path)
+{
+    Source source;
+    const char* error;
+    if (!tryLoadSource(path, &source, &error))
+    {
+        fprintf(stderr, "%s \"%s\"\n", error, strcmp(path, "-") == 0 ? "<stdin>" : path);
+        exit(74);
+    }
+    return source;
+}
+
+//Function to release a loaded source
+void freeSource(Source* source)
+{
+    if (source->data == NULL) return;
+#ifndef _WIN32
+    if (source->mapSize > 0)
+    {
+        munmap((void*)source->data, source->mapSize);
+    }
+    else
+#endif
+    {
+        free((void*)source->data);
+    }
+    source->data = NULL;
+    source->length = 0;
+    source->mapSize = 0;
+}
@@ -0,0 +1,33 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Struct to hold a loaded source file
+typedef struct
+{
+    const char* data; //Source bytes, always followed by a '\0' sentinel
+    size_t length;    //Number of source bytes (sentinel excluded)
+    size_t mapSize;   //Size of the read-only mapping, 0 when 'data' is on the heap
+} Source;
+
+//Function to load a file ("-" for stdin) - regular files are mapped, everything else is read in chunks
+Source loadSource(const char* path);
+//Function to load a file like loadSource() without exiting, false with 'error' set when it cannot be read
+bool tryLoadSource(const char* path, Source* source, const char** error);
+//Function to release a loaded source
+void freeSource(Source* source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SOURCE_H
@@ -0,0 +1,92 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "stats.h"
+#include <stdio.h>
+#include <string.h>
+
+//Names of the phases, as they appear in the report
+static const char* const phaseNames[PHASE_COUNT] =
+{
+    "read", "lex", "parse", "resolve", "evaluate", "optimize", "codegen", "link"
+};
+
+//Function to parse the value of a '--time-report' or '--stats[=text|json]' flag, false when 'arg' is neither
+bool parseStatsFlag(const char* arg, StatsFormat* format)
+{
+    if (strcmp(arg, "--time-report") == 0 || strcmp(arg, "--stats") == 0 || strcmp(arg, "--stats=text") == 0)
+    {
+        *format = STATS_TEXT;
+        return true;
+    }
+    if (strcmp(arg, "--stats=json") == 0)
+    {
+        *format = STATS_JSON;
+        return true;
+    }
+    return false;
+}
+
+//Helper to write a string as a JSON string literal
+static void printJsonString(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* c = text; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\') fprintf(file, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) fprintf(file, "\\u%04x", (unsigned)*c);
+        else fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+//Function to print the report of a run, 'passes' (may be NULL) lists the LLVM passes that ran
+void printStats(FILE* file, const Stats* stats, const StatsFormat format, const PassTime* passes, const int passCount)
+{
+    const double wall = statsClock() - stats->startTime;
+    const double lexSeconds = stats->phaseSeconds[PHASE_LEX];
+    const double tokensPerSecond = lexSeconds > 0 ? (double)stats->tokenCount / lexSeconds : 0;
+    if (format == STATS_JSON)
+    {
+        fprintf(file, "{\"wallSeconds\": %.6f, \"phases\": {", wall);
+        bool first = true;
+        for (int i = 0; i < PHASE_COUNT; i++)
+        {
+            if (!stats->phaseRan[i]) continue;
+            fprintf(file, "%s\"%s\": %.6f", first ? "" : ", ", phaseNames[i], stats->phaseSeconds[i]);
+            first = false;
+        }
+        fprintf(file, "}, \"modules\": %zu, \"sourceBytes\": %zu, \"tokens\": %zu, \"tokensPerSecond\": %.0f, "
+                      "\"astNodes\": %zu, \"arenaBytes\": %zu, \"arenaPeakBytes\": %zu, \"passes\": [",
+                stats->moduleCount, stats->sourceBytes, stats->tokenCount, tokensPerSecond,
+                stats->nodeCount, stats->arenaBytes, stats->arenaPeakBytes);
+        for (int i = 0; i < passCount; i++)
+        {
+            fprintf(file, "%s{\"name\": ", i == 0 ? "" : ", ");
+            printJsonString(file, passes[i].name);
+            fprintf(file, ", \"seconds\": %.6f, \"runs\": %d}", passes[i].seconds, passes[i].runs);
+        }
+        fprintf(file, "]}\n");
+        return;
+    }
+
+    fprintf(file, "===== Lyka time report =====\n");
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        if (!stats->phaseRan[i]) continue;
+        fprintf(file, "  %-10s %10.6f s %6.1f%%\n", phaseNames[i], stats->phaseSeconds[i],
+                wall > 0 ? 100.0 * stats->phaseSeconds[i] / wall : 0.0);
+    }
+    fprintf(file, "  %-10s %10.6f s\n", "wall", wall);
+    fprintf(file, "  modules %zu, source %zu bytes, tokens %zu (%.2f M tokens/s), AST nodes %zu\n",
+            stats->moduleCount, stats->sourceBytes, stats->tokenCount, tokensPerSecond / 1e6, stats->nodeCount);
+    fprintf(file, "  arena %zu bytes (peak %zu bytes)\n", stats->arenaBytes, stats->arenaPeakBytes);
+    if (passCount > 0)
+    {
+        fprintf(file, "  LLVM passes (exclusive time, runs):\n");
+        for (int i = 0; i < passCount; i++)
+        {
+            fprintf(file, "    %-44s %10.6f s %6d\n", passes[i].name, passes[i].seconds, passes[i].runs);
+        }
+    }
+}
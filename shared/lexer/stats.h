@@ -0,0 +1,105 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Both binaries time the phases of a run with '--time-report' (text) or
+//'--stats=json'. When modules are processed by several workers, the time of a
+//phase is summed over the workers and can add up to more than the wall time.
+//The report goes to stderr so it never mixes with the program's own output.
+
+//Enum to hold the phases of a run
+typedef enum
+{
+    PHASE_READ,
+    PHASE_LEX,
+    PHASE_PARSE,
+    PHASE_RESOLVE,
+    PHASE_EVALUATE,
+    PHASE_OPTIMIZE,
+    PHASE_CODEGEN,
+    PHASE_LINK,
+    PHASE_COUNT
+} Phase;
+
+//Enum to hold the formats of the report
+typedef enum
+{
+    STATS_OFF,
+    STATS_TEXT,
+    STATS_JSON
+} StatsFormat;
+
+//Struct to hold the time and run count of one LLVM pass
+typedef struct
+{
+    const char* name;
+    double seconds;   //Exclusive, passes nested inside it are not included
+    int runs;
+} PassTime;
+
+//Struct to hold the measurements of one run
+typedef struct
+{
+    double startTime;
+    double phaseSeconds[PHASE_COUNT];
+    bool phaseRan[PHASE_COUNT];
+    size_t moduleCount;
+    size_t sourceBytes;
+    size_t tokenCount;
+    size_t nodeCount;
+    size_t arenaBytes;     //Bytes handed out by the arenas of the run
+    size_t arenaPeakBytes;
+} Stats;
+
+//Function to read a wall clock in seconds
+static inline double statsClock(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+//Function to start measuring a run
+static inline void initStats(Stats* stats)
+{
+    memset(stats, 0, sizeof(Stats));
+    stats->startTime = statsClock();
+}
+
+//Function to charge 'seconds' to a phase
+static inline void addPhaseSeconds(Stats* stats, const Phase phase, const double seconds)
+{
+    stats->phaseSeconds[phase] += seconds;
+    stats->phaseRan[phase] = true;
+}
+
+//Function to charge the time since 'start' to a phase, returns the current time so phases can be chained
+static inline double addPhaseTime(Stats* stats, const Phase phase, const double start)
+{
+    const double now = statsClock();
+    addPhaseSeconds(stats, phase, now - start);
+    return now;
+}
+
+//Function to parse the value of a '--time-report' or '--stats[=text|json]' flag, false when 'arg' is neither
+bool parseStatsFlag(const char* arg, StatsFormat* format);
+//Function to print the report of a run, 'passes' (may be NULL) lists the LLVM passes that ran
+void printStats(FILE* file, const Stats* stats, StatsFormat format, const PassTime* passes, int passCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //STATS_H
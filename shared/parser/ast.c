@@ -0,0 +1,78 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "ast.h"
+#include "common.h"
+#include <string.h>
+
+//Node kinds are stored in a single byte
+_Static_assert(NODE_PROGRAM <= UINT8_MAX, "NodeKind no longer fits in a byte");
+
+//Function to initialize an empty tree over a token stream
+void initAst(Ast* ast, const TokenBuffer* tokens)
+{
+    memset(ast, 0, sizeof(Ast));
+    ast->tokens = tokens;
+    //Reserve slot 0 so NODE_NONE never names a real node
+    addNode(ast, NODE_INVALID, 0, 0, 0);
+    ast->root = NODE_NONE;
+}
+
+//Function to release a tree
+void freeAst(Ast* ast)
+{
+    free(ast->kinds);
+    free(ast->flags);
+    free(ast->mainTokens);
+    free(ast->data);
+    free(ast->extra);
+    memset(ast, 0, sizeof(Ast));
+}
+
+//Function to append a node and get its id
+NodeId addNode(Ast* ast, const NodeKind kind, const uint32_t token, const uint32_t lhs, const uint32_t rhs)
+{
+    if (ast->count == ast->capacity)
+    {
+        const int capacity = GROW_CAPACITY(ast->capacity);
+        ast->kinds = growArray(ast->kinds, capacity, sizeof(uint8_t));
+        ast->flags = growArray(ast->flags, capacity, sizeof(uint8_t));
+        ast->mainTokens = growArray(ast->mainTokens, capacity, sizeof(uint32_t));
+        ast->data = growArray(ast->data, capacity, sizeof(NodeData));
+        ast->capacity = capacity;
+    }
+    const NodeId node = (NodeId)ast->count++;
+    ast->kinds[node] = (uint8_t)kind;
+    ast->flags[node] = 0;
+    ast->mainTokens[node] = token;
+    ast->data[node].lhs = lhs;
+    ast->data[node].rhs = rhs;
+    return node;
+}
+
+//Function to append words to the extra array, returns the index of the first one
+uint32_t addExtra(Ast* ast, const uint32_t* words, const int count)
+{
+    if (count == 0) return (uint32_t)ast->extraCount;
+    if (ast->extraCount + count > ast->extraCapacity)
+    {
+        int capacity = ast->extraCapacity;
+        while (capacity < ast->extraCount + count)
+        {
+            capacity = GROW_CAPACITY(capacity);
+        }
+        ast->extra = growArray(ast->extra, capacity, sizeof(uint32_t));
+        ast->extraCapacity = capacity;
+    }
+    const uint32_t index = (uint32_t)ast->extraCount;
+    memcpy(ast->extra + index, words, (size_t)count * sizeof(uint32_t));
+    ast->extraCount += count;
+    return index;
+}
+
+//Function to store a list of nodes in extra, sets [start, end) of the range
+void addNodeList(Ast* ast, const NodeId* nodes, const int count, uint32_t* start, uint32_t* end)
+{
+    *start = addExtra(ast, nodes, count);
+    *end = *start + (uint32_t)count;
+}
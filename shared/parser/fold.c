@@ -0,0 +1,589 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "fold.h"
+#include "common.h"
+#include "lexer.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+//Struct to hold a value known at compile time
+typedef struct
+{
+    TypeKind type;       //TYPE_I64 or TYPE_F64 while untyped
+    bool untyped;        //Only literals went into it so far
+    union
+    {
+        int64_t i;       //Signed and untyped integers, bools (0 or 1)
+        uint64_t u;      //Unsigned integers
+        double f;
+    } as;
+} Constant;
+
+//Struct to hold the state of one folding run
+typedef struct
+{
+    Ast* ast;
+    const NodeId* declarations;
+    NodeId* owners;      //Indexed by NodeId, the function a declaration was folded in (0 until it is)
+    NodeId function;     //Function (or program) whose body is being folded
+    int folded;
+} Folder;
+
+static void foldNode(Folder* folder, NodeId node);
+
+//-------------------------------------------------
+//Reading and writing constants
+//-------------------------------------------------
+
+//Helper to read the value of a literal or an already folded node, false when it is not known
+static bool readConstant(const Folder* folder, const NodeId node, Constant* value)
+{
+    const Ast* ast = folder->ast;
+    if (node == NODE_NONE) return false;
+    const uint32_t token = nodeToken(ast, node);
+    switch (nodeKind(ast, node))
+    {
+    case NODE_CONSTANT:
+    {
+        const uint64_t bits = constantBits(ast, node);
+        value->type = constantType(ast, node);
+        value->untyped = (nodeFlags(ast, node) & NODE_FLAG_UNTYPED) != 0;
+        memcpy(&value->as, &bits, sizeof(bits));
+        return true;
+    }
+    case NODE_INT_LITERAL:
+    {
+        const LiteralValue literal = tokenLiteral(ast->tokens, (int)token);
+        //Literals above INT64_MAX only make sense as u64, the backend checks them
+        if (literal.overflow || literal.as.integer > INT64_MAX) return false;
+        value->type = TYPE_I64;
+        value->untyped = true;
+        value->as.i = (int64_t)literal.as.integer;
+        return true;
+    }
+    case NODE_FLOAT_LITERAL:
+    {
+        const LiteralValue literal = tokenLiteral(ast->tokens, (int)token);
+        if (literal.overflow) return false;
+        value->type = TYPE_F64;
+        value->untyped = true;
+        value->as.f = literal.as.real;
+        return true;
+    }
+    case NODE_BOOL_LITERAL:
+        value->type = TYPE_BOOL;
+        value->untyped = false;
+        value->as.i = ast->tokens->kinds[token] == TOKEN_TRUE;
+        return true;
+    default:
+        return false;
+    }
+}
+
+//Helper to rewrite a node into a constant
+static void writeConstant(Folder* folder, const NodeId node, const Constant* value)
+{
+    Ast* ast = folder->ast;
+    uint64_t bits;
+    memcpy(&bits, &value->as, sizeof(bits));
+    ast->kinds[node] = (uint8_t)NODE_CONSTANT;
+    ast->flags[node] = (uint8_t)(value->type | (value->untyped ? NODE_FLAG_UNTYPED : 0));
+    ast->data[node].lhs = (uint32_t)bits;
+    ast->data[node].rhs = (uint32_t)(bits >> 32);
+    folder->folded++;
+}
+
+//Helper to make a bool constant
+static Constant boolConstant(const bool value)
+{
+    Constant constant;
+    constant.type = TYPE_BOOL;
+    constant.untyped = false;
+    constant.as.i = value;
+    return constant;
+}
+
+//Helpers to check that an integer fits a type of 'bits' bits
+static bool fitsSigned(const int64_t value, const int bits)
+{
+    return bits == 64 || (value >= -(INT64_C(1) << (bits - 1)) && value < (INT64_C(1) << (bits - 1)));
+}
+static bool fitsUnsigned(const uint64_t value, const int bits)
+{
+    return bits == 64 || value <= (UINT64_C(1) << bits) - 1;
+}
+
+//Helper to check whether a constant is held as uint64_t
+static bool isUnsignedConstant(const Constant* value)
+{
+    return !value->untyped && isUnsignedType(value->type);
+}
+
+//Function to convert a constant to 'type' without losing its value, false when it cannot be.
+//'source' and 'result' may be the same constant
+static bool convertConstant(const Constant* source, const TypeKind type, Constant* result)
+{
+    const Constant copy = *source;
+    const Constant* value = &copy;
+    result->type = type;
+    result->untyped = false;
+    if (type == TYPE_BOOL)
+    {
+        result->as.i = value->as.i;
+        return value->type == TYPE_BOOL;
+    }
+    if (value->type == TYPE_BOOL) return false;
+    const bool fromFloat = isFloatType(value->type);
+    if (isIntegerType(type))
+    {
+        //A float never silently becomes an integer
+        if (fromFloat) return false;
+        const int bits = typeBits(type);
+        if (isUnsignedType(type))
+        {
+            if (!isUnsignedConstant(value) && value->as.i < 0) return false;
+            result->as.u = value->as.u;
+            return fitsUnsigned(result->as.u, bits);
+        }
+        if (isUnsignedConstant(value) && value->as.u > INT64_MAX) return false;
+        result->as.i = value->as.i;
+        return fitsSigned(result->as.i, bits);
+    }
+    if (isFloatType(type))
+    {
+        double real = value->as.f;
+        if (!fromFloat) real = isUnsignedConstant(value) ? (double)value->as.u : (double)value->as.i;
+        if (type == TYPE_F32)
+        {
+            if (isfinite(real) && fabs(real) > FLT_MAX) return false;
+            real = (double)(float)real;
+        }
+        result->as.f = real;
+        return true;
+    }
+    return false;
+}
+
+//Function to bring two operands to one type, false when they do not share one
+static bool unifyConstants(Constant* a, Constant* b)
+{
+    if (a->untyped && b->untyped)
+    {
+        //Mixing an integer and a float literal makes both floats
+        if (a->type != b->type)
+        {
+            Constant* integer = a->type == TYPE_I64 ? a : b;
+            integer->type = TYPE_F64;
+            integer->as.f = (double)integer->as.i;
+        }
+        return true;
+    }
+    if (a->untyped) return convertConstant(a, b->type, a);
+    if (b->untyped) return convertConstant(b, a->type, b);
+    return a->type == b->type;
+}
+
+//-------------------------------------------------
+//Operators
+//-------------------------------------------------
+
+//Helpers to do int64_t arithmetic, false when the result would overflow
+static bool addSigned(const int64_t a, const int64_t b, int64_t* result)
+{
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return false;
+    *result = a + b;
+    return true;
+}
+static bool subtractSigned(const int64_t a, const int64_t b, int64_t* result)
+{
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b)) return false;
+    *result = a - b;
+    return true;
+}
+static bool multiplySigned(const int64_t a, const int64_t b, int64_t* result)
+{
+    if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+              : (b > 0 ? a < INT64_MIN / b : (a != 0 && b < INT64_MAX / a)))
+    {
+        return false;
+    }
+    *result = a * b;
+    return true;
+}
+
+//Function to fold an integer operator, 'bits' is the width of the operand type (64 when untyped)
+static bool foldSignedBinary(const TokenType op, const int64_t a, const int64_t b, const int bits, int64_t* result)
+{
+    switch (op)
+    {
+    case TOKEN_PLUS: return addSigned(a, b, result) && fitsSigned(*result, bits);
+    case TOKEN_MINUS: return subtractSigned(a, b, result) && fitsSigned(*result, bits);
+    case TOKEN_STAR: return multiplySigned(a, b, result) && fitsSigned(*result, bits);
+    case TOKEN_SLASH:
+    case TOKEN_PERCENT:
+        if (b == 0 || (a == INT64_MIN && b == -1)) return false;
+        *result = op == TOKEN_SLASH ? a / b : a % b;
+        return fitsSigned(*result, bits);
+    case TOKEN_BIT_AND: *result = a & b; return true;
+    case TOKEN_BIT_OR: *result = a | b; return true;
+    case TOKEN_BIT_XOR: *result = a ^ b; return true;
+    case TOKEN_LEFT_SHIFT:
+    case TOKEN_RIGHT_SHIFT:
+        //Negative values and out of range counts are left to the backend
+        if (a < 0 || b < 0 || b >= bits) return false;
+        if (op == TOKEN_LEFT_SHIFT && a > (INT64_MAX >> b)) return false;
+        *result = op == TOKEN_LEFT_SHIFT ? a << b : a >> b;
+        return fitsSigned(*result, bits);
+    default:
+        return false;
+    }
+}
+static bool foldUnsignedBinary(const TokenType op, const uint64_t a, const uint64_t b, const int bits, uint64_t* result)
+{
+    switch (op)
+    {
+    case TOKEN_PLUS:
+        *result = a + b;
+        return *result >= a && fitsUnsigned(*result, bits);
+    case TOKEN_MINUS:
+        *result = a - b;
+        return a >= b;
+    case TOKEN_STAR:
+        *result = a * b;
+        return (a == 0 || *result / a == b) && fitsUnsigned(*result, bits);
+    case TOKEN_SLASH:
+    case TOKEN_PERCENT:
+        if (b == 0) return false;
+        *result = op == TOKEN_SLASH ? a / b : a % b;
+        return true;
+    case TOKEN_BIT_AND: *result = a & b; return true;
+    case TOKEN_BIT_OR: *result = a | b; return true;
+    case TOKEN_BIT_XOR: *result = a ^ b; return true;
+    case TOKEN_LEFT_SHIFT:
+    case TOKEN_RIGHT_SHIFT:
+        if (b >= (uint64_t)bits) return false;
+        if (op == TOKEN_LEFT_SHIFT && a > (UINT64_MAX >> b)) return false;
+        *result = op == TOKEN_LEFT_SHIFT ? a << b : a >> b;
+        return fitsUnsigned(*result, bits);
+    default:
+        return false;
+    }
+}
+
+//Helper to fold a comparison on any ordered values
+#define COMPARE(op, a, b) \
+    ((op) == TOKEN_EQUAL_EQUAL ? (a) == (b) : (op) == TOKEN_BANG_EQUAL ? (a) != (b) : \
+     (op) == TOKEN_LESS ? (a) < (b) : (op) == TOKEN_LESS_EQUAL ? (a) <= (b) : \
+     (op) == TOKEN_GREATER ? (a) > (b) : (a) >= (b))
+
+//Helper to check for the six comparison operators
+static bool isComparison(const TokenType op)
+{
+    return op >= TOKEN_EQUAL_EQUAL && op <= TOKEN_GREATER_EQUAL;
+}
+
+//Function to fold 'a op b', false when it has to happen at runtime
+static bool foldBinary(const TokenType op, Constant a, Constant b, Constant* result)
+{
+    if (!unifyConstants(&a, &b)) return false;
+    const TypeKind type = a.type;
+    if (type == TYPE_BOOL)
+    {
+        switch (op)
+        {
+        case TOKEN_EQUAL_EQUAL: *result = boolConstant(a.as.i == b.as.i); return true;
+        case TOKEN_BANG_EQUAL: *result = boolConstant(a.as.i != b.as.i); return true;
+        case TOKEN_AND: *result = boolConstant(a.as.i && b.as.i); return true;
+        case TOKEN_OR: *result = boolConstant(a.as.i || b.as.i); return true;
+        default: return false;
+        }
+    }
+    if (isComparison(op))
+    {
+        if (isFloatType(type)) *result = boolConstant(COMPARE(op, a.as.f, b.as.f));
+        else if (isUnsignedConstant(&a)) *result = boolConstant(COMPARE(op, a.as.u, b.as.u));
+        else *result = boolConstant(COMPARE(op, a.as.i, b.as.i));
+        return true;
+    }
+
+    *result = a;
+    result->untyped = a.untyped && b.untyped;
+    if (isFloatType(type))
+    {
+        if (type == TYPE_F32)
+        {
+            //Same single precision arithmetic the backends do
+            const float x = (float)a.as.f;
+            const float y = (float)b.as.f;
+            switch (op)
+            {
+            case TOKEN_PLUS: result->as.f = (double)(x + y); return true;
+            case TOKEN_MINUS: result->as.f = (double)(x - y); return true;
+            case TOKEN_STAR: result->as.f = (double)(x * y); return true;
+            case TOKEN_SLASH: result->as.f = (double)(x / y); return true;
+            default: return false;
+            }
+        }
+        switch (op)
+        {
+        case TOKEN_PLUS: result->as.f = a.as.f + b.as.f; return true;
+        case TOKEN_MINUS: result->as.f = a.as.f - b.as.f; return true;
+        case TOKEN_STAR: result->as.f = a.as.f * b.as.f; return true;
+        case TOKEN_SLASH: result->as.f = a.as.f / b.as.f; return true;
+        default: return false;
+        }
+    }
+    const int bits = result->untyped ? 64 : typeBits(type);
+    if (isUnsignedConstant(&a)) return foldUnsignedBinary(op, a.as.u, b.as.u, bits, &result->as.u);
+    return foldSignedBinary(op, a.as.i, b.as.i, bits, &result->as.i);
+}
+
+//Function to fold 'op a', false when it has to happen at runtime
+static bool foldUnary(const TokenType op, const Constant a, Constant* result)
+{
+    *result = a;
+    switch (op)
+    {
+    case TOKEN_BANG:
+        if (a.type != TYPE_BOOL) return false;
+        result->as.i = !a.as.i;
+        return true;
+    case TOKEN_MINUS:
+        if (isFloatType(a.type))
+        {
+            result->as.f = -a.as.f;
+            return true;
+        }
+        if (a.type == TYPE_BOOL || isUnsignedConstant(&a) || a.as.i == INT64_MIN) return false;
+        result->as.i = -a.as.i;
+        return a.untyped || fitsSigned(result->as.i, typeBits(a.type));
+    case TOKEN_BIT_NOT:
+        if (a.type == TYPE_BOOL || isFloatType(a.type)) return false;
+        if (isUnsignedConstant(&a))
+        {
+            const int bits = typeBits(a.type);
+            result->as.u = bits == 64 ? ~a.as.u : ~a.as.u & ((UINT64_C(1) << bits) - 1);
+        }
+        else
+        {
+            result->as.i = ~a.as.i;
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+//-------------------------------------------------
+//Rewriting the tree
+//-------------------------------------------------
+
+//Helper to make 'node' an exact copy of 'source'
+static void copyNode(Folder* folder, const NodeId node, const NodeId source)
+{
+    Ast* ast = folder->ast;
+    ast->kinds[node] = ast->kinds[source];
+    ast->flags[node] = ast->flags[source];
+    ast->mainTokens[node] = ast->mainTokens[source];
+    ast->data[node] = ast->data[source];
+    folder->folded++;
+}
+
+//Function to replace a statement by the only arm that can run ('statement' may be NODE_NONE)
+static void replaceWithStatement(Folder* folder, const NodeId node, const NodeId statement)
+{
+    Ast* ast = folder->ast;
+    if (statement != NODE_NONE && nodeKind(ast, statement) == NODE_BLOCK)
+    {
+        copyNode(folder, node, statement);
+        return;
+    }
+    //Anything else is wrapped in a block, so declarations keep their own node
+    uint32_t start, end;
+    addNodeList(ast, &statement, statement != NODE_NONE ? 1 : 0, &start, &end);
+    ast->kinds[node] = (uint8_t)NODE_BLOCK;
+    ast->flags[node] = 0;
+    ast->data[node].lhs = start;
+    ast->data[node].rhs = end;
+    folder->folded++;
+}
+
+//Function to replace a read of an immutable binding by its constant initializer
+static void propagateBinding(Folder* folder, const NodeId node)
+{
+    const Ast* ast = folder->ast;
+    if (folder->declarations == NULL) return;
+    const NodeId declaration = folder->declarations[node];
+    if (declaration == NODE_NONE || nodeKind(ast, declaration) != NODE_VAR_DECL) return;
+    if (nodeFlags(ast, declaration) & (NODE_FLAG_MUT | NODE_FLAG_ARRAY | NODE_FLAG_DYNAMIC_ARRAY | NODE_FLAG_UNSIZED_ARRAY))
+    {
+        return;
+    }
+    //Only within the frame that declared it: a function may run before a global it reads was initialized
+    if (folder->owners[declaration] != folder->function) return;
+
+    Constant initializer, value;
+    if (!readConstant(folder, nodeData(ast, declaration).rhs, &initializer)) return;
+    const uint32_t name = nodeToken(ast, declaration);
+    const TypeKind type = typeFromToken((TokenType)ast->tokens->kinds[name - 1]);
+    if (!initializer.untyped && initializer.type != type) return;
+    if (!convertConstant(&initializer, type, &value)) return;
+    writeConstant(folder, node, &value);
+}
+
+//Helper to fold the nodes of an extra range
+static void foldRange(Folder* folder, const uint32_t start, const uint32_t end)
+{
+    for (uint32_t i = start; i < end; i++)
+    {
+        foldNode(folder, extraWord(folder->ast, i));
+    }
+}
+
+//Function to fold one node after everything below it
+static void foldNode(Folder* folder, const NodeId node)
+{
+    if (node == NODE_NONE) return;
+    Ast* ast = folder->ast;
+    const NodeData data = nodeData(ast, node);
+    const TokenType op = (TokenType)ast->tokens->kinds[nodeToken(ast, node)];
+    Constant a, b, result;
+    switch (nodeKind(ast, node))
+    {
+    case NODE_IDENTIFIER:
+        propagateBinding(folder, node);
+        break;
+    case NODE_UNARY:
+        foldNode(folder, data.lhs);
+        if (readConstant(folder, data.lhs, &a) && foldUnary(op, a, &result)) writeConstant(folder, node, &result);
+        break;
+    case NODE_BINARY:
+        foldNode(folder, data.lhs);
+        foldNode(folder, data.rhs);
+        if (!readConstant(folder, data.lhs, &a)) break;
+        if (readConstant(folder, data.rhs, &b))
+        {
+            if (foldBinary(op, a, b, &result)) writeConstant(folder, node, &result);
+        }
+        else if (a.type == TYPE_BOOL && ((op == TOKEN_AND && !a.as.i) || (op == TOKEN_OR && a.as.i)))
+        {
+            //The right side is never evaluated
+            writeConstant(folder, node, &a);
+        }
+        break;
+    case NODE_CAST:
+    {
+        foldNode(folder, data.lhs);
+        const TypeKind type = typeFromToken(op);
+        if (readConstant(folder, data.lhs, &a) && convertConstant(&a, type, &result)) writeConstant(folder, node, &result);
+        break;
+    }
+    case NODE_ASSIGN:
+        //The target is a place, not a value
+        if (nodeKind(ast, data.lhs) != NODE_IDENTIFIER) foldNode(folder, data.lhs);
+        foldNode(folder, data.rhs);
+        break;
+    case NODE_TERNARY:
+    {
+        foldNode(folder, data.lhs);
+        const NodeId arms[2] = {extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1)};
+        foldNode(folder, arms[0]);
+        foldNode(folder, arms[1]);
+        if (readConstant(folder, data.lhs, &a) && a.type == TYPE_BOOL)
+        {
+            //Identifiers carry their resolution, so they cannot be moved
+            const NodeId arm = arms[a.as.i ? 0 : 1];
+            if (nodeKind(ast, arm) != NODE_IDENTIFIER) copyNode(folder, node, arm);
+        }
+        break;
+    }
+    case NODE_IF:
+    {
+        foldNode(folder, data.lhs);
+        const NodeId arms[2] = {extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1)};
+        foldNode(folder, arms[0]);
+        foldNode(folder, arms[1]);
+        if (readConstant(folder, data.lhs, &a) && a.type == TYPE_BOOL)
+        {
+            replaceWithStatement(folder, node, arms[a.as.i ? 0 : 1]);
+        }
+        break;
+    }
+    case NODE_WHILE:
+        foldNode(folder, data.lhs);
+        foldNode(folder, data.rhs);
+        if (readConstant(folder, data.lhs, &a) && a.type == TYPE_BOOL && !a.as.i)
+        {
+            replaceWithStatement(folder, node, NODE_NONE);
+        }
+        break;
+    case NODE_EXPR_STMT:
+    case NODE_RETURN:
+    case NODE_LOOP:
+        foldNode(folder, data.lhs);
+        break;
+    case NODE_INDEX:
+    case NODE_DO_WHILE:
+    case NODE_MATCH_ARM:
+    case NODE_FOR_IN:
+        foldNode(folder, data.lhs);
+        foldNode(folder, data.rhs);
+        break;
+    case NODE_CALL:
+    case NODE_MATCH:
+        foldNode(folder, data.lhs);
+        foldRange(folder, extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_ARRAY_LITERAL:
+    case NODE_BLOCK:
+    case NODE_PROGRAM:
+        foldRange(folder, data.lhs, data.rhs);
+        break;
+    case NODE_FOR:
+        foldNode(folder, extraWord(ast, data.lhs));
+        foldNode(folder, extraWord(ast, data.lhs + 1));
+        foldNode(folder, extraWord(ast, data.lhs + 2));
+        foldNode(folder, data.rhs);
+        break;
+    case NODE_VAR_DECL:
+        foldNode(folder, data.lhs);
+        foldNode(folder, data.rhs);
+        //Reads after this point may use the initializer
+        folder->owners[node] = folder->function;
+        break;
+    case NODE_FN_DECL:
+    {
+        const NodeId enclosing = folder->function;
+        folder->function = node;
+        foldNode(folder, data.rhs);
+        folder->function = enclosing;
+        break;
+    }
+    default:
+        //Literals, constants, parameters, break, continue
+        break;
+    }
+}
+
+//Function to fold a tree in place, returns the number of nodes rewritten
+int foldAst(Ast* ast, const NodeId* declarations)
+{
+    if (ast->root == NODE_NONE) return 0;
+    Folder folder;
+    folder.ast = ast;
+    folder.declarations = declarations;
+    folder.owners = calloc((size_t)ast->count, sizeof(NodeId));
+    if (folder.owners == NULL)
+    {
+        fprintf(stderr, "Not enough memory to fold %d nodes\n", ast->count);
+        exit(74);
+    }
+    folder.function = ast->root;
+    folder.folded = 0;
+    foldNode(&folder, ast->root);
+    free(folder.owners);
+    return folder.folded;
+}
@@ -0,0 +1,31 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef FOLD_H
+#define FOLD_H
+
+#include "ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Constant folding runs once on the shared tree, after name resolution and
+//before either backend sees it. Expressions whose operands are all known are
+//rewritten in place into NODE_CONSTANT, reads of immutable bindings with a
+//constant initializer become that constant, and if/while/ternary arms that
+//can never run are dropped. A fold that would overflow its type, divide by
+//zero or mix types is left alone for the backend to handle or report.
+//Node ids never change, and identifiers and declarations are never moved,
+//so a resolution computed before folding stays valid afterwards.
+
+//Function to fold a tree in place. 'declarations' is indexed by NodeId and holds the
+//declaration every identifier refers to (as set by the resolver), NULL skips propagating
+//immutable bindings. Returns the number of nodes rewritten
+int foldAst(Ast* ast, const NodeId* declarations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //FOLD_H
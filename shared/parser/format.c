@@ -0,0 +1,138 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "format.h"
+#include <string.h>
+
+//Struct to hold the name of a type a hole may print
+typedef struct
+{
+    const char* name;
+    int length;
+    TypeKind type;
+} HoleType;
+
+static const HoleType holeTypes[] =
+{
+    {"i8", 2, TYPE_I8}, {"i16", 3, TYPE_I16}, {"i32", 3, TYPE_I32}, {"i64", 3, TYPE_I64},
+    {"u8", 2, TYPE_U8}, {"u16", 3, TYPE_U16}, {"u32", 3, TYPE_U32}, {"u64", 3, TYPE_U64},
+    {"f32", 3, TYPE_F32}, {"f64", 3, TYPE_F64},
+    {"char", 4, TYPE_CHAR}, {"string", 6, TYPE_STRING}, {"bool", 4, TYPE_BOOL},
+};
+
+//Helper to decode the character after a backslash, the lexer has already rejected unknown escapes
+static char decodeEscape(const char c)
+{
+    switch (c)
+    {
+    case 'n': return '\n';
+    case 't': return '\t';
+    case 'r': return '\r';
+    case '0': return '\0';
+    default: return c; //Quotes, backslash and braces stand for themselves
+    }
+}
+
+//Helper to parse the inside of a hole ('i32' or 'f32:.2'), returns NULL or an error message
+static const char* parseHole(const char* start, const int length, FormatSegment* segment)
+{
+    const char* colon = memchr(start, ':', (size_t)length);
+    const int nameLength = colon != NULL ? (int)(colon - start) : length;
+    segment->isHole = true;
+    segment->type = TYPE_ERROR;
+    segment->precision = -1;
+    segment->text = NULL;
+    segment->length = 0;
+    for (size_t i = 0; i < sizeof(holeTypes) / sizeof(holeTypes[0]); i++)
+    {
+        if (holeTypes[i].length == nameLength && memcmp(holeTypes[i].name, start, (size_t)nameLength) == 0)
+        {
+            segment->type = holeTypes[i].type;
+            break;
+        }
+    }
+    if (segment->type == TYPE_ERROR) return "Unknown type in format hole.";
+    if (colon == NULL) return NULL;
+
+    //Only float holes take an option, and the only option is '.N'
+    if (!isFloatType(segment->type)) return "Only float holes take a precision.";
+    const char* option = colon + 1;
+    const int optionLength = length - nameLength - 1;
+    if (optionLength < 2 || option[0] != '.') return "Expected '.N' after ':' in format hole.";
+    int precision = 0;
+    for (int i = 1; i < optionLength; i++)
+    {
+        if (option[i] < '0' || option[i] > '9') return "Expected '.N' after ':' in format hole.";
+        precision = precision * 10 + (option[i] - '0');
+        if (precision > FORMAT_MAX_PRECISION) return "Format precision is too large.";
+    }
+    segment->precision = precision;
+    return NULL;
+}
+
+//Function to compile the contents of a string literal (quotes removed) into 'format'
+const char* compileFormat(Arena* arena, const char* text, const int length, FormatString* format)
+{
+    //Every '{' can end one literal segment and open one hole, so this bounds the segment count
+    int braces = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] == '{') braces++;
+    }
+    FormatSegment* segments = ARENA_ARRAY(arena, FormatSegment, 2 * braces + 1);
+    //Decoded text is never longer than the source text
+    char* decoded = arenaAlloc(arena, (size_t)length + 1);
+    int segmentCount = 0;
+    int holeCount = 0;
+    int decodedLength = 0;
+    int literalStart = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        const char c = text[i];
+        if (c == '\\' && i + 1 < length)
+        {
+            decoded[decodedLength++] = decodeEscape(text[++i]);
+        }
+        else if (c == '{')
+        {
+            const char* close = memchr(text + i + 1, '}', (size_t)(length - i - 1));
+            if (close == NULL) return "Unterminated '{' in format string, use '\\{' for a literal brace.";
+            if (decodedLength > literalStart)
+            {
+                FormatSegment* literal = &segments[segmentCount++];
+                literal->isHole = false;
+                literal->type = TYPE_STRING;
+                literal->precision = -1;
+                literal->text = decoded + literalStart;
+                literal->length = decodedLength - literalStart;
+            }
+            const char* error = parseHole(text + i + 1, (int)(close - (text + i + 1)), &segments[segmentCount++]);
+            if (error != NULL) return error;
+            holeCount++;
+            literalStart = decodedLength;
+            i = (int)(close - text);
+        }
+        else if (c == '}')
+        {
+            return "Unmatched '}' in format string, use '\\}' for a literal brace.";
+        }
+        else
+        {
+            decoded[decodedLength++] = c;
+        }
+    }
+    if (decodedLength > literalStart)
+    {
+        FormatSegment* literal = &segments[segmentCount++];
+        literal->isHole = false;
+        literal->type = TYPE_STRING;
+        literal->precision = -1;
+        literal->text = decoded + literalStart;
+        literal->length = decodedLength - literalStart;
+    }
+    format->segments = segments;
+    format->segmentCount = segmentCount;
+    format->holeCount = holeCount;
+    return NULL;
+}
@@ -0,0 +1,48 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include "common.h"
+#include "types.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//The first argument of print() is compiled once, at parse time, into a list
+//of segments: literal text (escapes already decoded) and typed holes such as
+//'{i32}' or '{f32:.2}'. Backends never look at the format text again.
+
+//Most digits a '{f32:.N}' hole may ask for
+#define FORMAT_MAX_PRECISION 17
+
+//Struct to hold one piece of a format string
+typedef struct
+{
+    bool isHole;       //A '{type}' hole rather than literal text
+    TypeKind type;     //Type of the argument a hole prints
+    int precision;     //Digits after the point of a float hole, -1 when not given
+    const char* text;  //Decoded literal text (not '\0' terminated)
+    int length;
+} FormatSegment;
+
+//Struct to hold a compiled format string
+typedef struct
+{
+    FormatSegment* segments;
+    int segmentCount;
+    int holeCount;     //print() needs exactly this many arguments after the format
+} FormatString;
+
+//Function to compile the contents of a string literal (quotes removed) into 'format',
+//everything is allocated from 'arena'. Returns NULL or an error message
+const char* compileFormat(Arena* arena, const char* text, int length, FormatString* format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //FORMAT_H
@@ -0,0 +1,316 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "loops.h"
+#include "lexer.h"
+
+//Struct to hold what a walk over part of a loop found
+typedef struct
+{
+    const Ast* ast;
+    const NodeId* declarations;
+    NodeId binding;      //Declaration whose assignments are looked for
+    bool writes;         //'binding' is assigned somewhere
+    bool calls;          //A function is called somewhere, it may assign any global
+} LoopScan;
+
+//Helper to get the kind of a node's main token
+static TokenType nodeOperator(const Ast* ast, const NodeId node)
+{
+    return (TokenType)ast->tokens->kinds[nodeToken(ast, node)];
+}
+
+//Helper to check whether 'node' is a read of 'declaration'
+static bool refersTo(const Ast* ast, const NodeId* declarations, const NodeId node, const NodeId declaration)
+{
+    return node != NODE_NONE && nodeKind(ast, node) == NODE_IDENTIFIER && declarations[node] == declaration;
+}
+
+//Helper to get the type a declaration was written with, the keyword in front of its name
+static TypeKind declaredType(const Ast* ast, const NodeId declaration)
+{
+    return typeFromToken((TokenType)ast->tokens->kinds[nodeToken(ast, declaration) - 1]);
+}
+
+//Helper to read an integer literal or folded integer constant, false when it is not one or exceeds INT64_MAX
+static bool readInteger(const Ast* ast, const NodeId node, int64_t* value)
+{
+    if (node == NODE_NONE) return false;
+    if (nodeKind(ast, node) == NODE_CONSTANT)
+    {
+        const TypeKind type = constantType(ast, node);
+        const uint64_t bits = constantBits(ast, node);
+        if (!isIntegerType(type) || (isUnsignedType(type) && bits > INT64_MAX)) return false;
+        *value = (int64_t)bits;
+        return true;
+    }
+    if (nodeKind(ast, node) == NODE_INT_LITERAL)
+    {
+        const LiteralValue literal = tokenLiteral(ast->tokens, (int)nodeToken(ast, node));
+        if (literal.overflow || literal.as.integer > INT64_MAX) return false;
+        *value = (int64_t)literal.as.integer;
+        return true;
+    }
+    return false;
+}
+
+//Helpers to get the range of an integer type other than u64
+static int64_t typeMaximum(const TypeKind type)
+{
+    const int bits = typeBits(type);
+    if (isUnsignedType(type)) return (INT64_C(1) << bits) - 1;
+    return bits == 64 ? INT64_MAX : (INT64_C(1) << (bits - 1)) - 1;
+}
+static int64_t typeMinimum(const TypeKind type)
+{
+    const int bits = typeBits(type);
+    if (isUnsignedType(type)) return 0;
+    return bits == 64 ? INT64_MIN : -(INT64_C(1) << (bits - 1));
+}
+
+static void scanNode(LoopScan* scan, NodeId node);
+
+//Helper to scan the nodes of an extra range
+static void scanRange(LoopScan* scan, const uint32_t start, const uint32_t end)
+{
+    for (uint32_t i = start; i < end; i++)
+    {
+        scanNode(scan, extraWord(scan->ast, i));
+    }
+}
+
+//Function to look for assignments and calls in a node and everything below it
+static void scanNode(LoopScan* scan, const NodeId node)
+{
+    if (node == NODE_NONE || (scan->writes && scan->calls)) return;
+    const Ast* ast = scan->ast;
+    const NodeData data = nodeData(ast, node);
+    switch (nodeKind(ast, node))
+    {
+    case NODE_ASSIGN:
+        if (refersTo(ast, scan->declarations, data.lhs, scan->binding)) scan->writes = true;
+        scanNode(scan, data.lhs);
+        scanNode(scan, data.rhs);
+        break;
+    case NODE_CALL:
+        scan->calls = true;
+        scanNode(scan, data.lhs);
+        scanRange(scan, extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_UNARY:
+    case NODE_CAST:
+    case NODE_EXPR_STMT:
+    case NODE_RETURN:
+    case NODE_LOOP:
+        scanNode(scan, data.lhs);
+        break;
+    case NODE_BINARY:
+    case NODE_INDEX:
+    case NODE_WHILE:
+    case NODE_DO_WHILE:
+    case NODE_MATCH_ARM:
+    case NODE_FOR_IN:
+    case NODE_VAR_DECL:
+        scanNode(scan, data.lhs);
+        scanNode(scan, data.rhs);
+        break;
+    case NODE_TERNARY:
+    case NODE_IF:
+        scanNode(scan, data.lhs);
+        scanNode(scan, extraWord(ast, data.rhs));
+        scanNode(scan, extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_MATCH:
+        scanNode(scan, data.lhs);
+        scanRange(scan, extraWord(ast, data.rhs), extraWord(ast, data.rhs + 1));
+        break;
+    case NODE_ARRAY_LITERAL:
+    case NODE_BLOCK:
+    case NODE_PROGRAM:
+        scanRange(scan, data.lhs, data.rhs);
+        break;
+    case NODE_FOR:
+        scanNode(scan, extraWord(ast, data.lhs));
+        scanNode(scan, extraWord(ast, data.lhs + 1));
+        scanNode(scan, extraWord(ast, data.lhs + 2));
+        scanNode(scan, data.rhs);
+        break;
+    case NODE_FN_DECL:
+        scanNode(scan, data.rhs);
+        break;
+    default:
+        //Literals, constants, identifiers, parameters, break, continue
+        break;
+    }
+}
+
+//Helper to scan what runs on every iteration of a 'for': its condition, step and body
+static LoopScan scanIteration(const Ast* ast, const NodeId* declarations, const NodeId loop, const NodeId binding)
+{
+    const NodeData data = nodeData(ast, loop);
+    LoopScan scan = {ast, declarations, binding, false, false};
+    scanNode(&scan, extraWord(ast, data.lhs + 1));
+    scanNode(&scan, extraWord(ast, data.lhs + 2));
+    scanNode(&scan, data.rhs);
+    return scan;
+}
+
+//Function to check that the limit of a 'for' has the same value on every iteration
+static bool isInvariant(const Ast* ast, const NodeId* declarations, const NodeId loop, const NodeId variable, const NodeId node)
+{
+    int64_t value;
+    if (readInteger(ast, node, &value)) return true;
+    const NodeData data = nodeData(ast, node);
+    switch (nodeKind(ast, node))
+    {
+    case NODE_IDENTIFIER:
+    {
+        const NodeId declaration = declarations[node];
+        if (declaration == NODE_NONE || declaration == variable) return false;
+        const NodeKind kind = nodeKind(ast, declaration);
+        if (kind != NODE_VAR_DECL && kind != NODE_PARAM && kind != NODE_FOR_IN) return false;
+        if (!(nodeFlags(ast, declaration) & NODE_FLAG_MUT)) return true;
+        //A mutable binding only holds still if nothing in the loop can assign it
+        const LoopScan scan = scanIteration(ast, declarations, loop, declaration);
+        return !scan.writes && !scan.calls;
+    }
+    case NODE_UNARY:
+    case NODE_CAST:
+        return isInvariant(ast, declarations, loop, variable, data.lhs);
+    case NODE_BINARY:
+        return isInvariant(ast, declarations, loop, variable, data.lhs) &&
+               isInvariant(ast, declarations, loop, variable, data.rhs);
+    default:
+        return false;
+    }
+}
+
+//Helper to read the step of a counted loop, 'i += k', 'i = i + k' or 'i = k + i' with a constant k above 0
+static bool readStep(const Ast* ast, const NodeId* declarations, NodeId step, const NodeId variable, int64_t* amount)
+{
+    if (step != NODE_NONE && nodeKind(ast, step) == NODE_EXPR_STMT) step = nodeData(ast, step).lhs;
+    if (step == NODE_NONE || nodeKind(ast, step) != NODE_ASSIGN) return false;
+    const NodeData data = nodeData(ast, step);
+    if (!refersTo(ast, declarations, data.lhs, variable)) return false;
+    NodeId increment;
+    if (nodeOperator(ast, step) == TOKEN_PLUS_EQUAL)
+    {
+        increment = data.rhs;
+    }
+    else if (nodeOperator(ast, step) == TOKEN_EQUAL && nodeKind(ast, data.rhs) == NODE_BINARY &&
+             nodeOperator(ast, data.rhs) == TOKEN_PLUS)
+    {
+        const NodeData sum = nodeData(ast, data.rhs);
+        if (refersTo(ast, declarations, sum.lhs, variable)) increment = sum.rhs;
+        else if (refersTo(ast, declarations, sum.rhs, variable)) increment = sum.lhs;
+        else return false;
+    }
+    else
+    {
+        return false;
+    }
+    return readInteger(ast, increment, amount) && *amount > 0;
+}
+
+//Function to check whether the NODE_FOR 'loop' is a counted loop
+bool matchCountedLoop(const Ast* ast, const NodeId* declarations, const NodeId loop, CountedLoop* counted)
+{
+    if (declarations == NULL || nodeKind(ast, loop) != NODE_FOR) return false;
+    const NodeData data = nodeData(ast, loop);
+    const NodeId init = extraWord(ast, data.lhs);
+    const NodeId condition = extraWord(ast, data.lhs + 1);
+
+    //'T i = start', T an integer type the registers compare correctly as signed values
+    if (init == NODE_NONE || nodeKind(ast, init) != NODE_VAR_DECL) return false;
+    if (nodeFlags(ast, init) & (NODE_FLAG_ARRAY | NODE_FLAG_DYNAMIC_ARRAY | NODE_FLAG_UNSIZED_ARRAY)) return false;
+    const TypeKind type = declaredType(ast, init);
+    if (!isIntegerType(type) || type == TYPE_U64) return false;
+    const int64_t maximum = typeMaximum(type);
+
+    //'i < limit' or 'i <= limit'
+    if (condition == NODE_NONE || nodeKind(ast, condition) != NODE_BINARY) return false;
+    const TokenType comparison = nodeOperator(ast, condition);
+    if (comparison != TOKEN_LESS && comparison != TOKEN_LESS_EQUAL) return false;
+    const NodeData test = nodeData(ast, condition);
+    if (!refersTo(ast, declarations, test.lhs, init)) return false;
+    if (!isInvariant(ast, declarations, loop, init, test.rhs)) return false;
+
+    int64_t step;
+    if (!readStep(ast, declarations, extraWord(ast, data.lhs + 2), init, &step) || step > maximum) return false;
+    //Only the step may assign the variable
+    LoopScan scan = {ast, declarations, init, false, false};
+    scanNode(&scan, condition);
+    scanNode(&scan, data.rhs);
+    if (scan.writes) return false;
+
+    //The last step must stay inside the type, or the generic loop would wrap around and go on
+    int64_t limit = 0;
+    const bool knownLimit = readInteger(ast, test.rhs, &limit);
+    const bool inclusive = comparison == TOKEN_LESS_EQUAL;
+    if (inclusive ? !knownLimit || limit > maximum - step : step != 1 && (!knownLimit || limit > maximum - step + 1))
+    {
+        return false;
+    }
+
+    int64_t start = 0;
+    const bool knownStart = readInteger(ast, nodeData(ast, init).rhs, &start);
+    if (knownStart && (start < typeMinimum(type) || start > maximum)) return false;
+
+    counted->variable = init;
+    counted->type = type;
+    counted->start = nodeData(ast, init).rhs;
+    counted->limit = test.rhs;
+    counted->inclusive = inclusive;
+    counted->step = step;
+    counted->tripCount = -1;
+    if (knownStart && knownLimit)
+    {
+        //Exclusive end, which cannot overflow as the limit is at most maximum - step
+        const int64_t end = inclusive ? limit + 1 : limit;
+        if (start >= end)
+        {
+            counted->tripCount = 0;
+        }
+        else
+        {
+            const uint64_t trips = ((uint64_t)end - (uint64_t)start - 1) / (uint64_t)step + 1;
+            if (trips <= INT64_MAX) counted->tripCount = (int64_t)trips;
+        }
+    }
+    return true;
+}
+
+//Function to check whether the NODE_FOR_IN 'loop' may skip its bounds checks
+bool matchArrayLoop(const Ast* ast, const NodeId* declarations, const NodeId loop, ArrayLoop* array)
+{
+    if (declarations == NULL || nodeKind(ast, loop) != NODE_FOR_IN) return false;
+    const NodeData data = nodeData(ast, loop);
+    if (data.lhs == NODE_NONE || nodeKind(ast, data.lhs) != NODE_IDENTIFIER) return false;
+    const NodeId declaration = declarations[data.lhs];
+    if (declaration == NODE_NONE) return false;
+    if (nodeKind(ast, declaration) != NODE_VAR_DECL && nodeKind(ast, declaration) != NODE_PARAM) return false;
+    const uint8_t flags = nodeFlags(ast, declaration);
+    if (!(flags & (NODE_FLAG_ARRAY | NODE_FLAG_UNSIZED_ARRAY)) || (flags & NODE_FLAG_DYNAMIC_ARRAY)) return false;
+
+    //Writing elements is fine, binding another array to the name is not
+    LoopScan scan = {ast, declarations, declaration, false, false};
+    scanNode(&scan, data.rhs);
+    if (scan.writes || (scan.calls && (flags & NODE_FLAG_MUT))) return false;
+
+    array->array = declaration;
+    array->elementType = declaredType(ast, declaration);
+    array->length = -1;
+    const NodeData extent = nodeData(ast, declaration);
+    int64_t length;
+    if ((flags & NODE_FLAG_ARRAY) && readInteger(ast, extent.lhs, &length))
+    {
+        array->length = length;
+    }
+    else if (nodeKind(ast, declaration) == NODE_VAR_DECL && extent.rhs != NODE_NONE &&
+             nodeKind(ast, extent.rhs) == NODE_ARRAY_LITERAL)
+    {
+        const NodeData elements = nodeData(ast, extent.rhs);
+        array->length = (int64_t)(elements.rhs - elements.lhs);
+    }
+    return true;
+}
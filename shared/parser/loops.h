@@ -0,0 +1,57 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef LOOPS_H
+#define LOOPS_H
+
+#include "ast.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Loop analysis runs on the shared tree after resolution and folding, and
+//tells both backends which loops may take a fast path. A counted loop is a
+//'for' that declares an integer in its init, tests it with '<' or '<=' against
+//a limit that cannot change while the loop runs, steps it by a positive
+//constant and never assigns it in the body. The interpreter fuses its test
+//and step into OP_FOR_LOOP, and lykac emits it in the shape LLVM vectorizes
+//(see openCountedLoop). A loop only matches when the step can never overflow
+//the variable's type, so it stops exactly where the generic loop would; that
+//leaves '<=' against a limit unknown at compile time, and loops counting down,
+//on the generic path. A 'for-in' over a 'name[N]' or 'name[]' array the body
+//never reassigns reads its elements without a bounds check, since the index
+//stays below the length by construction.
+
+//Struct to hold a counted 'for' loop
+typedef struct
+{
+    NodeId variable;     //NODE_VAR_DECL of the induction variable
+    TypeKind type;       //Its integer type, never u64
+    NodeId start;        //Its initializer
+    NodeId limit;        //Right side of the condition, evaluated once
+    bool inclusive;      //'<=' rather than '<'
+    int64_t step;        //Always above 0
+    int64_t tripCount;   //Iterations when start and limit are constants, -1 otherwise
+} CountedLoop;
+
+//Struct to hold a 'for-in' over an array of known extent
+typedef struct
+{
+    NodeId array;        //Declaration of the iterated array
+    TypeKind elementType;
+    int64_t length;      //-1 when only known at runtime
+} ArrayLoop;
+
+//Function to check whether the NODE_FOR 'loop' is a counted loop, 'declarations' as for foldAst()
+bool matchCountedLoop(const Ast* ast, const NodeId* declarations, NodeId loop, CountedLoop* counted);
+//Function to check whether the NODE_FOR_IN 'loop' may skip its bounds checks
+bool matchArrayLoop(const Ast* ast, const NodeId* declarations, NodeId loop, ArrayLoop* array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LOOPS_H
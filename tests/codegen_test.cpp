@@ -0,0 +1,118 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#include "codegen.hpp"
+#include "test.h"
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+#include <cstdint>
+
+//Struct to hold a function 'f(x)' of one integer type and the blocks its 'match' arms return from
+struct SwitchFixture
+{
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    llvm::IntegerType* type = nullptr;
+    llvm::Function* function = nullptr;
+    std::vector<llvm::BasicBlock*> arms;
+    llvm::BasicBlock* defaultBlock = nullptr;
+};
+
+//Function to start 'f(x)' with 'count' arms, each returning its index, and a default returning -1
+static void initFixture(SwitchFixture& fixture, const unsigned bits, const int count)
+{
+    fixture.module = std::make_unique<llvm::Module>("switch_test", fixture.context);
+    fixture.type = llvm::IntegerType::get(fixture.context, bits);
+    auto* signature = llvm::FunctionType::get(fixture.type, {fixture.type}, false);
+    fixture.function = llvm::Function::Create(signature, llvm::Function::ExternalLinkage, "f", fixture.module.get());
+    llvm::BasicBlock::Create(fixture.context, "entry", fixture.function);
+    llvm::IRBuilder<> builder(fixture.context);
+    for (int i = 0; i < count; i++)
+    {
+        llvm::BasicBlock* arm = llvm::BasicBlock::Create(fixture.context, "arm", fixture.function);
+        builder.SetInsertPoint(arm);
+        builder.CreateRet(llvm::ConstantInt::get(fixture.type, (uint64_t)i));
+        fixture.arms.push_back(arm);
+    }
+    fixture.defaultBlock = llvm::BasicBlock::Create(fixture.context, "default", fixture.function);
+    builder.SetInsertPoint(fixture.defaultBlock);
+    builder.CreateRet(llvm::ConstantInt::getSigned(fixture.type, -1));
+}
+
+//Function to emit the switch over 'x' in the entry block
+static llvm::SwitchInst* emitSwitch(SwitchFixture& fixture, const std::vector<MatchCase>& cases)
+{
+    llvm::IRBuilder<> builder(&fixture.function->getEntryBlock());
+    return emitMatchSwitch(builder, fixture.function->getArg(0), cases, fixture.defaultBlock);
+}
+
+//Helper to check that the module is well formed, printing what the verifier says when it is not
+static bool verifies(const SwitchFixture& fixture)
+{
+    return !llvm::verifyModule(*fixture.module, &llvm::errs());
+}
+
+//Helper to get the block a switch jumps to for 'value'
+static llvm::BasicBlock* successorOf(const SwitchFixture& fixture, llvm::SwitchInst* dispatch, const int64_t value)
+{
+    return dispatch->findCaseValue(llvm::ConstantInt::getSigned(fixture.type, value))->getCaseSuccessor();
+}
+
+//Function to check a dense set of arms, each kept as its own case
+static void testDenseCases()
+{
+    SwitchFixture fixture;
+    initFixture(fixture, 64, 4);
+    std::vector<MatchCase> cases;
+    for (int i = 0; i < 4; i++) cases.push_back({i + 1, fixture.arms[i]});
+    llvm::SwitchInst* dispatch = emitSwitch(fixture, cases);
+    CHECK(verifies(fixture));
+    CHECK_INT(dispatch->getNumCases(), 4);
+    CHECK(successorOf(fixture, dispatch, 3) == fixture.arms[2]);
+    CHECK(successorOf(fixture, dispatch, 5) == fixture.defaultBlock);
+    CHECK(dispatch->getDefaultDest() == fixture.defaultBlock);
+}
+
+//Function to check sparse arms with the extreme keys of i64, and a repeated key keeping its first arm
+static void testSparseDuplicateAndExtremeCases()
+{
+    SwitchFixture fixture;
+    initFixture(fixture, 64, 4);
+    const std::vector<MatchCase> cases = {
+        {INT64_MIN, fixture.arms[0]},
+        {1000000, fixture.arms[1]},
+        {1000000, fixture.arms[2]},
+        {INT64_MAX, fixture.arms[3]},
+    };
+    llvm::SwitchInst* dispatch = emitSwitch(fixture, cases);
+    //Two equal case values would fail the verifier
+    CHECK(verifies(fixture));
+    CHECK_INT(dispatch->getNumCases(), 3);
+    CHECK(successorOf(fixture, dispatch, INT64_MIN) == fixture.arms[0]);
+    CHECK(successorOf(fixture, dispatch, 1000000) == fixture.arms[1]);
+    CHECK(successorOf(fixture, dispatch, INT64_MAX) == fixture.arms[3]);
+    CHECK(successorOf(fixture, dispatch, INT64_MIN + 1) == fixture.defaultBlock);
+    CHECK(successorOf(fixture, dispatch, INT64_MAX - 1) == fixture.defaultBlock);
+}
+
+//Function to check that keys equal once truncated to a narrow scrutinee count as duplicates
+static void testNarrowScrutinee()
+{
+    SwitchFixture fixture;
+    initFixture(fixture, 8, 3);
+    const std::vector<MatchCase> cases = {{1, fixture.arms[0]}, {257, fixture.arms[1]}, {-1, fixture.arms[2]}};
+    llvm::SwitchInst* dispatch = emitSwitch(fixture, cases);
+    CHECK(verifies(fixture));
+    CHECK_INT(dispatch->getNumCases(), 2);
+    CHECK(successorOf(fixture, dispatch, 1) == fixture.arms[0]);
+    CHECK(successorOf(fixture, dispatch, -1) == fixture.arms[2]);
+}
+
+int main()
+{
+    testDenseCases();
+    testSparseDuplicateAndExtremeCases();
+    testNarrowScrutinee();
+    return testResult("codegen_test");
+}
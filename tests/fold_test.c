@@ -0,0 +1,260 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "environment.h"
+#include "fold.h"
+#include "test.h"
+#include "tree.h"
+#include <stdint.h>
+
+//Helper to resolve a finished tree and fold it with the declarations the resolver found
+static int resolveAndFold(TestTree* tree, Resolution* resolution)
+{
+    CHECK(resolveAst(&tree->ast, resolution));
+    return foldAst(&tree->ast, resolution->declarations);
+}
+
+//Helper to read a folded constant as a signed integer
+static int64_t constantInt(const TestTree* tree, const NodeId node)
+{
+    return (int64_t)constantBits(&tree->ast, node);
+}
+
+//Helper to read a folded constant as a double
+static double constantFloat(const TestTree* tree, const NodeId node)
+{
+    const uint64_t bits = constantBits(&tree->ast, node);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//Function to check that i8 arithmetic is only folded while it fits in 8 bits
+static void testNarrowOverflow(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "i8 a = 100;\n"
+                        "i8 b = a + a;\n"
+                        "i8 c = a - 1;\n");
+    const NodeId a = declarationNode(&tree, "a", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "100", 0));
+    const NodeId left = leafNode(&tree, NODE_IDENTIFIER, "a", 1);
+    const NodeId right = leafNode(&tree, NODE_IDENTIFIER, "a", 2);
+    const NodeId overflow = pairNode(&tree, NODE_BINARY, "+", 0, left, right);
+    const NodeId b = declarationNode(&tree, "b", 0, 0, NODE_NONE, overflow);
+    const NodeId fits = pairNode(&tree, NODE_BINARY, "-", 0, leafNode(&tree, NODE_IDENTIFIER, "a", 3),
+                                 leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    const NodeId c = declarationNode(&tree, "c", 0, 0, NODE_NONE, fits);
+    const NodeId program[] = {a, b, c};
+    programNode(&tree, program, 3);
+
+    Resolution resolution;
+    resolveAndFold(&tree, &resolution);
+    //Both reads become i8 constants, but 200 does not fit so the sum is left to the backend
+    CHECK_INT(nodeKind(&tree.ast, left), NODE_CONSTANT);
+    CHECK_INT(constantType(&tree.ast, left), TYPE_I8);
+    CHECK_INT(constantInt(&tree, left), 100);
+    CHECK_INT(nodeKind(&tree.ast, overflow), NODE_BINARY);
+    CHECK_INT(nodeKind(&tree.ast, fits), NODE_CONSTANT);
+    CHECK_INT(constantType(&tree.ast, fits), TYPE_I8);
+    CHECK_INT(constantInt(&tree, fits), 99);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that divisions the backend has to report or wrap are not folded
+static void testDivisionLeftAlone(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "i64 q = (-9223372036854775807 - 1) / -1;\n"
+                        "i64 r = 7 / 0;\n"
+                        "i64 s = 7 % 0;\n"
+                        "i64 t = -7 / 2;\n");
+    const NodeId negative = pairNode(&tree, NODE_UNARY, "-", 0,
+                                     leafNode(&tree, NODE_INT_LITERAL, "9223372036854775807", 0), NODE_NONE);
+    const NodeId minimum = pairNode(&tree, NODE_BINARY, "-", 1, negative, leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    const NodeId minusOne = pairNode(&tree, NODE_UNARY, "-", 2, leafNode(&tree, NODE_INT_LITERAL, "1", 1), NODE_NONE);
+    const NodeId wraps = pairNode(&tree, NODE_BINARY, "/", 0, minimum, minusOne);
+    const NodeId byZero = pairNode(&tree, NODE_BINARY, "/", 1, leafNode(&tree, NODE_INT_LITERAL, "7", 0),
+                                   leafNode(&tree, NODE_INT_LITERAL, "0", 0));
+    const NodeId modZero = pairNode(&tree, NODE_BINARY, "%", 0, leafNode(&tree, NODE_INT_LITERAL, "7", 1),
+                                    leafNode(&tree, NODE_INT_LITERAL, "0", 1));
+    const NodeId truncates = pairNode(&tree, NODE_BINARY, "/", 2,
+                                      pairNode(&tree, NODE_UNARY, "-", 3, leafNode(&tree, NODE_INT_LITERAL, "7", 2), NODE_NONE),
+                                      leafNode(&tree, NODE_INT_LITERAL, "2", 0));
+    const NodeId program[] = {
+        declarationNode(&tree, "q", 0, 0, NODE_NONE, wraps),
+        declarationNode(&tree, "r", 0, 0, NODE_NONE, byZero),
+        declarationNode(&tree, "s", 0, 0, NODE_NONE, modZero),
+        declarationNode(&tree, "t", 0, 0, NODE_NONE, truncates),
+    };
+    programNode(&tree, program, 4);
+
+    Resolution resolution;
+    resolveAndFold(&tree, &resolution);
+    CHECK_INT(nodeKind(&tree.ast, minimum), NODE_CONSTANT);
+    CHECK(constantInt(&tree, minimum) == INT64_MIN);
+    CHECK_INT(nodeKind(&tree.ast, minusOne), NODE_CONSTANT);
+    CHECK_INT(nodeKind(&tree.ast, wraps), NODE_BINARY);
+    CHECK_INT(nodeKind(&tree.ast, byZero), NODE_BINARY);
+    CHECK_INT(nodeKind(&tree.ast, modZero), NODE_BINARY);
+    CHECK_INT(nodeKind(&tree.ast, truncates), NODE_CONSTANT);
+    CHECK_INT(constantInt(&tree, truncates), -3);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that f32 constants and f32 arithmetic are rounded to single precision
+static void testSinglePrecision(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "f32 x = 0.1;\n"
+                        "f32 y = x + 0.2;\n"
+                        "f32 z = (f32)16777217;\n");
+    const NodeId x = declarationNode(&tree, "x", 0, 0, NODE_NONE, leafNode(&tree, NODE_FLOAT_LITERAL, "0.1", 0));
+    const NodeId read = leafNode(&tree, NODE_IDENTIFIER, "x", 1);
+    const NodeId sum = pairNode(&tree, NODE_BINARY, "+", 0, read, leafNode(&tree, NODE_FLOAT_LITERAL, "0.2", 0));
+    const NodeId cast = pairNode(&tree, NODE_CAST, "f32", 3, leafNode(&tree, NODE_INT_LITERAL, "16777217", 0), NODE_NONE);
+    const NodeId program[] = {
+        x,
+        declarationNode(&tree, "y", 0, 0, NODE_NONE, sum),
+        declarationNode(&tree, "z", 0, 0, NODE_NONE, cast),
+    };
+    programNode(&tree, program, 3);
+
+    Resolution resolution;
+    resolveAndFold(&tree, &resolution);
+    CHECK_INT(nodeKind(&tree.ast, read), NODE_CONSTANT);
+    CHECK(constantFloat(&tree, read) == (double)0.1f);
+    CHECK_INT(nodeKind(&tree.ast, sum), NODE_CONSTANT);
+    CHECK_INT(constantType(&tree.ast, sum), TYPE_F32);
+    const float expected = 0.1f + 0.2f;
+    CHECK(constantFloat(&tree, sum) == (double)expected);
+    CHECK(constantFloat(&tree, sum) != 0.1 + 0.2);
+    CHECK_INT(nodeKind(&tree.ast, cast), NODE_CONSTANT);
+    CHECK(constantFloat(&tree, cast) == 16777216.0);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that '&&' and '||' fold on their left side alone when it decides them
+static void testShortCircuit(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "mut bool x = true;\n"
+                        "bool a = false && x;\n"
+                        "bool b = true || x;\n"
+                        "bool c = true && x;\n");
+    const NodeId x = declarationNode(&tree, "x", 0, NODE_FLAG_MUT, NODE_NONE, leafNode(&tree, NODE_BOOL_LITERAL, "true", 0));
+    const NodeId never = pairNode(&tree, NODE_BINARY, "&&", 0, leafNode(&tree, NODE_BOOL_LITERAL, "false", 0),
+                                  leafNode(&tree, NODE_IDENTIFIER, "x", 1));
+    const NodeId always = pairNode(&tree, NODE_BINARY, "||", 0, leafNode(&tree, NODE_BOOL_LITERAL, "true", 1),
+                                   leafNode(&tree, NODE_IDENTIFIER, "x", 2));
+    const NodeId depends = pairNode(&tree, NODE_BINARY, "&&", 1, leafNode(&tree, NODE_BOOL_LITERAL, "true", 2),
+                                    leafNode(&tree, NODE_IDENTIFIER, "x", 3));
+    const NodeId program[] = {
+        x,
+        declarationNode(&tree, "a", 0, 0, NODE_NONE, never),
+        declarationNode(&tree, "b", 0, 0, NODE_NONE, always),
+        declarationNode(&tree, "c", 0, 0, NODE_NONE, depends),
+    };
+    programNode(&tree, program, 4);
+
+    Resolution resolution;
+    resolveAndFold(&tree, &resolution);
+    CHECK_INT(nodeKind(&tree.ast, never), NODE_CONSTANT);
+    CHECK_INT(constantType(&tree.ast, never), TYPE_BOOL);
+    CHECK_INT(constantInt(&tree, never), 0);
+    CHECK_INT(nodeKind(&tree.ast, always), NODE_CONSTANT);
+    CHECK_INT(constantInt(&tree, always), 1);
+    CHECK_INT(nodeKind(&tree.ast, depends), NODE_BINARY);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that if and while arms that can never run are dropped
+static void testDeadArms(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "mut i32 n = 0;\n"
+                        "if (false) { n = 1; } else { n = 2; }\n"
+                        "if (true) n = 3;\n"
+                        "while (false) { n = 4; }\n");
+    const NodeId n = declarationNode(&tree, "n", 0, NODE_FLAG_MUT, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "0", 0));
+    NodeId sets[4];
+    for (int i = 0; i < 4; i++)
+    {
+        char value[2] = {(char)('1' + i), '\0'};
+        const NodeId assign = pairNode(&tree, NODE_ASSIGN, "=", i + 1, leafNode(&tree, NODE_IDENTIFIER, "n", i + 1),
+                                       leafNode(&tree, NODE_INT_LITERAL, value, 0));
+        sets[i] = pairNode(&tree, NODE_EXPR_STMT, "n", i + 1, assign, NODE_NONE);
+    }
+    const NodeId thenBlock = listNode(&tree, NODE_BLOCK, "{", 0, &sets[0], 1);
+    const NodeId elseBlock = listNode(&tree, NODE_BLOCK, "{", 1, &sets[1], 1);
+    const NodeId ifFalse = branchNode(&tree, NODE_IF, "if", 0, leafNode(&tree, NODE_BOOL_LITERAL, "false", 0),
+                                      thenBlock, elseBlock);
+    const NodeId ifTrue = branchNode(&tree, NODE_IF, "if", 1, leafNode(&tree, NODE_BOOL_LITERAL, "true", 0),
+                                     sets[2], NODE_NONE);
+    const NodeId whileFalse = pairNode(&tree, NODE_WHILE, "while", 0, leafNode(&tree, NODE_BOOL_LITERAL, "false", 1),
+                                       listNode(&tree, NODE_BLOCK, "{", 2, &sets[3], 1));
+    const NodeId program[] = {n, ifFalse, ifTrue, whileFalse};
+    programNode(&tree, program, 4);
+
+    Resolution resolution;
+    CHECK(resolveAndFold(&tree, &resolution) >= 3);
+    //The else block takes the place of the if, an arm that is not a block is wrapped in one
+    CHECK_INT(nodeKind(&tree.ast, ifFalse), NODE_BLOCK);
+    CHECK_INT(nodeData(&tree.ast, ifFalse).lhs, nodeData(&tree.ast, elseBlock).lhs);
+    CHECK_INT(nodeData(&tree.ast, ifFalse).rhs, nodeData(&tree.ast, elseBlock).rhs);
+    CHECK_INT(nodeKind(&tree.ast, ifTrue), NODE_BLOCK);
+    CHECK_INT(nodeData(&tree.ast, ifTrue).rhs - nodeData(&tree.ast, ifTrue).lhs, 1);
+    CHECK_INT(extraWord(&tree.ast, nodeData(&tree.ast, ifTrue).lhs), sets[2]);
+    CHECK_INT(nodeKind(&tree.ast, whileFalse), NODE_BLOCK);
+    CHECK_INT(nodeData(&tree.ast, whileFalse).rhs - nodeData(&tree.ast, whileFalse).lhs, 0);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that a global is not propagated into a function body, which may run before it is set
+static void testNoGlobalPropagation(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "i32 g = 5;\n"
+                        "fn f() -> i32 { i32 l = 2; return g + l; }\n"
+                        "i32 h = g;\n");
+    const NodeId g = declarationNode(&tree, "g", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "5", 0));
+    const NodeId local = declarationNode(&tree, "l", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "2", 0));
+    const NodeId readGlobal = leafNode(&tree, NODE_IDENTIFIER, "g", 1);
+    const NodeId readLocal = leafNode(&tree, NODE_IDENTIFIER, "l", 1);
+    const NodeId sum = pairNode(&tree, NODE_BINARY, "+", 0, readGlobal, readLocal);
+    const NodeId body[] = {local, pairNode(&tree, NODE_RETURN, "return", 0, sum, NODE_NONE)};
+    const NodeId function = functionNode(&tree, "f", 0, NULL, 0, listNode(&tree, NODE_BLOCK, "{", 0, body, 2));
+    const NodeId topLevelRead = leafNode(&tree, NODE_IDENTIFIER, "g", 2);
+    const NodeId program[] = {g, function, declarationNode(&tree, "h", 0, 0, NODE_NONE, topLevelRead)};
+    programNode(&tree, program, 3);
+
+    Resolution resolution;
+    resolveAndFold(&tree, &resolution);
+    CHECK_INT(nodeKind(&tree.ast, readGlobal), NODE_IDENTIFIER);
+    CHECK_INT(nodeKind(&tree.ast, readLocal), NODE_CONSTANT);
+    CHECK_INT(constantInt(&tree, readLocal), 2);
+    CHECK_INT(nodeKind(&tree.ast, sum), NODE_BINARY);
+    CHECK_INT(nodeKind(&tree.ast, topLevelRead), NODE_CONSTANT);
+    CHECK_INT(constantInt(&tree, topLevelRead), 5);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+int main(void)
+{
+    testNarrowOverflow();
+    testDivisionLeftAlone();
+    testSinglePrecision();
+    testShortCircuit();
+    testDeadArms();
+    testNoGlobalPropagation();
+    return testResult("fold_test");
+}
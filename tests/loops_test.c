@@ -0,0 +1,205 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "environment.h"
+#include "loops.h"
+#include "test.h"
+#include "tree.h"
+
+//Helper to get which occurrence of 'text' a literal is, when literals before it may be spelled the same
+static int literalOccurrence(const char* text, const char* const* before, const int count)
+{
+    int occurrence = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(text, before[i]) == 0) occurrence++;
+    }
+    return occurrence;
+}
+
+//Function to build 'for (mut type i = start; i cmp limit; i += step) {}' and match it
+static bool matchSimpleLoop(const char* type, const char* start, const char* comparison, const char* limit,
+                            const char* step, CountedLoop* counted)
+{
+    char source[128];
+    snprintf(source, sizeof(source), "for (mut %s i = %s; i %s %s; i += %s) {}\n", type, start, comparison, limit, step);
+    TestTree tree;
+    initTestTree(&tree, source);
+    const char* literals[] = {start, limit, step};
+    const NodeId init = declarationNode(&tree, "i", 0, NODE_FLAG_MUT, NODE_NONE,
+                                        leafNode(&tree, NODE_INT_LITERAL, start, 0));
+    const NodeId condition = pairNode(&tree, NODE_BINARY, comparison, 0, leafNode(&tree, NODE_IDENTIFIER, "i", 1),
+                                      leafNode(&tree, NODE_INT_LITERAL, limit, literalOccurrence(limit, literals, 1)));
+    const NodeId increment = pairNode(&tree, NODE_ASSIGN, "+=", 0, leafNode(&tree, NODE_IDENTIFIER, "i", 2),
+                                      leafNode(&tree, NODE_INT_LITERAL, step, literalOccurrence(step, literals, 2)));
+    const NodeId loop = forNode(&tree, 0, init, condition, increment, listNode(&tree, NODE_BLOCK, "{", 0, NULL, 0));
+    programNode(&tree, &loop, 1);
+
+    Resolution resolution;
+    CHECK(resolveAst(&tree.ast, &resolution));
+    const bool matched = matchCountedLoop(&tree.ast, resolution.declarations, loop, counted);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+    return matched;
+}
+
+//Function to check that '<=' only matches while the last step cannot overflow the type
+static void testInclusiveLimit(void)
+{
+    CountedLoop counted;
+    //i8 stops at 127, so with a step of 3 the largest limit is 124
+    CHECK(matchSimpleLoop("i8", "0", "<=", "124", "3", &counted));
+    CHECK(counted.inclusive);
+    CHECK_INT(counted.type, TYPE_I8);
+    CHECK_INT(counted.step, 3);
+    CHECK_INT(counted.tripCount, 42);
+    CHECK(!matchSimpleLoop("i8", "0", "<=", "125", "3", &counted));
+    CHECK(matchSimpleLoop("u8", "0", "<=", "254", "1", &counted));
+    CHECK_INT(counted.tripCount, 255);
+    CHECK(!matchSimpleLoop("u8", "0", "<=", "255", "1", &counted));
+    //u64 does not compare correctly as a signed register
+    CHECK(!matchSimpleLoop("u64", "0", "<", "10", "1", &counted));
+}
+
+//Function to check that '<' with a step above 1 needs a limit the last step cannot pass the maximum from
+static void testExclusiveStep(void)
+{
+    CountedLoop counted;
+    CHECK(matchSimpleLoop("i32", "0", "<", "10", "3", &counted));
+    CHECK(!counted.inclusive);
+    CHECK_INT(counted.tripCount, 4);
+    CHECK(matchSimpleLoop("i32", "1", "<", "10", "3", &counted));
+    CHECK_INT(counted.tripCount, 3);
+    CHECK(matchSimpleLoop("i8", "0", "<", "125", "3", &counted));
+    CHECK_INT(counted.tripCount, 42);
+    CHECK(!matchSimpleLoop("i8", "0", "<", "126", "3", &counted));
+    CHECK(matchSimpleLoop("i8", "0", "<", "127", "1", &counted));
+    CHECK_INT(counted.tripCount, 127);
+    //A step larger than the type is never a counted loop
+    CHECK(!matchSimpleLoop("i8", "0", "<", "10", "128", &counted));
+    //Loops that never run still match, with no trips
+    CHECK(matchSimpleLoop("i32", "5", "<", "5", "1", &counted));
+    CHECK_INT(counted.tripCount, 0);
+    CHECK(matchSimpleLoop("i32", "9", "<=", "3", "2", &counted));
+    CHECK_INT(counted.tripCount, 0);
+}
+
+//Function to build 'for (mut i32 i = 0; i < n; i += 1) { body }' over 'n' and match it
+static bool matchLimitLoop(const uint8_t flags, const bool callInBody, const bool writeInBody, CountedLoop* counted)
+{
+    TestTree tree;
+    initTestTree(&tree, "i32 n = 10;\n"
+                        "fn g() {}\n"
+                        "for (mut i32 i = 0; i < n; i += 1) { g(); n = 3; }\n");
+    const NodeId limit = declarationNode(&tree, "n", 0, flags, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "10", 0));
+    const NodeId function = functionNode(&tree, "g", 0, NULL, 0, listNode(&tree, NODE_BLOCK, "{", 0, NULL, 0));
+    const NodeId init = declarationNode(&tree, "i", 0, NODE_FLAG_MUT, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "0", 0));
+    const NodeId condition = pairNode(&tree, NODE_BINARY, "<", 0, leafNode(&tree, NODE_IDENTIFIER, "i", 1),
+                                      leafNode(&tree, NODE_IDENTIFIER, "n", 1));
+    const NodeId increment = pairNode(&tree, NODE_ASSIGN, "+=", 0, leafNode(&tree, NODE_IDENTIFIER, "i", 2),
+                                      leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    NodeId body[2];
+    int statements = 0;
+    if (callInBody)
+    {
+        const NodeId call = callNode(&tree, 2, leafNode(&tree, NODE_IDENTIFIER, "g", 1), NULL, 0);
+        body[statements++] = pairNode(&tree, NODE_EXPR_STMT, "g", 1, call, NODE_NONE);
+    }
+    if (writeInBody)
+    {
+        const NodeId assign = pairNode(&tree, NODE_ASSIGN, "=", 2, leafNode(&tree, NODE_IDENTIFIER, "n", 2),
+                                       leafNode(&tree, NODE_INT_LITERAL, "3", 0));
+        body[statements++] = pairNode(&tree, NODE_EXPR_STMT, "n", 2, assign, NODE_NONE);
+    }
+    const NodeId loop = forNode(&tree, 0, init, condition, increment,
+                                listNode(&tree, NODE_BLOCK, "{", 1, body, statements));
+    const NodeId program[] = {limit, function, loop};
+    programNode(&tree, program, 3);
+
+    Resolution resolution;
+    CHECK(resolveAst(&tree.ast, &resolution));
+    const bool matched = matchCountedLoop(&tree.ast, resolution.declarations, loop, counted);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+    return matched;
+}
+
+//Function to check that a limit read from a binding only matches while nothing in the loop can change it
+static void testLimitBinding(void)
+{
+    CountedLoop counted;
+    CHECK(matchLimitLoop(0, true, false, &counted));
+    CHECK_INT(counted.tripCount, -1);
+    CHECK(matchLimitLoop(NODE_FLAG_MUT, false, false, &counted));
+    CHECK_INT(counted.tripCount, -1);
+    //g() may assign the global 'n', and so may the body itself
+    CHECK(!matchLimitLoop(NODE_FLAG_MUT, true, false, &counted));
+    CHECK(!matchLimitLoop(NODE_FLAG_MUT, false, true, &counted));
+}
+
+//Function to check which 'for-in' loops may drop their bounds checks, and the extent they find
+static void testArrayLoops(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "i32 fixed[4];\n"
+                        "i32 listed[] = {1, 2, 3};\n"
+                        "mut i32 other[2];\n"
+                        "for (i32 x in fixed) { print(x); }\n"
+                        "for (i32 y in listed) {}\n"
+                        "for (i32 z in other) { other = listed; }\n"
+                        "for (i32 w in other) { print(w); }\n");
+    const NodeId fixed = declarationNode(&tree, "fixed", 0, NODE_FLAG_ARRAY, leafNode(&tree, NODE_INT_LITERAL, "4", 0),
+                                         NODE_NONE);
+    const NodeId elements[] = {leafNode(&tree, NODE_INT_LITERAL, "1", 0), leafNode(&tree, NODE_INT_LITERAL, "2", 0),
+                               leafNode(&tree, NODE_INT_LITERAL, "3", 0)};
+    const NodeId listed = declarationNode(&tree, "listed", 0, NODE_FLAG_UNSIZED_ARRAY, NODE_NONE,
+                                          listNode(&tree, NODE_ARRAY_LITERAL, "{", 0, elements, 3));
+    const NodeId other = declarationNode(&tree, "other", 0, NODE_FLAG_MUT | NODE_FLAG_ARRAY,
+                                         leafNode(&tree, NODE_INT_LITERAL, "2", 1), NODE_NONE);
+
+    const NodeId printX = callNode(&tree, 1, leafNode(&tree, NODE_IDENTIFIER, "print", 0),
+                                   (const NodeId[]){leafNode(&tree, NODE_IDENTIFIER, "x", 1)}, 1);
+    const NodeId overFixed = pairNode(&tree, NODE_FOR_IN, "x", 0, leafNode(&tree, NODE_IDENTIFIER, "fixed", 1),
+                                      listNode(&tree, NODE_BLOCK, "{", 1, (const NodeId[]){printX}, 1));
+    const NodeId overListed = pairNode(&tree, NODE_FOR_IN, "y", 0, leafNode(&tree, NODE_IDENTIFIER, "listed", 1),
+                                       listNode(&tree, NODE_BLOCK, "{", 2, NULL, 0));
+    const NodeId rebind = pairNode(&tree, NODE_ASSIGN, "=", 1, leafNode(&tree, NODE_IDENTIFIER, "other", 2),
+                                   leafNode(&tree, NODE_IDENTIFIER, "listed", 2));
+    const NodeId overRebound = pairNode(&tree, NODE_FOR_IN, "z", 0, leafNode(&tree, NODE_IDENTIFIER, "other", 1),
+                                        listNode(&tree, NODE_BLOCK, "{", 3, (const NodeId[]){rebind}, 1));
+    const NodeId printW = callNode(&tree, 5, leafNode(&tree, NODE_IDENTIFIER, "print", 1),
+                                   (const NodeId[]){leafNode(&tree, NODE_IDENTIFIER, "w", 1)}, 1);
+    const NodeId overCalled = pairNode(&tree, NODE_FOR_IN, "w", 0, leafNode(&tree, NODE_IDENTIFIER, "other", 3),
+                                       listNode(&tree, NODE_BLOCK, "{", 4, (const NodeId[]){printW}, 1));
+    const NodeId program[] = {fixed, listed, other, overFixed, overListed, overRebound, overCalled};
+    programNode(&tree, program, 7);
+
+    Resolution resolution;
+    CHECK(resolveAst(&tree.ast, &resolution));
+    ArrayLoop array;
+    CHECK(matchArrayLoop(&tree.ast, resolution.declarations, overFixed, &array));
+    CHECK_INT(array.array, fixed);
+    CHECK_INT(array.elementType, TYPE_I32);
+    CHECK_INT(array.length, 4);
+    CHECK(matchArrayLoop(&tree.ast, resolution.declarations, overListed, &array));
+    CHECK_INT(array.array, listed);
+    CHECK_INT(array.length, 3);
+    //Binding another array to the name, or calling anything that might, keeps the checks
+    CHECK(!matchArrayLoop(&tree.ast, resolution.declarations, overRebound, &array));
+    CHECK(!matchArrayLoop(&tree.ast, resolution.declarations, overCalled, &array));
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+int main(void)
+{
+    testInclusiveLimit();
+    testExclusiveStep();
+    testLimitBinding();
+    testArrayLoops();
+    return testResult("loops_test");
+}
@@ -0,0 +1,135 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bytecode.h"
+#include "profile.h"
+#include "test.h"
+#include "vm.h"
+
+//Instructions of the test chunk, each on a line of its own (line = index + 1)
+#define LOOP_INSTRUCTIONS 13
+
+//Times every instruction of one run of the test chunk runs
+static const unsigned long long expectedCounts[LOOP_INSTRUCTIONS] = {1, 1, 1, 1, 1, 1, 10, 10, 5, 5, 5, 10, 1};
+
+//Function to build 'for (i = 0; i < 10; i++) match (i & 1) { (0) sum += 1 (1) sum += 2 }'
+static void buildSwitchLoop(Chunk* chunk)
+{
+    initChunk(chunk);
+    const int64_t keys[] = {0, 1};
+    const int targets[] = {8, 10};
+    const int table = addSwitchTable(chunk, keys, targets, 2, 11);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 0, 0), 1);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 1, 0), 2);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 2, 10), 3);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 3, 1), 4);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 5, 1), 5);
+    const int prep = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_PREP, 1, 0), 6);
+    const int body = writeInstruction(chunk, ENCODE_ABC(OP_BIT_AND, 4, 1, 5), 7);
+    writeInstruction(chunk, ENCODE_ABX(OP_SWITCH, 4, table), 8);
+    //Even arm, then a jump over the odd arm, which is only reached through the switch
+    writeInstruction(chunk, ENCODE_ABC(OP_ADDI_INT, 0, 0, 1), 9);
+    const int skip = writeInstruction(chunk, ENCODE_ASBX(OP_JUMP, 0, 0), 10);
+    writeInstruction(chunk, ENCODE_ABC(OP_ADDI_INT, 0, 0, 2), 11);
+    const int loop = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_LOOP, 1, 0), 12);
+    const int exit = writeInstruction(chunk, ENCODE_ABC(OP_RETURN, 0, 0, 0), 13);
+    CHECK(patchJump(chunk, prep, exit));
+    CHECK(patchJump(chunk, skip, loop));
+    CHECK(patchJump(chunk, loop, body));
+    chunk->registerCount = 6;
+}
+
+//Helper to run the test chunk once and check its result
+static void runSwitchLoop(Chunk* chunk)
+{
+    Slot registers[6];
+    memset(registers, 0, sizeof(registers));
+    Slot result;
+    result.i = 0;
+    CHECK_INT(runChunk(chunk, registers, &result), INTERPRET_OK);
+    CHECK_INT(result.i, 15);
+}
+
+//Helper to open a temporary file for a report
+static FILE* openReport(void)
+{
+    FILE* file = tmpfile();
+    if (file == NULL)
+    {
+        fprintf(stderr, "Could not create a temporary file\n");
+        exit(74);
+    }
+    return file;
+}
+
+//Function to check the instruction counts rebuilt from taken branches and switch arrivals
+static void testRebuiltCounts(void)
+{
+    Chunk chunk;
+    buildSwitchLoop(&chunk);
+    startProfile();
+    runSwitchLoop(&chunk);
+    runSwitchLoop(&chunk);
+
+    FILE* folded = openReport();
+    writeFoldedStacks(folded);
+    rewind(folded);
+    unsigned long long counts[LOOP_INSTRUCTIONS + 1] = {0};
+    int lines = 0;
+    int line;
+    unsigned long long instructions;
+    while (fscanf(folded, "%*[^:]:%d %llu\n", &line, &instructions) == 2)
+    {
+        CHECK(line >= 1 && line <= LOOP_INSTRUCTIONS);
+        if (line >= 1 && line <= LOOP_INSTRUCTIONS) counts[line] = instructions;
+        lines++;
+    }
+    fclose(folded);
+    CHECK_INT(lines, LOOP_INSTRUCTIONS);
+    unsigned long long total = 0;
+    for (int i = 0; i < LOOP_INSTRUCTIONS; i++)
+    {
+        CHECK_INT(counts[i + 1], 2 * expectedCounts[i]);
+        total += counts[i + 1];
+    }
+    CHECK_INT(total, 2 * 52);
+
+    char text[2048];
+    FILE* report = openReport();
+    printProfile(report);
+    rewind(report);
+    text[fread(text, 1, sizeof(text) - 1, report)] = '\0';
+    fclose(report);
+    CHECK_CONTAINS(text, "<script>");
+    CHECK_CONTAINS(text, " 2            104\n");
+    stopProfile();
+    CHECK(!profileEnabled);
+    freeChunk(&chunk);
+}
+
+//Function to check that a profile of a run that executed no bytecode says so
+static void testEmptyProfile(void)
+{
+    startProfile();
+    char text[512];
+    FILE* report = openReport();
+    printProfile(report);
+    writeFoldedStacks(report);
+    rewind(report);
+    text[fread(text, 1, sizeof(text) - 1, report)] = '\0';
+    fclose(report);
+    CHECK_CONTAINS(text, "No bytecode ran");
+    CHECK(strstr(text, "hot line") == NULL);
+    stopProfile();
+}
+
+int main(void)
+{
+    testRebuiltCounts();
+    testEmptyProfile();
+    return testResult("profile_test");
+}
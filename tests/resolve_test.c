@@ -0,0 +1,136 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "environment.h"
+#include "test.h"
+#include "tree.h"
+
+//Helper to check the (depth, slot) a node resolved to
+#define CHECK_LOCATION(resolution, node, expectedDepth, expectedSlot) \
+    do \
+    { \
+        CHECK_INT((resolution).locations[node].depth, expectedDepth); \
+        CHECK_INT((resolution).locations[node].slot, expectedSlot); \
+    } while (0)
+
+//Function to check that a function reads a global one frame up, even one declared after it
+static void testGlobalsInFunctions(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "fn f(i32 p) -> i32 { return g + p; }\n"
+                        "i32 g = 1;\n");
+    const NodeId parameter = leafNode(&tree, NODE_PARAM, "p", 0);
+    const NodeId readGlobal = leafNode(&tree, NODE_IDENTIFIER, "g", 0);
+    const NodeId readParameter = leafNode(&tree, NODE_IDENTIFIER, "p", 1);
+    const NodeId sum = pairNode(&tree, NODE_BINARY, "+", 0, readGlobal, readParameter);
+    const NodeId body[] = {pairNode(&tree, NODE_RETURN, "return", 0, sum, NODE_NONE)};
+    const NodeId function = functionNode(&tree, "f", 0, &parameter, 1, listNode(&tree, NODE_BLOCK, "{", 0, body, 1));
+    const NodeId global = declarationNode(&tree, "g", 1, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    const NodeId program[] = {function, global};
+    const NodeId root = programNode(&tree, program, 2);
+
+    Resolution resolution;
+    CHECK(resolveAst(&tree.ast, &resolution));
+    CHECK_INT(resolution.errorCount, 0);
+    //Top-level functions are declared before anything else, so 'f' has slot 0 and 'g' slot 1
+    CHECK_LOCATION(resolution, function, 0, 0);
+    CHECK_LOCATION(resolution, global, 0, 1);
+    CHECK_LOCATION(resolution, readGlobal, 1, 1);
+    CHECK_INT(resolution.declarations[readGlobal], global);
+    CHECK_LOCATION(resolution, parameter, 0, 0);
+    CHECK_LOCATION(resolution, readParameter, 0, 0);
+    CHECK_INT(resolution.declarations[readParameter], parameter);
+    CHECK_INT(resolution.frameSizes[function], 1);
+    CHECK_INT(resolution.frameSizes[root], 2);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check that sibling blocks share slots and frames are sized by their deepest point
+static void testSlotReuse(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "fn h() { { i32 a = 1; i32 b = a; } { i32 c = 3; } i32 d = 4; }\n"
+                        "h();\n");
+    const NodeId a = declarationNode(&tree, "a", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    const NodeId readA = leafNode(&tree, NODE_IDENTIFIER, "a", 1);
+    const NodeId b = declarationNode(&tree, "b", 0, 0, NODE_NONE, readA);
+    const NodeId first[] = {a, b};
+    const NodeId c = declarationNode(&tree, "c", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "3", 0));
+    const NodeId d = declarationNode(&tree, "d", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "4", 0));
+    const NodeId body[] = {listNode(&tree, NODE_BLOCK, "{", 1, first, 2), listNode(&tree, NODE_BLOCK, "{", 2, &c, 1), d};
+    const NodeId function = functionNode(&tree, "h", 0, NULL, 0, listNode(&tree, NODE_BLOCK, "{", 0, body, 3));
+    const NodeId callee = leafNode(&tree, NODE_IDENTIFIER, "h", 1);
+    const NodeId program[] = {function, pairNode(&tree, NODE_EXPR_STMT, "h", 1, callNode(&tree, 1, callee, NULL, 0), NODE_NONE)};
+    const NodeId root = programNode(&tree, program, 2);
+
+    Resolution resolution;
+    CHECK(resolveAst(&tree.ast, &resolution));
+    CHECK_LOCATION(resolution, a, 0, 0);
+    CHECK_LOCATION(resolution, b, 0, 1);
+    CHECK_LOCATION(resolution, readA, 0, 0);
+    CHECK_LOCATION(resolution, c, 0, 0);
+    CHECK_LOCATION(resolution, d, 0, 0);
+    CHECK_LOCATION(resolution, callee, 0, 0);
+    CHECK_INT(resolution.frameSizes[function], 2);
+    CHECK_INT(resolution.frameSizes[root], 1);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+//Function to check the three resolver errors, and that 'mut' bindings and print() resolve cleanly
+static void testErrors(void)
+{
+    TestTree tree;
+    initTestTree(&tree, "i32 x = 1;\n"
+                        "i32 x = 2;\n"
+                        "y;\n"
+                        "x = 3;\n"
+                        "mut i32 m = 1;\n"
+                        "m = 2;\n"
+                        "print;\n");
+    NodeId program[7];
+    program[0] = declarationNode(&tree, "x", 0, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "1", 0));
+    program[1] = declarationNode(&tree, "x", 1, 0, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "2", 0));
+    const NodeId undefined = leafNode(&tree, NODE_IDENTIFIER, "y", 0);
+    program[2] = pairNode(&tree, NODE_EXPR_STMT, "y", 0, undefined, NODE_NONE);
+    const NodeId immutable = pairNode(&tree, NODE_ASSIGN, "=", 2, leafNode(&tree, NODE_IDENTIFIER, "x", 2),
+                                      leafNode(&tree, NODE_INT_LITERAL, "3", 0));
+    program[3] = pairNode(&tree, NODE_EXPR_STMT, "x", 2, immutable, NODE_NONE);
+    program[4] = declarationNode(&tree, "m", 0, NODE_FLAG_MUT, NODE_NONE, leafNode(&tree, NODE_INT_LITERAL, "1", 1));
+    const NodeId mutable = pairNode(&tree, NODE_ASSIGN, "=", 4, leafNode(&tree, NODE_IDENTIFIER, "m", 1),
+                                    leafNode(&tree, NODE_INT_LITERAL, "2", 1));
+    program[5] = pairNode(&tree, NODE_EXPR_STMT, "m", 1, mutable, NODE_NONE);
+    const NodeId builtin = leafNode(&tree, NODE_IDENTIFIER, "print", 0);
+    program[6] = pairNode(&tree, NODE_EXPR_STMT, "print", 0, builtin, NODE_NONE);
+    programNode(&tree, program, 7);
+
+    Resolution resolution;
+    StderrCapture capture;
+    char output[1024];
+    beginCapture(&capture);
+    const bool resolved = resolveAst(&tree.ast, &resolution);
+    endCapture(&capture, output, sizeof(output));
+    CHECK(!resolved);
+    CHECK_INT(resolution.errorCount, 3);
+    CHECK_CONTAINS(output, "[line 2] Error at 'x': Already a variable with this name in this scope.");
+    CHECK_CONTAINS(output, "[line 3] Error at 'y': Undefined variable.");
+    CHECK_CONTAINS(output, "[line 4] Error at 'x': Cannot assign to an immutable variable.");
+    CHECK_INT(resolution.locations[undefined].depth, LOCATION_UNRESOLVED);
+    CHECK_INT(resolution.locations[builtin].depth, LOCATION_BUILTIN);
+    CHECK_INT(resolution.locations[builtin].slot, BUILTIN_PRINT);
+    freeResolution(&resolution);
+    freeTestTree(&tree);
+}
+
+int main(void)
+{
+    testGlobalsInFunctions();
+    testSlotReuse();
+    testErrors();
+    return testResult("resolve_test");
+}
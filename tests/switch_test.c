@@ -0,0 +1,180 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bytecode.h"
+#include "test.h"
+#include "vm.h"
+#include <stdint.h>
+
+//Target every test table falls back to
+#define DEFAULT_TARGET 99
+
+//Helper to build a table in a fresh chunk, the chunk owns it
+static const SwitchTable* buildTable(Chunk* chunk, const int64_t* keys, const int* targets, const int count)
+{
+    initChunk(chunk);
+    const int index = addSwitchTable(chunk, keys, targets, count, DEFAULT_TARGET);
+    return &chunk->switches[index];
+}
+
+//Function to check a small key set that is indexed directly
+static void testDenseTable(void)
+{
+    const int64_t keys[] = {3, 1, 2, 5};
+    const int targets[] = {30, 10, 20, 50};
+    Chunk chunk;
+    const SwitchTable* table = buildTable(&chunk, keys, targets, 4);
+    CHECK(table->dense);
+    CHECK_INT(table->low, 1);
+    CHECK_INT(table->count, 5);
+    CHECK_INT(switchTarget(table, 1), 10);
+    CHECK_INT(switchTarget(table, 2), 20);
+    CHECK_INT(switchTarget(table, 3), 30);
+    CHECK_INT(switchTarget(table, 5), 50);
+    //The gap and both sides of the range
+    CHECK_INT(switchTarget(table, 4), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, 0), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, 6), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, INT64_MIN), DEFAULT_TARGET);
+    freeChunk(&chunk);
+}
+
+//Function to check a spread out key set that is binary searched
+static void testSparseTable(void)
+{
+    const int64_t keys[] = {1000000, -7, 42, 65536};
+    const int targets[] = {1, 2, 3, 4};
+    Chunk chunk;
+    const SwitchTable* table = buildTable(&chunk, keys, targets, 4);
+    CHECK(!table->dense);
+    CHECK_INT(table->count, 4);
+    CHECK_INT(switchTarget(table, 1000000), 1);
+    CHECK_INT(switchTarget(table, -7), 2);
+    CHECK_INT(switchTarget(table, 42), 3);
+    CHECK_INT(switchTarget(table, 65536), 4);
+    CHECK_INT(switchTarget(table, -8), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, 43), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, 1000001), DEFAULT_TARGET);
+    freeChunk(&chunk);
+}
+
+//Function to check that a repeated key keeps the target of its first arm, in both table kinds
+static void testDuplicateKeys(void)
+{
+    const int64_t denseKeys[] = {2, 3, 2};
+    const int denseTargets[] = {1, 2, 3};
+    Chunk chunk;
+    const SwitchTable* table = buildTable(&chunk, denseKeys, denseTargets, 3);
+    CHECK(table->dense);
+    CHECK_INT(switchTarget(table, 2), 1);
+    CHECK_INT(switchTarget(table, 3), 2);
+    freeChunk(&chunk);
+
+    const int64_t sparseKeys[] = {100000, -100000, 100000, 100000};
+    const int sparseTargets[] = {1, 2, 3, 4};
+    table = buildTable(&chunk, sparseKeys, sparseTargets, 4);
+    CHECK(!table->dense);
+    CHECK_INT(table->count, 2);
+    CHECK_INT(switchTarget(table, 100000), 1);
+    CHECK_INT(switchTarget(table, -100000), 2);
+    freeChunk(&chunk);
+}
+
+//Function to check keys at the ends of int64, whose span does not fit in one
+static void testExtremeKeys(void)
+{
+    const int64_t ends[] = {INT64_MAX, INT64_MIN};
+    const int endTargets[] = {1, 2};
+    Chunk chunk;
+    const SwitchTable* table = buildTable(&chunk, ends, endTargets, 2);
+    CHECK(!table->dense);
+    CHECK_INT(switchTarget(table, INT64_MAX), 1);
+    CHECK_INT(switchTarget(table, INT64_MIN), 2);
+    CHECK_INT(switchTarget(table, INT64_MAX - 1), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, INT64_MIN + 1), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, 0), DEFAULT_TARGET);
+    freeChunk(&chunk);
+
+    //Dense tables next to either end, a key on the far side must not wrap into the range
+    const int64_t top[] = {INT64_MAX - 1, INT64_MAX};
+    const int topTargets[] = {1, 2};
+    table = buildTable(&chunk, top, topTargets, 2);
+    CHECK(table->dense);
+    CHECK_INT(table->count, 2);
+    CHECK_INT(switchTarget(table, INT64_MAX), 2);
+    CHECK_INT(switchTarget(table, INT64_MIN), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, INT64_MIN + 1), DEFAULT_TARGET);
+    freeChunk(&chunk);
+
+    const int64_t bottom[] = {INT64_MIN, INT64_MIN + 1};
+    const int bottomTargets[] = {1, 2};
+    table = buildTable(&chunk, bottom, bottomTargets, 2);
+    CHECK(table->dense);
+    CHECK_INT(switchTarget(table, INT64_MIN), 1);
+    CHECK_INT(switchTarget(table, INT64_MAX), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, -1), DEFAULT_TARGET);
+    freeChunk(&chunk);
+}
+
+//Function to check that a match without integer arms always takes its default
+static void testEmptyTable(void)
+{
+    Chunk chunk;
+    const SwitchTable* table = buildTable(&chunk, NULL, NULL, 0);
+    CHECK_INT(table->count, 0);
+    CHECK_INT(switchTarget(table, 0), DEFAULT_TARGET);
+    CHECK_INT(switchTarget(table, INT64_MIN), DEFAULT_TARGET);
+    freeChunk(&chunk);
+}
+
+//Function to run 'match (key) { (INT64_MIN) 1 (INT64_MAX) 2 (_) -1 }' through OP_SWITCH
+static int64_t runSwitch(const int64_t key)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    const int64_t keys[] = {INT64_MIN, INT64_MAX};
+    const int targets[] = {2, 4};
+    const int table = addSwitchTable(&chunk, keys, targets, 2, 6);
+    Slot constant;
+    constant.i = key;
+    writeInstruction(&chunk, ENCODE_ABX(OP_LOAD_CONST, 0, addConstant(&chunk, constant)), 1);
+    writeInstruction(&chunk, ENCODE_ABX(OP_SWITCH, 0, table), 1);
+    for (int value = 1; value <= 3; value++)
+    {
+        writeInstruction(&chunk, ENCODE_ASBX(OP_LOAD_INT, 1, value == 3 ? -1 : value), 2);
+        writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 1, 0, 0), 2);
+    }
+
+    Slot registers[2];
+    memset(registers, 0, sizeof(registers));
+    chunk.registerCount = 2;
+    Slot result;
+    result.i = 0;
+    CHECK_INT(runChunk(&chunk, registers, &result), INTERPRET_OK);
+    freeChunk(&chunk);
+    return result.i;
+}
+
+//Function to check OP_SWITCH jumps to the instruction its table picks
+static void testSwitchOpcode(void)
+{
+    CHECK_INT(runSwitch(INT64_MIN), 1);
+    CHECK_INT(runSwitch(INT64_MAX), 2);
+    CHECK_INT(runSwitch(0), -1);
+    CHECK_INT(runSwitch(INT64_MAX - 1), -1);
+}
+
+int main(void)
+{
+    testDenseTable();
+    testSparseTable();
+    testDuplicateKeys();
+    testExtremeKeys();
+    testEmptyTable();
+    testSwitchOpcode();
+    return testResult("switch_test");
+}
@@ -0,0 +1,103 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef TEST_H
+#define TEST_H
+
+//Tests define _POSIX_C_SOURCE before their first include, stderr capture needs fileno() and dup()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#define fileno _fileno
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+//Every test is a plain executable run by ctest. A failed check prints where
+//it is and what it saw, the test keeps going and exits 1 at the end.
+
+//Number of checks that failed so far
+static int testFailures = 0;
+
+//Macro to check a condition
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+//Macro to check that two integers are equal, both are printed when they are not
+#define CHECK_INT(actual, expected) \
+    do \
+    { \
+        const long long actualValue = (long long)(actual); \
+        const long long expectedValue = (long long)(expected); \
+        if (actualValue != expectedValue) \
+        { \
+            fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, \
+                    actualValue, expectedValue); \
+            testFailures++; \
+        } \
+    } while (0)
+
+//Macro to check that 'text' contains 'part'
+#define CHECK_CONTAINS(text, part) \
+    do \
+    { \
+        if (strstr((text), (part)) == NULL) \
+        { \
+            fprintf(stderr, "%s:%d: \"%s\" does not contain \"%s\"\n", __FILE__, __LINE__, (text), (part)); \
+            testFailures++; \
+        } \
+    } while (0)
+
+//Helper to end a test, returns the exit status of main
+static inline int testResult(const char* name)
+{
+    if (testFailures > 0) fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+    return testFailures > 0 ? 1 : 0;
+}
+
+//Struct to hold stderr while it is redirected into a temporary file
+typedef struct
+{
+    FILE* file;
+    int saved;
+} StderrCapture;
+
+//Helper to send everything written to stderr into a temporary file
+static inline void beginCapture(StderrCapture* capture)
+{
+    fflush(stderr);
+    capture->file = tmpfile();
+    if (capture->file == NULL)
+    {
+        fprintf(stderr, "Could not create a temporary file\n");
+        exit(74);
+    }
+    capture->saved = dup(fileno(stderr));
+    dup2(fileno(capture->file), fileno(stderr));
+}
+
+//Helper to restore stderr and copy what was written to it into 'text' ('\0' terminated)
+static inline void endCapture(StderrCapture* capture, char* text, const size_t size)
+{
+    fflush(stderr);
+    dup2(capture->saved, fileno(stderr));
+    close(capture->saved);
+    rewind(capture->file);
+    const size_t length = fread(text, 1, size - 1, capture->file);
+    text[length] = '\0';
+    fclose(capture->file);
+}
+
+#endif //TEST_H
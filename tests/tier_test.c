@@ -0,0 +1,135 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bytecode.h"
+#include "test.h"
+#include "tier.hpp"
+#include "vm.h"
+#include <math.h>
+#include <stdint.h>
+
+//Registers of every test chunk
+#define TEST_REGISTERS 8
+
+//Helper to load a 64-bit constant into a register
+static void loadSlot(Chunk* chunk, const int target, const Slot value)
+{
+    writeInstruction(chunk, ENCODE_ABX(OP_LOAD_CONST, target, addConstant(chunk, value)), 1);
+}
+
+//Helper to run a chunk on zeroed registers and get its result
+static int64_t run(Chunk* chunk)
+{
+    Slot registers[TEST_REGISTERS];
+    memset(registers, 0, sizeof(registers));
+    chunk->registerCount = TEST_REGISTERS;
+    Slot result;
+    result.i = 0;
+    CHECK_INT(runChunk(chunk, registers, &result), INTERPRET_OK);
+    return result.i;
+}
+
+//Function to build 'sum = 0; for (i = 0; i < limit; i++) sum += i * 3; return sum'
+static void buildLoop(Chunk* chunk, const int64_t limit)
+{
+    initChunk(chunk);
+    Slot value;
+    value.i = limit;
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 0, 0), 1);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 1, 0), 1);
+    loadSlot(chunk, 2, value);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 3, 1), 1);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 5, 3), 1);
+    const int prep = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_PREP, 1, 0), 1);
+    const int body = writeInstruction(chunk, ENCODE_ABC(OP_MUL_INT, 4, 1, 5), 2);
+    writeInstruction(chunk, ENCODE_ABC(OP_ADD_INT, 0, 0, 4), 2);
+    const int loop = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_LOOP, 1, 0), 1);
+    const int exit = writeInstruction(chunk, ENCODE_ABC(OP_RETURN, 0, 0, 0), 3);
+    CHECK(patchJump(chunk, prep, exit));
+    CHECK(patchJump(chunk, loop, body));
+}
+
+//Function to check that a loop taking TIER_UP_THRESHOLD backward jumps finishes natively with the same sum
+static void testBackEdgePromotion(void)
+{
+    const int64_t limit = 3 * TIER_UP_THRESHOLD + 7;
+    Chunk chunk;
+    setTierUpHook(NULL);
+    buildLoop(&chunk, limit);
+    const int64_t interpreted = run(&chunk);
+    CHECK_INT(interpreted, 3 * limit * (limit - 1) / 2);
+    CHECK(chunk.native == NULL);
+    freeChunk(&chunk);
+
+    setTierUpHook(compileChunkNative);
+    buildLoop(&chunk, limit);
+    //The switch happens at the FOR_LOOP's target in the middle of the run, with the registers as they are
+    CHECK_INT(run(&chunk), interpreted);
+    CHECK(chunk.tierAttempted);
+    CHECK(chunk.native != NULL);
+    CHECK_INT(chunk.hotness, 1);
+    //Later runs start native
+    CHECK_INT(run(&chunk), interpreted);
+    freeChunk(&chunk);
+    setTierUpHook(NULL);
+}
+
+//Function to check that a chunk entered TIER_UP_THRESHOLD times is promoted on that entry
+static void testEntryPromotion(void)
+{
+    Chunk chunk;
+    setTierUpHook(compileChunkNative);
+    buildLoop(&chunk, 4);
+    for (int i = 1; i < TIER_UP_THRESHOLD; i++) CHECK_INT(run(&chunk), 18);
+    CHECK(!chunk.tierAttempted);
+    CHECK(chunk.native == NULL);
+    CHECK_INT(run(&chunk), 18);
+    CHECK(chunk.native != NULL);
+    CHECK_INT(run(&chunk), 18);
+    freeChunk(&chunk);
+    setTierUpHook(NULL);
+}
+
+//Function to run OP_FLOAT_TO_INT on one value, interpreted or after the chunk was promoted
+static int64_t runFloatToInt(const double value, const bool native)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    Slot constant;
+    constant.f = value;
+    loadSlot(&chunk, 0, constant);
+    writeInstruction(&chunk, ENCODE_ABC(OP_FLOAT_TO_INT, 1, 0, 0), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 1, 0, 0), 1);
+    setTierUpHook(native ? compileChunkNative : NULL);
+    if (native)
+    {
+        for (int i = 1; i < TIER_UP_THRESHOLD; i++) run(&chunk);
+    }
+    const int64_t converted = run(&chunk);
+    CHECK(native == (chunk.native != NULL));
+    freeChunk(&chunk);
+    setTierUpHook(NULL);
+    return converted;
+}
+
+//Function to check that both tiers convert out of range and NaN floats to the same integers
+static void testFloatToIntAgreement(void)
+{
+    const double values[] = {NAN, 1e30, -1e30, INFINITY, -INFINITY, 9223372036854775808.0, -2.9, 2.9};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        CHECK_INT(runFloatToInt(values[i], true), runFloatToInt(values[i], false));
+    }
+}
+
+int main(void)
+{
+    testBackEdgePromotion();
+    testEntryPromotion();
+    testFloatToIntAgreement();
+    return testResult("tier_test");
+}
@@ -0,0 +1,135 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef TREE_H
+#define TREE_H
+
+#include "ast.h"
+#include "lexer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//There is no parser yet, so the tests of the tree passes lex a snippet and
+//build its nodes by hand with addNode. A node names its main token by its
+//text and which occurrence of that text it is ("x", 1 is the second 'x'), so
+//declarations find their type keyword in front of their name as usual.
+
+//Struct to hold a snippet and the tree built over its tokens
+typedef struct
+{
+    TokenBuffer tokens;
+    Ast ast;
+} TestTree;
+
+//Function to lex a snippet and start an empty tree over it
+static inline void initTestTree(TestTree* tree, const char* source)
+{
+    initTokenBuffer(&tree->tokens);
+    tokenizeAll(&tree->tokens, source, 0);
+    if (tree->tokens.errorCount > 0)
+    {
+        fprintf(stderr, "Test snippet does not lex: %s\n", source);
+        exit(70);
+    }
+    initAst(&tree->ast, &tree->tokens);
+}
+
+//Function to release a snippet and its tree
+static inline void freeTestTree(TestTree* tree)
+{
+    freeAst(&tree->ast);
+    freeTokenBuffer(&tree->tokens);
+}
+
+//Helper to find the token of the given text and occurrence
+static inline uint32_t findToken(const TestTree* tree, const char* text, const int occurrence)
+{
+    const size_t length = strlen(text);
+    int seen = 0;
+    for (int i = 0; i < tree->tokens.count; i++)
+    {
+        if (tree->tokens.lengths[i] != length) continue;
+        if (memcmp(tree->tokens.source + tree->tokens.offsets[i], text, length) != 0) continue;
+        if (seen++ == occurrence) return (uint32_t)i;
+    }
+    fprintf(stderr, "Test snippet has no token '%s' #%d\n", text, occurrence);
+    exit(70);
+}
+
+//Helper to add a node without children (literals, identifiers, parameters)
+static inline NodeId leafNode(TestTree* tree, const NodeKind kind, const char* text, const int occurrence)
+{
+    return addNode(&tree->ast, kind, findToken(tree, text, occurrence), 0, 0);
+}
+
+//Helper to add a node whose lhs and rhs are plain words (children, or NODE_NONE)
+static inline NodeId pairNode(TestTree* tree, const NodeKind kind, const char* text, const int occurrence,
+                              const uint32_t lhs, const uint32_t rhs)
+{
+    return addNode(&tree->ast, kind, findToken(tree, text, occurrence), lhs, rhs);
+}
+
+//Helper to add a declaration with its flags ('mut', arrays)
+static inline NodeId declarationNode(TestTree* tree, const char* name, const int occurrence, const uint8_t flags,
+                                     const NodeId length, const NodeId initializer)
+{
+    const NodeId node = pairNode(tree, NODE_VAR_DECL, name, occurrence, length, initializer);
+    setNodeFlags(&tree->ast, node, flags);
+    return node;
+}
+
+//Helper to add a node whose lhs..rhs is a list of nodes in extra (blocks, array literals)
+static inline NodeId listNode(TestTree* tree, const NodeKind kind, const char* text, const int occurrence,
+                              const NodeId* nodes, const int count)
+{
+    uint32_t start, end;
+    addNodeList(&tree->ast, nodes, count, &start, &end);
+    return pairNode(tree, kind, text, occurrence, start, end);
+}
+
+//Helper to add a node whose rhs is extra[first, second] (if, ternary)
+static inline NodeId branchNode(TestTree* tree, const NodeKind kind, const char* text, const int occurrence,
+                                const NodeId condition, const NodeId first, const NodeId second)
+{
+    const uint32_t arms[2] = {first, second};
+    return pairNode(tree, kind, text, occurrence, condition, addExtra(&tree->ast, arms, 2));
+}
+
+//Helper to add a 'for', its lhs is extra[init, condition, step]
+static inline NodeId forNode(TestTree* tree, const int occurrence, const NodeId init, const NodeId condition,
+                             const NodeId step, const NodeId body)
+{
+    const uint32_t clauses[3] = {init, condition, step};
+    return pairNode(tree, NODE_FOR, "for", occurrence, addExtra(&tree->ast, clauses, 3), body);
+}
+
+//Helper to add a node whose rhs is extra[listStart, listEnd] (calls and their arguments)
+static inline NodeId callNode(TestTree* tree, const int occurrence, const NodeId callee, const NodeId* arguments,
+                              const int count)
+{
+    uint32_t range[2];
+    addNodeList(&tree->ast, arguments, count, &range[0], &range[1]);
+    return pairNode(tree, NODE_CALL, "(", occurrence, callee, addExtra(&tree->ast, range, 2));
+}
+
+//Helper to add a function, its lhs is extra[paramsStart, paramsEnd, returnTypeToken]
+static inline NodeId functionNode(TestTree* tree, const char* name, const int occurrence, const NodeId* parameters,
+                                  const int count, const NodeId body)
+{
+    uint32_t header[3];
+    addNodeList(&tree->ast, parameters, count, &header[0], &header[1]);
+    header[2] = 0; //No pass under test reads the return type
+    return pairNode(tree, NODE_FN_DECL, name, occurrence, addExtra(&tree->ast, header, 3), body);
+}
+
+//Helper to finish the tree with its program node
+static inline NodeId programNode(TestTree* tree, const NodeId* declarations, const int count)
+{
+    uint32_t start, end;
+    addNodeList(&tree->ast, declarations, count, &start, &end);
+    tree->ast.root = addNode(&tree->ast, NODE_PROGRAM, 0, start, end);
+    return tree->ast.root;
+}
+
+#endif //TREE_H
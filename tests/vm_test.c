@@ -0,0 +1,205 @@
+//
+//Copyright (c) 2026 Rajdeep Nemo and Sujay Paul
+//
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bytecode.h"
+#include "test.h"
+#include "vm.h"
+#include <math.h>
+#include <stdint.h>
+
+//Registers of every test chunk
+#define TEST_REGISTERS 16
+
+//Helper to load a 64-bit integer into a register through the constant table
+static void loadInt(Chunk* chunk, const int target, const int64_t value, const int line)
+{
+    Slot constant;
+    constant.i = value;
+    writeInstruction(chunk, ENCODE_ABX(OP_LOAD_CONST, target, addConstant(chunk, constant)), line);
+}
+
+//Helper to load a double into a register through the constant table
+static void loadFloat(Chunk* chunk, const int target, const double value, const int line)
+{
+    Slot constant;
+    constant.f = value;
+    writeInstruction(chunk, ENCODE_ABX(OP_LOAD_CONST, target, addConstant(chunk, constant)), line);
+}
+
+//Helper to run a chunk on zeroed registers
+static InterpretResult run(Chunk* chunk, Slot* result)
+{
+    Slot registers[TEST_REGISTERS];
+    memset(registers, 0, sizeof(registers));
+    chunk->registerCount = TEST_REGISTERS;
+    return runChunk(chunk, registers, result);
+}
+
+//Function to build 'sum = 0; for (i = 0; i < limit; i++) sum += i; return sum'
+static void buildCountedLoop(Chunk* chunk, const int64_t limit)
+{
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 0, 0), 1);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 1, 0), 1);
+    loadInt(chunk, 2, limit, 1);
+    writeInstruction(chunk, ENCODE_ASBX(OP_LOAD_INT, 3, 1), 1);
+    const int prep = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_PREP, 1, 0), 1);
+    const int body = writeInstruction(chunk, ENCODE_ABC(OP_ADD_INT, 0, 0, 1), 2);
+    const int loop = writeInstruction(chunk, ENCODE_ASBX(OP_FOR_LOOP, 1, 0), 1);
+    const int exit = writeInstruction(chunk, ENCODE_ABC(OP_RETURN, 0, 0, 0), 3);
+    CHECK(patchJump(chunk, prep, exit));
+    CHECK(patchJump(chunk, loop, body));
+}
+
+//Function to check a hand-assembled counted loop, including one that runs zero times
+static void testCountedLoop(void)
+{
+    const int64_t limits[] = {100000, 1, 0, -5};
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++)
+    {
+        const int64_t limit = limits[i];
+        Chunk chunk;
+        initChunk(&chunk);
+        buildCountedLoop(&chunk, limit);
+        Slot result;
+        CHECK_INT(run(&chunk, &result), INTERPRET_OK);
+        CHECK_INT(result.i, limit > 0 ? limit * (limit - 1) / 2 : 0);
+        freeChunk(&chunk);
+    }
+}
+
+//Function to check that division by zero is reported at the line of the dividing instruction
+static void testDivisionByZero(void)
+{
+    const OpCode ops[] = {OP_DIV_INT, OP_MOD_INT, OP_DIV_UINT, OP_MOD_UINT};
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++)
+    {
+        Chunk chunk;
+        initChunk(&chunk);
+        writeInstruction(&chunk, ENCODE_ASBX(OP_LOAD_INT, 0, 7), 1);
+        writeInstruction(&chunk, ENCODE_ASBX(OP_LOAD_INT, 1, 0), 2);
+        writeInstruction(&chunk, ENCODE_ABC(ops[i], 2, 0, 1), 7);
+        writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 2, 0, 0), 8);
+
+        StderrCapture capture;
+        char output[256];
+        beginCapture(&capture);
+        const InterpretResult result = run(&chunk, NULL);
+        endCapture(&capture, output, sizeof(output));
+        CHECK_INT(result, INTERPRET_RUNTIME_ERROR);
+        CHECK_CONTAINS(output, "Division by zero.");
+        CHECK_CONTAINS(output, "[line 7]");
+        freeChunk(&chunk);
+    }
+}
+
+//Function to check that INT64_MIN / -1 wraps and INT64_MIN % -1 is 0 instead of trapping
+static void testMinimumOverMinusOne(void)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    loadInt(&chunk, 0, INT64_MIN, 1);
+    writeInstruction(&chunk, ENCODE_ASBX(OP_LOAD_INT, 1, -1), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_DIV_INT, 2, 0, 1), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_MOD_INT, 3, 0, 1), 1);
+    //Return quotient + remainder, the remainder must not disturb the quotient
+    writeInstruction(&chunk, ENCODE_ABC(OP_ADD_INT, 4, 2, 3), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 4, 0, 0), 1);
+    Slot result;
+    CHECK_INT(run(&chunk, &result), INTERPRET_OK);
+    CHECK(result.i == INT64_MIN);
+    freeChunk(&chunk);
+}
+
+//Function to run 'R[0] op R[1]' once and get the result
+static int64_t runShift(const OpCode op, const int64_t value, const int64_t count)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    loadInt(&chunk, 0, value, 1);
+    loadInt(&chunk, 1, count, 1);
+    writeInstruction(&chunk, ENCODE_ABC(op, 2, 0, 1), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 2, 0, 0), 1);
+    Slot result;
+    result.i = 0;
+    CHECK_INT(run(&chunk, &result), INTERPRET_OK);
+    freeChunk(&chunk);
+    return result.i;
+}
+
+//Function to check that OP_SHR copies the sign bit and OP_SHR_UINT shifts in zeros
+static void testShifts(void)
+{
+    CHECK_INT(runShift(OP_SHR, -8, 1), -4);
+    CHECK_INT(runShift(OP_SHR_UINT, -8, 1), (int64_t)(UINT64_MAX >> 1) - 3);
+    CHECK_INT(runShift(OP_SHR, INT64_MIN, 63), -1);
+    CHECK_INT(runShift(OP_SHR_UINT, INT64_MIN, 63), 1);
+    CHECK_INT(runShift(OP_SHR, 64, 3), 8);
+    CHECK_INT(runShift(OP_SHR_UINT, 64, 3), 8);
+    //Counts are taken modulo 64 like the hardware does
+    CHECK_INT(runShift(OP_SHR_UINT, 64, 67), 8);
+    CHECK_INT(runShift(OP_SHL, 1, 65), 2);
+}
+
+//Function to run OP_FLOAT_TO_INT on one value
+static int64_t runFloatToInt(const double value)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    loadFloat(&chunk, 0, value, 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_FLOAT_TO_INT, 1, 0, 0), 1);
+    writeInstruction(&chunk, ENCODE_ABC(OP_RETURN, 1, 0, 0), 1);
+    Slot result;
+    result.i = 12345;
+    CHECK_INT(run(&chunk, &result), INTERPRET_OK);
+    freeChunk(&chunk);
+    return result.i;
+}
+
+//Function to check that float to integer conversion truncates and saturates like the JIT tier
+static void testFloatToInt(void)
+{
+    CHECK_INT(runFloatToInt(-2.9), -2);
+    CHECK_INT(runFloatToInt(2.9), 2);
+    CHECK_INT(runFloatToInt(NAN), 0);
+    CHECK(runFloatToInt(1e30) == INT64_MAX);
+    CHECK(runFloatToInt(-1e30) == INT64_MIN);
+    CHECK(runFloatToInt(INFINITY) == INT64_MAX);
+    CHECK(runFloatToInt(-INFINITY) == INT64_MIN);
+    CHECK(runFloatToInt(9223372036854775808.0) == INT64_MAX);
+    CHECK(runFloatToInt(-9223372036854775808.0) == INT64_MIN);
+}
+
+//Function to check that patchJump refuses distances that do not fit in sBx
+static void testPatchJumpRange(void)
+{
+    Chunk chunk;
+    initChunk(&chunk);
+    for (int i = 0; i < SBX_MAX + 8; i++) writeInstruction(&chunk, ENCODE_ABC(OP_HALT, 0, 0, 0), 1);
+    const int forward = writeInstruction(&chunk, ENCODE_ASBX(OP_JUMP, 0, 0), 1);
+    CHECK(patchJump(&chunk, forward, forward + 1 + SBX_MAX));
+    CHECK_INT(INSTR_SBX(chunk.code[forward]), SBX_MAX);
+    CHECK(!patchJump(&chunk, forward, forward + 2 + SBX_MAX));
+    //A refused jump is left as it was
+    CHECK_INT(INSTR_SBX(chunk.code[forward]), SBX_MAX);
+    CHECK_INT(INSTR_OP(chunk.code[forward]), OP_JUMP);
+
+    CHECK(patchJump(&chunk, forward, forward + 1 + SBX_MIN));
+    CHECK_INT(INSTR_SBX(chunk.code[forward]), SBX_MIN);
+    CHECK(!patchJump(&chunk, forward, forward + SBX_MIN));
+    freeChunk(&chunk);
+}
+
+int main(void)
+{
+    testCountedLoop();
+    testDivisionByZero();
+    testMinimumOverMinusOne();
+    testShifts();
+    testFloatToInt();
+    testPatchJumpRange();
+    return testResult("vm_test");
+}